@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+#include <hal/par.hpp>
+#include "bench_data.hpp"
+
+namespace {
+
+struct Tick {
+    double bid;
+    double ask;
+    float bid_size;
+    float ask_size;
+    long volume;
+};
+
+auto ticks() -> std::vector<Tick> const&
+{
+    static auto const result = [] {
+        auto price  = std::uniform_real_distribution<double>{99., 101.};
+        auto size   = std::uniform_real_distribution<float>{0.f, 1000.f};
+        auto volume = std::uniform_int_distribution<long>{0, 10'000};
+        auto ticks  = std::vector<Tick>(1'000'000);
+        for (auto& t : ticks) {
+            t = Tick{price(bench::rng()), price(bench::rng()),
+                     size(bench::rng()), size(bench::rng()),
+                     volume(bench::rng())};
+        }
+        return ticks;
+    }();
+    return result;
+}
+
+constexpr auto sum     = [](auto x, auto y) { return x + y; };
+constexpr auto maximum = [](auto x, auto y) { return std::max(x, y); };
+
+}  // namespace
+
+// "par" is hal::par::memberwise::batch, on the default thread pool.
+
+TEST_CASE("batch: sum 1M ticks", "[bench]")
+{
+    auto const& records = ticks();
+
+    BENCHMARK("hal")
+    {
+        return hal::memberwise::batch::reduce(Tick{}, sum, records);
+    };
+    BENCHMARK("handwritten")
+    {
+        auto total = Tick{};
+        for (auto const& t : records) {
+            total.bid += t.bid;
+            total.ask += t.ask;
+            total.bid_size += t.bid_size;
+            total.ask_size += t.ask_size;
+            total.volume += t.volume;
+        }
+        return total;
+    };
+    BENCHMARK("par")
+    {
+        return hal::par::memberwise::batch::reduce(Tick{}, sum, records);
+    };
+}
+
+TEST_CASE("batch: max 1M ticks", "[bench]")
+{
+    auto const& records = ticks();
+
+    BENCHMARK("hal")
+    {
+        return hal::memberwise::batch::reduce(records[0], maximum, records);
+    };
+    BENCHMARK("handwritten")
+    {
+        auto peak = records[0];
+        for (auto const& t : records) {
+            peak.bid      = std::max(peak.bid, t.bid);
+            peak.ask      = std::max(peak.ask, t.ask);
+            peak.bid_size = std::max(peak.bid_size, t.bid_size);
+            peak.ask_size = std::max(peak.ask_size, t.ask_size);
+            peak.volume   = std::max(peak.volume, t.volume);
+        }
+        return peak;
+    };
+    BENCHMARK("par")
+    {
+        return hal::par::memberwise::batch::reduce(records[0], maximum,
+                                                   records);
+    };
+}
@@ -0,0 +1,83 @@
+#ifndef HAL_BENCH_DATA_HPP
+#define HAL_BENCH_DATA_HPP
+#include <array>
+#include <cstddef>
+#include <random>
+#include <string>
+
+#include <catch2/catch.hpp>
+
+/// Expands to the eight elements of array \p a, to spell out packs by hand.
+#define HAL_BENCH_PACK8(a) a[0], a[1], a[2], a[3], a[4], a[5], a[6], a[7]
+
+namespace bench {
+
+/// Seeded from the command line with --rng-seed, so runs are repeatable.
+inline auto rng() -> std::mt19937&
+{
+    static auto engine = std::mt19937{Catch::rngSeed()};
+    return engine;
+}
+
+/// Values in [0, 100), unknown to the optimizer.
+inline auto scalars() -> std::array<long, 8>
+{
+    auto dist   = std::uniform_int_distribution<long>{0, 99};
+    auto result = std::array<long, 8>{};
+    for (auto& x : result)
+        x = dist(rng());
+    return result;
+}
+
+/// Strings of lowercase letters, between 8 and 40 characters long.
+inline auto strings() -> std::array<std::string, 8>
+{
+    auto length = std::uniform_int_distribution<std::size_t>{8, 40};
+    auto letter = std::uniform_int_distribution<int>{'a', 'z'};
+    auto result = std::array<std::string, 8>{};
+    for (auto& s : result) {
+        s.resize(length(rng()));
+        for (auto& c : s)
+            c = static_cast<char>(letter(rng()));
+    }
+    return result;
+}
+
+/// An object that is expensive to copy.
+struct Heavy {
+    std::array<double, 32> values;
+    std::string tag;
+};
+
+inline auto heavies() -> std::array<Heavy, 8>
+{
+    auto dist   = std::uniform_real_distribution<double>{0., 1.};
+    auto result = std::array<Heavy, 8>{};
+    for (auto& h : result) {
+        for (auto& v : h.values)
+            v = dist(rng());
+        h.tag = h.values[0] < 0.5 ? "low" : "high";
+    }
+    return result;
+}
+
+/// Aggregate for memberwise:: algorithms.
+struct Tick {
+    long bid;
+    long ask;
+    long bid_size;
+    long ask_size;
+    long volume;
+    long trades;
+    long high;
+    long low;
+};
+
+inline auto tick() -> Tick
+{
+    auto const s = scalars();
+    return Tick{HAL_BENCH_PACK8(s)};
+}
+
+}  // namespace bench
+#endif  // HAL_BENCH_DATA_HPP
@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+"""Runs hal-bench executables and writes a HAL vs handwritten comparison table.
+
+Each executable is the same benchmark suite built at a different optimization
+level. Every test case holds a "hal" and a "handwritten" benchmark, the table
+lists their mean times and the ratio hal / handwritten per level.
+
+The markdown table is meant to be committed or diffed between releases, the
+CSV next to it holds the same data for scripts.
+"""
+
+import argparse
+import csv
+import os
+import subprocess
+import sys
+import xml.etree.ElementTree as ET
+
+
+def run(executable, catch_args):
+    out = subprocess.run([executable, "-r", "xml"] + catch_args,
+                         capture_output=True, text=True)
+    if out.returncode != 0 and not out.stdout:
+        sys.exit("{} failed:\n{}".format(executable, out.stderr))
+    return ET.fromstring(out.stdout)
+
+
+def means(root):
+    """Maps test case name -> {benchmark name: mean ns}."""
+    result = {}
+    for case in root.iter("TestCase"):
+        for bench in case.iter("BenchmarkResults"):
+            mean = bench.find("mean")
+            if mean is not None:
+                result.setdefault(case.get("name"), {})[bench.get("name")] = \
+                    float(mean.get("value"))
+    return result
+
+
+def parse_args():
+    p = argparse.ArgumentParser(description=__doc__,
+                                formatter_class=argparse.RawTextHelpFormatter)
+    p.add_argument("--output", required=True, help="markdown table path")
+    p.add_argument("--run", nargs=2, action="append", required=True,
+                   metavar=("LABEL", "EXECUTABLE"),
+                   help="label (e.g. O2) and benchmark executable")
+    p.add_argument("catch_args", nargs="*",
+                   help="passed to each executable, after --")
+    return p.parse_args()
+
+
+def main():
+    args = parse_args()
+    rows = []
+    for label, executable in args.run:
+        print("Running {} ({})".format(label, executable), flush=True)
+        for case, bench in means(run(executable, args.catch_args)).items():
+            hal, hand = bench.get("hal"), bench.get("handwritten")
+            ratio = hal / hand if hal and hand else float("nan")
+            rows.append((case, label, hal, hand, ratio))
+
+    with open(args.output, "w") as f:
+        f.write("| case | level | hal (ns) | handwritten (ns) | ratio |\n")
+        f.write("|---|---|---:|---:|---:|\n")
+        for case, label, hal, hand, ratio in rows:
+            f.write("| {} | {} | {:.2f} | {:.2f} | {:.2f} |\n".format(
+                case, label, hal or float("nan"), hand or float("nan"), ratio))
+
+    csv_path = os.path.splitext(args.output)[0] + ".csv"
+    with open(csv_path, "w", newline="") as f:
+        w = csv.writer(f)
+        w.writerow(["case", "level", "hal_ns", "handwritten_ns", "ratio"])
+        w.writerows(rows)
+
+    with open(args.output) as f:
+        print(f.read())
+    print("Wrote {} and {}".format(args.output, csv_path))
+
+
+if __name__ == "__main__":
+    main()
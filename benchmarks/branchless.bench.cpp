@@ -0,0 +1,154 @@
+#include <array>
+#include <cstddef>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+#include "bench_data.hpp"
+
+namespace {
+
+constexpr auto size = std::size_t{32};
+
+using Pack = std::array<int, size>;
+
+/// Invokes \p f with each element of \p a as a parameter pack.
+template <typename Fn>
+auto with_pack(Pack const& a, Fn&& f) -> decltype(auto)
+{
+    return [&]<std::size_t... I>(std::index_sequence<I...>)->decltype(auto)
+    {
+        return f(a[I]...);
+    }
+    (std::make_index_sequence<size>{});
+}
+
+/** Packs of values in [0, 100). Each benchmark iteration moves on to the next
+    pack, so the branch predictor cannot learn the outcome of each compare. */
+class Packs {
+   public:
+    Packs() : packs_(count)
+    {
+        auto dist = std::uniform_int_distribution<int>{0, 99};
+        for (auto& pack : packs_) {
+            for (auto& x : pack)
+                x = dist(bench::rng());
+        }
+    }
+
+    auto next() -> Pack const&
+    {
+        index_ = (index_ + 1) % count;
+        return packs_[index_];
+    }
+
+   private:
+    static constexpr auto count = std::size_t{4096};
+
+    std::vector<Pack> packs_;
+    std::size_t index_ = 0;
+};
+
+constexpr auto below_50 = [](int x) { return x < 50; };
+constexpr auto below_98 = [](int x) { return x < 98; };
+constexpr auto above_95 = [](int x) { return x > 95; };
+
+}  // namespace
+
+// "hal" is the branchless version, "handwritten" a loop that branches on each
+// element, and "branching" the hal:: algorithm it replaces.
+
+TEST_CASE("branchless: count_if 32 ints", "[bench]")
+{
+    auto packs = Packs{};
+
+    BENCHMARK("hal")
+    {
+        return with_pack(packs.next(), hal::branchless::count_if(below_50));
+    };
+    BENCHMARK("handwritten")
+    {
+        auto count = std::size_t{0};
+        for (auto x : packs.next()) {
+            if (below_50(x))
+                ++count;
+        }
+        return count;
+    };
+    BENCHMARK("branching")
+    {
+        return with_pack(packs.next(), hal::count_if(below_50));
+    };
+}
+
+TEST_CASE("branchless: all_of 32 ints", "[bench]")
+{
+    // Around half of the packs are all below 98, and the others fail at a
+    // random element.
+    auto packs = Packs{};
+
+    BENCHMARK("hal")
+    {
+        return with_pack(packs.next(), hal::branchless::all_of(below_98));
+    };
+    BENCHMARK("handwritten")
+    {
+        for (auto x : packs.next()) {
+            if (!below_98(x))
+                return false;
+        }
+        return true;
+    };
+    BENCHMARK("branching")
+    {
+        return with_pack(packs.next(), hal::all_of(below_98));
+    };
+}
+
+TEST_CASE("branchless: any_of 32 ints", "[bench]")
+{
+    auto packs = Packs{};
+
+    BENCHMARK("hal")
+    {
+        return with_pack(packs.next(), hal::branchless::any_of(above_95));
+    };
+    BENCHMARK("handwritten")
+    {
+        for (auto x : packs.next()) {
+            if (above_95(x))
+                return true;
+        }
+        return false;
+    };
+    BENCHMARK("branching")
+    {
+        return with_pack(packs.next(), hal::any_of(above_95));
+    };
+}
+
+TEST_CASE("branchless: find_if 32 ints", "[bench]")
+{
+    auto packs = Packs{};
+
+    BENCHMARK("hal")
+    {
+        return with_pack(packs.next(), hal::branchless::find_if(above_95));
+    };
+    BENCHMARK("handwritten")
+    {
+        auto const& pack = packs.next();
+        for (auto i = std::size_t{0}; i < size; ++i) {
+            if (above_95(pack[i]))
+                return i;
+        }
+        return size;
+    };
+    BENCHMARK("branching")
+    {
+        return with_pack(packs.next(), hal::find_if(above_95));
+    };
+}
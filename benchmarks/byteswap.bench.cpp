@@ -0,0 +1,75 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <arpa/inet.h>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+#include "bench_data.hpp"
+
+namespace {
+
+/// An order book update as it arrives from the network, 24 bytes.
+struct Order {
+    std::uint32_t sequence;
+    std::uint16_t kind;
+    std::uint8_t side;
+    std::int64_t price;
+    std::array<std::uint16_t, 2> sizes;
+    std::uint32_t venue;
+};
+
+constexpr auto count = std::size_t{1'000'000};
+
+auto orders() -> std::vector<Order> const&
+{
+    static auto const result = [] {
+        auto value  = std::uniform_int_distribution<std::uint32_t>{};
+        auto orders = std::vector<Order>(count);
+        for (auto& o : orders) {
+            o = Order{value(bench::rng()),
+                      static_cast<std::uint16_t>(value(bench::rng())),
+                      static_cast<std::uint8_t>(value(bench::rng())),
+                      static_cast<std::int64_t>(value(bench::rng())),
+                      {static_cast<std::uint16_t>(value(bench::rng())),
+                       static_cast<std::uint16_t>(value(bench::rng()))},
+                      value(bench::rng())};
+        }
+        return orders;
+    }();
+    return result;
+}
+
+}  // namespace
+
+// "hal" swaps runs of records with byte shuffles when built with SSSE3 or
+// AVX2, "handwritten" converts field by field with ntohl and friends. Each
+// reads and writes 24 MB.
+
+TEST_CASE("byteswap: 1M network orders to native", "[bench]")
+{
+    auto records = orders();
+
+    BENCHMARK("hal")
+    {
+        hal::memberwise::to_native_endian(records);
+        return records.back().sequence;
+    };
+    BENCHMARK("handwritten")
+    {
+        for (auto& o : records) {
+            o.sequence = ntohl(o.sequence);
+            o.kind     = ntohs(o.kind);
+            o.price    = static_cast<std::int64_t>(
+                be64toh(static_cast<std::uint64_t>(o.price)));
+            o.sizes[0] = ntohs(o.sizes[0]);
+            o.sizes[1] = ntohs(o.sizes[1]);
+            o.venue    = ntohl(o.venue);
+        }
+        return records.back().sequence;
+    };
+}
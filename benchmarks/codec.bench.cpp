@@ -0,0 +1,137 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <hal/codec.hpp>
+#include "bench_data.hpp"
+
+namespace {
+
+constexpr auto count = std::size_t{1'000'000};
+
+/// Sorted timestamps in microseconds, with gaps of up to a millisecond.
+auto timestamps() -> std::vector<std::int64_t>
+{
+    auto gap   = std::uniform_int_distribution<std::int64_t>{0, 1000};
+    auto times = std::vector<std::int64_t>(count);
+    auto time  = std::int64_t{1'700'000'000'000'000};
+    for (auto& t : times) {
+        time += gap(bench::rng());
+        t = time;
+    }
+    return times;
+}
+
+}  // namespace
+
+// Timestamps shrink from 8 bytes to about 2. Decoding them is bound by the
+// branch per LEB128 byte, "hal" should keep up with the handwritten loop, and
+// both with a plain copy of the raw 8 MB.
+
+TEST_CASE("codec: decode 1M timestamps", "[bench]")
+{
+    auto const times = timestamps();
+    auto bytes       = std::vector<std::byte>{};
+    hal::codec::encode(times, bytes);
+    auto decoded = std::vector<std::int64_t>(count);
+
+    BENCHMARK("hal")
+    {
+        hal::codec::decode(bytes, decoded);
+        return decoded.back();
+    };
+
+    BENCHMARK("handwritten")
+    {
+        auto position = std::size_t{0};
+        auto previous = std::uint64_t{0};
+        for (auto& time : decoded) {
+            auto value = std::uint64_t{0};
+            auto shift = 0;
+            auto byte  = 0u;
+            do {
+                byte = std::to_integer<unsigned>(bytes[position++]);
+                value |= std::uint64_t{byte & 0x7F} << shift;
+                shift += 7;
+            } while (byte >= 0x80);
+            previous += (value >> 1) ^ (0 - (value & 1));
+            time = static_cast<std::int64_t>(previous);
+        }
+        return decoded.back();
+    };
+
+    BENCHMARK("raw copy")
+    {
+        std::memcpy(decoded.data(), times.data(), count * sizeof(times[0]));
+        return decoded.back();
+    };
+}
+
+TEST_CASE("codec: group varint 1M gaps", "[bench]")
+{
+    auto gap  = std::uniform_int_distribution<std::uint32_t>{0, 100'000};
+    auto gaps = std::vector<std::uint32_t>(count);
+    for (auto& g : gaps)
+        g = gap(bench::rng());
+    auto leb128 = std::vector<std::byte>{};
+    hal::codec::leb128_encode(gaps, leb128);
+    auto group = std::vector<std::byte>{};
+    hal::codec::group_varint_encode(gaps, group);
+    auto decoded = std::vector<std::uint32_t>(count);
+
+    // Group varint has no branch per byte, so it doesn't mispredict on mixed
+    // lengths like the handwritten LEB128 loop does.
+    BENCHMARK("hal")
+    {
+        hal::codec::group_varint_decode(group, decoded);
+        return decoded.back();
+    };
+
+    BENCHMARK("handwritten")
+    {
+        auto position = std::size_t{0};
+        for (auto& value : decoded) {
+            auto shift = 0;
+            auto byte  = 0u;
+            value      = 0;
+            do {
+                byte = std::to_integer<unsigned>(leb128[position++]);
+                value |= (byte & 0x7F) << shift;
+                shift += 7;
+            } while (byte >= 0x80);
+        }
+        return decoded.back();
+    };
+}
+
+TEST_CASE("codec: delta decode 1M values", "[bench]")
+{
+    auto gap    = std::uniform_int_distribution<std::uint32_t>{0, 1000};
+    auto deltas = std::vector<std::uint32_t>(count);
+    for (auto& d : deltas)
+        d = gap(bench::rng());
+    auto values = deltas;
+
+    // A SIMD prefix sum, two registers at a time, against a running sum.
+    BENCHMARK("hal")
+    {
+        values = deltas;
+        hal::codec::delta_decode(values);
+        return values.back();
+    };
+
+    BENCHMARK("handwritten")
+    {
+        values     = deltas;
+        auto carry = std::uint32_t{0};
+        for (auto& value : values) {
+            carry += value;
+            value = carry;
+        }
+        return values.back();
+    };
+}
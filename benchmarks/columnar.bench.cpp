@@ -0,0 +1,84 @@
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+#include <hal/columnar.hpp>
+#include <hal/record_file.hpp>
+#include "bench_data.hpp"
+
+namespace {
+
+/// 16 members, of which a query reads 2.
+struct Wide {
+    double m0, m1, m2, m3, m4, m5, m6, m7;
+    double m8, m9, m10, m11, m12, m13, m14, m15;
+};
+
+constexpr auto count = std::size_t{500'000};
+
+auto wide_records() -> std::vector<Wide>
+{
+    auto value   = std::uniform_real_distribution<double>{0., 1.};
+    auto records = std::vector<Wide>(count);
+    hal::memberwise::batch::for_each(
+        [&](double& m) { m = value(bench::rng()); }, records);
+    return records;
+}
+
+auto temporary(char const* name) -> std::filesystem::path
+{
+    return std::filesystem::temp_directory_path() /
+           (name + std::to_string(::getpid()));
+}
+
+}  // namespace
+
+// 64 MB of records, with the files in the page cache. "handwritten" reads
+// the row file in place with hal::record_file, "hal" reads two column blocks
+// per row group of the columnar file.
+
+TEST_CASE("columnar: sum 2 of 16 members of 500k records", "[bench]")
+{
+    auto const records      = wide_records();
+    auto const row_path     = temporary("hal_bench_rows_");
+    auto const columns_path = temporary("hal_bench_columns_");
+    {
+        auto rows = std::vector<std::byte>(count * sizeof(Wide));
+        std::memcpy(rows.data(), records.data(), rows.size());
+        auto file = std::ofstream{row_path, std::ios::binary};
+        file.write(reinterpret_cast<char const*>(rows.data()),
+                   static_cast<std::streamsize>(rows.size()));
+        auto writer = hal::columnar_writer<Wide>{columns_path};
+        writer.write(records);
+    }
+    auto const rows    = hal::record_file<Wide>{row_path};
+    auto const columns = hal::columnar_reader<Wide>{columns_path};
+
+    BENCHMARK("hal")
+    {
+        auto total = 0.;
+        for (auto [m0, m3] : columns.columns<0, 3>()) {
+            for (auto i = std::size_t{0}; i < m0.size(); ++i)
+                total += m0[i] * m3[i];
+        }
+        return total;
+    };
+    BENCHMARK("handwritten")
+    {
+        auto total = 0.;
+        for (auto const& record : rows.records())
+            total += record.m0 * record.m3;
+        return total;
+    };
+    std::filesystem::remove(row_path);
+    std::filesystem::remove(columns_path);
+}
@@ -0,0 +1,163 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+#include "bench_data.hpp"
+
+namespace {
+
+/// A resting order, 16 bytes without padding.
+struct Order {
+    std::uint32_t account;
+    std::uint16_t venue;
+    std::uint8_t side;
+    std::uint8_t flags;
+    std::uint64_t id;
+};
+
+/// A quote with a fixed width symbol and padding after size, 24 bytes.
+struct Quote {
+    std::array<unsigned char, 8> symbol;
+    std::uint32_t size;
+    double price;
+};
+
+// The operators the structs would otherwise be written with.
+auto operator==(Order const& a, Order const& b) -> bool
+{
+    return a.account == b.account && a.venue == b.venue && a.side == b.side &&
+           a.flags == b.flags && a.id == b.id;
+}
+
+auto operator<(Order const& a, Order const& b) -> bool
+{
+    if (a.account != b.account)
+        return a.account < b.account;
+    if (a.venue != b.venue)
+        return a.venue < b.venue;
+    if (a.side != b.side)
+        return a.side < b.side;
+    if (a.flags != b.flags)
+        return a.flags < b.flags;
+    return a.id < b.id;
+}
+
+auto operator<(Quote const& a, Quote const& b) -> bool
+{
+    if (a.symbol != b.symbol)
+        return a.symbol < b.symbol;
+    if (a.size != b.size)
+        return a.size < b.size;
+    return a.price < b.price;
+}
+
+constexpr auto count = std::size_t{10'000'000};
+
+/// Orders with many duplicates, few accounts and venues.
+auto orders() -> std::vector<Order> const&
+{
+    static auto const result = [] {
+        auto small  = std::uniform_int_distribution<std::uint32_t>{0, 63};
+        auto orders = std::vector<Order>(count);
+        for (auto& o : orders) {
+            o = Order{small(bench::rng()),
+                      static_cast<std::uint16_t>(small(bench::rng()) % 4),
+                      static_cast<std::uint8_t>(small(bench::rng()) % 2), 0,
+                      small(bench::rng()) * 1000u};
+        }
+        return orders;
+    }();
+    return result;
+}
+
+/// Quotes over a few hundred symbols that share their first bytes.
+auto quotes() -> std::vector<Quote> const&
+{
+    static auto const result = [] {
+        auto value  = std::uniform_int_distribution<std::uint32_t>{};
+        auto quotes = std::vector<Quote>(count);
+        for (auto& q : quotes) {
+            auto const id = value(bench::rng());
+            q = Quote{{'S', 'Y', 'M', '.', static_cast<unsigned char>(id % 7),
+                       static_cast<unsigned char>(id / 7 % 50)},
+                      id % 1000, (id % 4096) * 0.25};
+        }
+        return quotes;
+    }();
+    return result;
+}
+
+}  // namespace
+
+// "hal" compares with memberwise::less and equal, "handwritten" with the
+// operators above. Each sort copies the 10M records first.
+
+TEST_CASE("compare: sort 10M orders", "[bench]")
+{
+    auto const& records = orders();
+    auto sorted         = records;
+
+    BENCHMARK("hal")
+    {
+        sorted = records;
+        std::sort(sorted.begin(), sorted.end(), [](auto& a, auto& b) {
+            return hal::memberwise::less(a, b);
+        });
+        return sorted.front().id;
+    };
+    BENCHMARK("handwritten")
+    {
+        sorted = records;
+        std::sort(sorted.begin(), sorted.end());
+        return sorted.front().id;
+    };
+}
+
+TEST_CASE("compare: dedup 10M sorted orders", "[bench]")
+{
+    auto sorted = orders();
+    std::sort(sorted.begin(), sorted.end());
+    auto unique = sorted;
+
+    BENCHMARK("hal")
+    {
+        unique = sorted;
+        return std::unique(unique.begin(), unique.end(),
+                           [](auto& a, auto& b) {
+                               return hal::memberwise::equal(a, b);
+                           }) -
+               unique.begin();
+    };
+    BENCHMARK("handwritten")
+    {
+        unique = sorted;
+        return std::unique(unique.begin(), unique.end()) - unique.begin();
+    };
+}
+
+TEST_CASE("compare: sort 10M quotes by symbol", "[bench]")
+{
+    auto const& records = quotes();
+    auto sorted         = records;
+
+    BENCHMARK("hal")
+    {
+        sorted = records;
+        std::sort(sorted.begin(), sorted.end(), [](auto& a, auto& b) {
+            return hal::memberwise::less(a, b);
+        });
+        return sorted.front().size;
+    };
+    BENCHMARK("handwritten")
+    {
+        sorted = records;
+        std::sort(sorted.begin(), sorted.end());
+        return sorted.front().size;
+    };
+}
@@ -0,0 +1,338 @@
+#!/usr/bin/env python3
+"""Measures the compile time cost of each HAL algorithm against pack size.
+
+Generates one translation unit per (algorithm, size) pair, compiles each one
+and records wall time, peak compiler RSS and a per-phase time breakdown. The
+breakdown comes from -ftime-trace with clang and -ftime-report with gcc.
+
+Direct algorithms are called with a pack of `size` elements. Memberwise
+algorithms are called once on each of `size` distinct 16 member structs, so
+they measure the per-type cost of aggregate introspection.
+
+Results are written as JSON and CSV, see --output.
+"""
+
+import argparse
+import csv
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+
+DEFAULT_SIZES = [8, 64, 256, 1024]
+MEMBER_COUNT = 16
+
+# name -> statement, `xs` is a pack of long lvalues.
+DIRECT = {
+    "for_each": "hal::for_each([](auto& x) { x += 1; }, xs...);",
+    "reduce": "r += hal::reduce(0L, std::plus<>{}, xs...);",
+    "tree_reduce": "r += hal::tree_reduce(0L, std::plus<>{}, xs...);",
+    "partial_reduce": "hal::partial_reduce(0L, std::plus<>{}, xs...);",
+    "transform": "hal::transform([](long x) { return x * 2; }, xs...);",
+    "transform_reduce":
+        "r += hal::transform_reduce(0L, [](long x) { return x * 2; }, "
+        "std::plus<>{}, xs...);",
+    "partial_transform_reduce":
+        "hal::partial_transform_reduce(0L, [](long x) { return x * 2; }, "
+        "std::plus<>{}, xs...);",
+    "find_if": "r += hal::find_if([](long x) { return x > 3; }, xs...);",
+    "find_if_not":
+        "r += hal::find_if_not([](long x) { return x > 3; }, xs...);",
+    "find": "r += hal::find(3L, xs...);",
+    "count_if": "r += hal::count_if([](long x) { return x > 3; }, xs...);",
+    "count": "r += hal::count(3L, xs...);",
+    "all_of": "r += hal::all_of([](long x) { return x > 3; }, xs...);",
+    "any_of": "r += hal::any_of([](long x) { return x > 3; }, xs...);",
+    "none_of": "r += hal::none_of([](long x) { return x > 3; }, xs...);",
+    "branchless::count_if":
+        "r += hal::branchless::count_if([](long x) { return x > 3; }, xs...);",
+    "branchless::find_if":
+        "r += hal::branchless::find_if([](long x) { return x > 3; }, xs...);",
+    "adjacent_transform_reduce":
+        "r += hal::adjacent_transform_reduce(0L, std::minus<>{}, "
+        "std::plus<>{}, xs...);",
+    "adjacent_transform": "hal::adjacent_transform(std::minus<>{}, xs...);",
+    "adjacent_difference": "hal::adjacent_difference(xs...);",
+    "adjacent_find": "r += hal::adjacent_find(xs...);",
+    "last": "r += hal::last(xs...);",
+    "partial_sum": "hal::partial_sum(xs...);",
+    "partial_product": "hal::partial_product(xs...);",
+    "reverse::for_each":
+        "hal::reverse::for_each([](auto& x) { x += 1; }, xs...);",
+    "reverse::reduce": "r += hal::reverse::reduce(0L, std::plus<>{}, xs...);",
+    "reverse::partial_reduce":
+        "hal::reverse::partial_reduce(0L, std::plus<>{}, xs...);",
+    "reverse::transform":
+        "hal::reverse::transform([](long x) { return x * 2; }, xs...);",
+    "reverse::transform_reduce":
+        "r += hal::reverse::transform_reduce(0L, [](long x) { return x * 2; "
+        "}, std::plus<>{}, xs...);",
+    "reverse::partial_transform_reduce":
+        "hal::reverse::partial_transform_reduce(0L, [](long x) { return x * "
+        "2; }, std::plus<>{}, xs...);",
+    "reverse::find_if":
+        "r += hal::reverse::find_if([](long x) { return x > 3; }, xs...);",
+    "reverse::find": "r += hal::reverse::find(3L, xs...);",
+    "reverse::all_of":
+        "r += hal::reverse::all_of([](long x) { return x > 3; }, xs...);",
+    "reverse::any_of":
+        "r += hal::reverse::any_of([](long x) { return x > 3; }, xs...);",
+    "reverse::partial_sum": "hal::reverse::partial_sum(xs...);",
+}
+
+# name -> statement, `s` is an lvalue aggregate.
+MEMBERWISE = {
+    "to_tuple": "r += std::get<0>(hal::to_tuple(s));",
+    "to_ref_tuple": "r += std::get<0>(hal::to_ref_tuple(s));",
+    "memberwise::for_each":
+        "hal::memberwise::for_each([](auto& x) { x += 1; }, s);",
+    "memberwise::reduce":
+        "r += hal::memberwise::reduce(0L, std::plus<>{}, s);",
+    "memberwise::tree_reduce":
+        "r += hal::memberwise::tree_reduce(0L, std::plus<>{}, s);",
+    "memberwise::partial_reduce":
+        "hal::memberwise::partial_reduce(0L, std::plus<>{}, s);",
+    "memberwise::partial_sum": "hal::memberwise::partial_sum(s);",
+    "reverse::memberwise::for_each":
+        "hal::reverse::memberwise::for_each([](auto& x) { x += 1; }, s);",
+    "reverse::memberwise::reduce":
+        "r += hal::reverse::memberwise::reduce(0L, std::plus<>{}, s);",
+    "reverse::memberwise::partial_sum":
+        "hal::reverse::memberwise::partial_sum(s);",
+}
+
+PRELUDE = """\
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <utility>
+
+#include <hal.hpp>
+"""
+
+DIRECT_TU = PRELUDE + """
+template <std::size_t... I>
+auto bench(std::array<long, sizeof...(I)>& a, std::index_sequence<I...>)
+    -> long
+{{
+    auto r = 0L;
+    [&](auto&... xs) {{ {statement} }}(a[I]...);
+    return r;
+}}
+
+auto run(std::array<long, {size}>& a) -> long
+{{
+    return bench(a, std::make_index_sequence<{size}>{{}});
+}}
+"""
+
+MEMBERWISE_TU = PRELUDE + """
+template <std::size_t>
+struct Aggregate {{
+    {members}
+}};
+
+template <std::size_t I>
+auto bench_one(Aggregate<I>& s) -> long
+{{
+    auto r = 0L;
+    {statement}
+    return r;
+}}
+
+template <std::size_t... I>
+auto bench(std::index_sequence<I...>) -> long
+{{
+    auto aggregates = std::tuple<Aggregate<I>...>{{}};
+    return (bench_one(std::get<I>(aggregates)) + ... + 0L);
+}}
+
+auto run() -> long {{ return bench(std::make_index_sequence<{size}>{{}}); }}
+"""
+
+BASELINE_TU = PRELUDE + "\nauto run() -> long { return 0L; }\n"
+
+
+def members():
+    return " ".join("long m{} = {};".format(i, i) for i in range(MEMBER_COUNT))
+
+
+def generate(mode, name, size):
+    if mode == "baseline":
+        return BASELINE_TU
+    if mode == "direct":
+        return DIRECT_TU.format(statement=DIRECT[name], size=size)
+    return MEMBERWISE_TU.format(statement=MEMBERWISE[name], size=size,
+                                members=members())
+
+
+def is_clang(compiler):
+    out = subprocess.run([compiler, "--version"], capture_output=True,
+                         text=True).stdout
+    return "clang" in out
+
+
+def max_rss_kb(rusage):
+    # ru_maxrss is kilobytes on Linux, bytes on macOS.
+    if sys.platform == "darwin":
+        return rusage.ru_maxrss // 1024
+    return rusage.ru_maxrss
+
+
+def clang_breakdown(trace_path):
+    """Sums the 'Total ...' events clang writes at the end of a time trace."""
+    with open(trace_path) as f:
+        events = json.load(f).get("traceEvents", [])
+    totals = {}
+    for e in events:
+        name = e.get("name", "")
+        if name.startswith("Total ") and "dur" in e:
+            totals[name[len("Total "):]] = e["dur"] / 1e6
+    return totals
+
+
+# " phase parsing   :   0.45 ( 88%)   0.24 ( 92%)   0.70 ( 90%)    46M ( 89%)"
+#                        usr            sys            wall           GGC
+TIME_REPORT_LINE = re.compile(
+    r"^[\s|]*(?P<phase>[^:]+?)\s*:"
+    r"\s*[0-9.]+\s*\(\s*\d+%\)\s*[0-9.]+\s*\(\s*\d+%\)\s*(?P<wall>[0-9.]+)")
+
+
+def gcc_breakdown(stderr):
+    """Parses the wall column of gcc's -ftime-report."""
+    totals = {}
+    for line in stderr.splitlines():
+        m = TIME_REPORT_LINE.match(line)
+        if m and m.group("phase") != "TOTAL":
+            totals[m.group("phase")] = float(m.group("wall"))
+    return totals
+
+
+def compile_once(args, clang, source, obj):
+    cmd = [args.compiler, "-std=c++20", "-I", args.include, "-c", source,
+           "-o", obj] + args.flags
+    cmd += ["-ftime-trace"] if clang else ["-ftime-report"]
+    with tempfile.TemporaryFile(mode="w+") as err:
+        start = time.perf_counter()
+        proc = subprocess.Popen(cmd, stdout=subprocess.DEVNULL, stderr=err)
+        timer = threading.Timer(args.timeout, proc.kill)
+        timer.start()
+        # wait4 gives the resource usage of this one compiler process.
+        _, status, rusage = os.wait4(proc.pid, 0)
+        wall = time.perf_counter() - start
+        timed_out = not timer.is_alive()
+        timer.cancel()
+        proc.returncode = os.waitstatus_to_exitcode(status)
+        err.seek(0)
+        stderr = err.read()
+
+    if timed_out:
+        return {"status": "timeout", "wall_s": round(wall, 4)}
+    result = {
+        "status": "ok" if proc.returncode == 0 else "error",
+        "wall_s": round(wall, 4),
+        "peak_rss_kb": max_rss_kb(rusage),
+    }
+    if proc.returncode != 0:
+        result["error"] = stderr[:2000]
+        return result
+    if clang:
+        trace = os.path.splitext(obj)[0] + ".json"
+        if os.path.exists(trace):
+            result["time_trace"] = clang_breakdown(trace)
+            result["time_trace_file"] = trace
+    else:
+        result["time_trace"] = gcc_breakdown(stderr)
+    return result
+
+
+def measure(args, clang, mode, name, size):
+    stem = "{}_{}_{}".format(mode, name.replace("::", "_"), size)
+    source = os.path.join(args.work_dir, stem + ".cpp")
+    obj = os.path.join(args.work_dir, stem + ".o")
+    with open(source, "w") as f:
+        f.write(generate(mode, name, size))
+
+    best = None
+    for _ in range(args.repeat):
+        result = compile_once(args, clang, source, obj)
+        if result["status"] != "ok":
+            best = result
+            break
+        if best is None or result["wall_s"] < best["wall_s"]:
+            best = result
+    best.update({"mode": mode, "algorithm": name, "size": size})
+    return best
+
+
+def parse_args():
+    p = argparse.ArgumentParser(description=__doc__,
+                                formatter_class=argparse.RawTextHelpFormatter)
+    p.add_argument("--compiler", required=True)
+    p.add_argument("--include", required=True, help="HAL include directory")
+    p.add_argument("--work-dir", required=True,
+                   help="directory for generated sources and objects")
+    p.add_argument("--output", required=True,
+                   help="report path, a .csv is written next to the .json")
+    p.add_argument("--sizes", type=int, nargs="+", default=DEFAULT_SIZES)
+    p.add_argument("--filter", default="",
+                   help="regex, only algorithms matching are measured")
+    p.add_argument("--repeat", type=int, default=1,
+                   help="compiles per TU, the fastest is reported")
+    p.add_argument("--timeout", type=float, default=600)
+    p.add_argument("--flags", nargs=argparse.REMAINDER, default=[],
+                   help="extra compiler flags, must be last")
+    return p.parse_args()
+
+
+def main():
+    args = parse_args()
+    os.makedirs(args.work_dir, exist_ok=True)
+    clang = is_clang(args.compiler)
+    pattern = re.compile(args.filter)
+
+    jobs = [("baseline", "baseline", 0)]
+    for mode, table in (("direct", DIRECT), ("memberwise", MEMBERWISE)):
+        for name in table:
+            if pattern.search(name):
+                jobs += [(mode, name, size) for size in args.sizes]
+
+    results = []
+    for mode, name, size in jobs:
+        r = measure(args, clang, mode, name, size)
+        results.append(r)
+        print("{:<11} {:<36} {:>5} {:>8} {:>9.3f}s {:>8} KB".format(
+            mode, name, size, r["status"], r.get("wall_s", float("nan")),
+            r.get("peak_rss_kb", 0)), flush=True)
+
+    report = {
+        "compiler": args.compiler,
+        "compiler_version": subprocess.run(
+            [args.compiler, "--version"], capture_output=True,
+            text=True).stdout.splitlines()[0],
+        "flags": args.flags,
+        "member_count": MEMBER_COUNT,
+        "results": results,
+    }
+    with open(args.output, "w") as f:
+        json.dump(report, f, indent=2)
+
+    csv_path = os.path.splitext(args.output)[0] + ".csv"
+    with open(csv_path, "w", newline="") as f:
+        w = csv.writer(f)
+        w.writerow(["mode", "algorithm", "size", "status", "wall_s",
+                    "peak_rss_kb"])
+        for r in results:
+            w.writerow([r["mode"], r["algorithm"], r["size"], r["status"],
+                        r.get("wall_s", ""), r.get("peak_rss_kb", "")])
+
+    print("Wrote {} and {}".format(args.output, csv_path))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <hal/concurrent.hpp>
+#include "bench_data.hpp"
+
+namespace {
+
+struct Quote {
+    std::uint64_t sequence;
+    double bid;
+    double ask;
+    std::int32_t bid_size;
+    std::int32_t ask_size;
+};
+
+constexpr auto reads = std::size_t{100'000};
+
+/** Runs \p readers threads that each call read() \p reads times, while this
+    thread calls write() until they are done. Returns a sum of what was read,
+    so the reads aren't optimized away. */
+template <typename Read, typename Write>
+auto contend(std::size_t readers, Read read, Write write) -> std::uint64_t
+{
+    auto sum     = std::atomic<std::uint64_t>{0};
+    auto running = std::atomic<std::size_t>{readers};
+    auto threads = std::vector<std::thread>{};
+    for (auto r = std::size_t{0}; r < readers; ++r) {
+        threads.emplace_back([&] {
+            auto local = std::uint64_t{0};
+            for (auto i = std::size_t{0}; i < reads; ++i)
+                local += read().sequence;
+            sum += local;
+            --running;
+        });
+    }
+    for (auto i = std::uint64_t{1}; running != 0; ++i) {
+        write(Quote{i, 100. + i, 100.5 + i, 1, 1});
+        std::this_thread::yield();
+    }
+    for (auto& thread : threads)
+        thread.join();
+    return sum;
+}
+
+/// The guarded quote that "handwritten" readers share.
+struct Guarded {
+    mutable std::shared_mutex mutex;
+    Quote quote{};
+};
+
+}  // namespace
+
+// Readers copy a quote that one writer keeps replacing. "hal" reads through
+// memberwise::seqlocked, "handwritten" takes a std::shared_mutex in shared
+// mode, so readers contend on the cache line of the mutex.
+
+TEST_CASE("concurrent: 100k quote reads, 1 reader", "[bench]")
+{
+    auto locked  = hal::memberwise::seqlocked<Quote>{};
+    auto guarded = Guarded{};
+
+    BENCHMARK("hal")
+    {
+        return contend(
+            1, [&] { return locked.load(); },
+            [&](Quote const& q) { locked.store(q); });
+    };
+    BENCHMARK("handwritten")
+    {
+        return contend(
+            1,
+            [&] {
+                auto const lock = std::shared_lock{guarded.mutex};
+                return guarded.quote;
+            },
+            [&](Quote const& q) {
+                auto const lock = std::unique_lock{guarded.mutex};
+                guarded.quote   = q;
+            });
+    };
+}
+
+TEST_CASE("concurrent: 100k quote reads, a reader per core", "[bench]")
+{
+    auto const readers =
+        std::max<std::size_t>(std::thread::hardware_concurrency(), 2) - 1;
+    auto locked  = hal::memberwise::seqlocked<Quote>{};
+    auto guarded = Guarded{};
+
+    BENCHMARK("hal")
+    {
+        return contend(
+            readers, [&] { return locked.load(); },
+            [&](Quote const& q) { locked.store(q); });
+    };
+    BENCHMARK("handwritten")
+    {
+        return contend(
+            readers,
+            [&] {
+                auto const lock = std::shared_lock{guarded.mutex};
+                return guarded.quote;
+            },
+            [&](Quote const& q) {
+                auto const lock = std::unique_lock{guarded.mutex};
+                guarded.quote   = q;
+            });
+    };
+}
+
+namespace {
+
+struct Stats {
+    std::uint64_t requests;
+    std::uint64_t bytes;
+    std::uint64_t max_latency;
+};
+
+/// The per-field atomics that "handwritten" threads share.
+struct Atomic_stats {
+    std::atomic<std::uint64_t> requests{0};
+    std::atomic<std::uint64_t> bytes{0};
+    std::atomic<std::uint64_t> max_latency{0};
+};
+
+constexpr auto updates = std::size_t{100'000};
+
+/// Runs \p update(i) \p updates times on each of a thread per core.
+template <typename Update>
+void on_each_core(Update update)
+{
+    auto threads = std::vector<std::thread>{};
+    auto const count =
+        std::max<std::size_t>(std::thread::hardware_concurrency(), 2);
+    for (auto t = std::size_t{0}; t < count; ++t) {
+        threads.emplace_back([&] {
+            for (auto i = std::size_t{0}; i < updates; ++i)
+                update(i);
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+}
+
+}  // namespace
+
+// Every thread records requests into shared statistics. "hal" updates the
+// thread's own shard of a hal::sharded, "handwritten" does an atomic read
+// modify write per field, on cache lines every thread writes.
+
+TEST_CASE("concurrent: 100k stats updates per core", "[bench]")
+{
+    auto sharded = hal::sharded<Stats>{};
+    auto shared  = Atomic_stats{};
+
+    BENCHMARK("hal")
+    {
+        on_each_core([&](std::size_t i) {
+            sharded.update([&](Stats& s) {
+                ++s.requests;
+                s.bytes += i % 1500;
+                s.max_latency = std::max<std::uint64_t>(s.max_latency, i);
+            });
+        });
+        return sharded
+            .snapshot(hal::merge::sum{}, hal::merge::sum{}, hal::merge::max{})
+            .requests;
+    };
+    BENCHMARK("handwritten")
+    {
+        on_each_core([&](std::size_t i) {
+            shared.requests.fetch_add(1, std::memory_order_relaxed);
+            shared.bytes.fetch_add(i % 1500, std::memory_order_relaxed);
+            auto max = shared.max_latency.load(std::memory_order_relaxed);
+            while (max < i && !shared.max_latency.compare_exchange_weak(
+                                  max, i, std::memory_order_relaxed)) {
+            }
+        });
+        return shared.requests.load();
+    };
+}
@@ -0,0 +1,118 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+#include "bench_data.hpp"
+
+namespace {
+
+struct Tick {
+    std::uint32_t id;
+    double price;
+    std::array<std::int16_t, 3> sizes;
+};
+
+/// Owns a heap allocated payload, so not trivially copyable.
+struct Owner {
+    std::unique_ptr<int> payload;
+    std::uint64_t id;
+    double weight;
+};
+
+constexpr auto count = std::size_t{1'000'000};
+
+/// Uninitialized storage for \p n records of type \p T.
+template <typename T>
+struct Storage {
+    explicit Storage(std::size_t n)
+        : bytes{static_cast<T*>(::operator new(n * sizeof(T)))}
+    {
+    }
+    ~Storage() { ::operator delete(bytes); }
+    T* bytes;
+};
+
+}  // namespace
+
+template <>
+struct hal::memberwise::is_trivially_relocatable<Owner> : std::true_type {
+};
+
+// "hal" uses the memberwise algorithms, "handwritten" the loops they
+// replace.
+
+TEST_CASE("copy: 1M ticks between buffers", "[bench]")
+{
+    auto const from = std::vector<Tick>(count, Tick{1, 2., {3, 4, 5}});
+    auto to         = std::vector<Tick>(count);
+
+    BENCHMARK("hal")
+    {
+        hal::memberwise::copy(from, to);
+        return to.back().id;
+    };
+    BENCHMARK("handwritten")
+    {
+        for (auto i = std::size_t{0}; i < count; ++i) {
+            to[i].id    = from[i].id;
+            to[i].price = from[i].price;
+            to[i].sizes = from[i].sizes;
+        }
+        return to.back().id;
+    };
+}
+
+TEST_CASE("copy: reset 1M ticks", "[bench]")
+{
+    auto ticks = std::vector<Tick>(count, Tick{1, 2., {3, 4, 5}});
+
+    BENCHMARK("hal")
+    {
+        hal::memberwise::reset(ticks);
+        return ticks.back().id;
+    };
+    BENCHMARK("handwritten")
+    {
+        for (auto& tick : ticks) {
+            tick.id    = 0;
+            tick.price = 0.;
+            tick.sizes = {};
+        }
+        return ticks.back().id;
+    };
+}
+
+TEST_CASE("copy: relocate 1M owners to new storage", "[bench]")
+{
+    // Relocates back and forth between two buffers, as a growing container
+    // would into each new allocation.
+    auto first  = Storage<Owner>{count};
+    auto second = Storage<Owner>{count};
+    for (auto i = std::size_t{0}; i < count; ++i)
+        ::new (static_cast<void*>(first.bytes + i)) Owner{nullptr, i, 1.};
+    auto* from = first.bytes;
+    auto* to   = second.bytes;
+
+    BENCHMARK("hal")
+    {
+        hal::memberwise::relocate(std::span{from, count}, to);
+        std::swap(from, to);
+        return from[count - 1].id;
+    };
+    BENCHMARK("handwritten")
+    {
+        for (auto i = std::size_t{0}; i < count; ++i) {
+            ::new (static_cast<void*>(to + i)) Owner{std::move(from[i])};
+            from[i].~Owner();
+        }
+        std::swap(from, to);
+        return from[count - 1].id;
+    };
+    std::destroy_n(from, count);
+}
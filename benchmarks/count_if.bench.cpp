@@ -0,0 +1,73 @@
+#include <cstddef>
+#include <string>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+#include "bench_data.hpp"
+
+using Catch::Benchmark::keep_memory;
+
+namespace {
+
+/// Hand unrolled count.
+template <typename T, typename Predicate>
+auto count_if_8(T const& x, Predicate p) -> std::size_t
+{
+    return std::size_t{0} + (p(x[0]) ? 1 : 0) + (p(x[1]) ? 1 : 0) +
+           (p(x[2]) ? 1 : 0) + (p(x[3]) ? 1 : 0) + (p(x[4]) ? 1 : 0) +
+           (p(x[5]) ? 1 : 0) + (p(x[6]) ? 1 : 0) + (p(x[7]) ? 1 : 0);
+}
+
+}  // namespace
+
+TEST_CASE("count_if: scalar", "[bench]")
+{
+    auto s          = bench::scalars();
+    auto const pred = [](long x) { return x > 50; };
+
+    BENCHMARK("hal")
+    {
+        keep_memory(&s);
+        return hal::count_if(pred, HAL_BENCH_PACK8(s));
+    };
+    BENCHMARK("handwritten")
+    {
+        keep_memory(&s);
+        return count_if_8(s, pred);
+    };
+}
+
+TEST_CASE("count_if: string", "[bench]")
+{
+    auto s          = bench::strings();
+    auto const pred = [](std::string const& x) { return x.size() > 20; };
+
+    BENCHMARK("hal")
+    {
+        keep_memory(&s);
+        return hal::count_if(pred, HAL_BENCH_PACK8(s));
+    };
+    BENCHMARK("handwritten")
+    {
+        keep_memory(&s);
+        return count_if_8(s, pred);
+    };
+}
+
+TEST_CASE("count_if: heavy", "[bench]")
+{
+    auto h          = bench::heavies();
+    auto const pred = [](bench::Heavy const& x) { return x.tag == "high"; };
+
+    BENCHMARK("hal")
+    {
+        keep_memory(&h);
+        return hal::count_if(pred, HAL_BENCH_PACK8(h));
+    };
+    BENCHMARK("handwritten")
+    {
+        keep_memory(&h);
+        return count_if_8(h, pred);
+    };
+}
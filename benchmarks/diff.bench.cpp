@@ -0,0 +1,112 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+#include "bench_data.hpp"
+
+namespace {
+
+struct Position {
+    std::uint32_t account;
+    std::uint16_t venue;
+    std::uint8_t status;
+    std::uint8_t flags;
+    std::int64_t quantity;
+    double average_price;
+    std::int64_t realized;
+};
+
+constexpr auto count = std::size_t{1'000'000};
+
+/// Two snapshots of the positions, with one in a hundred changed.
+auto snapshots() -> std::array<std::vector<Position>, 2> const&
+{
+    static auto const result = [] {
+        auto value    = std::uniform_int_distribution<std::uint32_t>{};
+        auto previous = std::vector<Position>(count);
+        for (auto i = std::size_t{0}; i < count; ++i) {
+            previous[i] = Position{static_cast<std::uint32_t>(i), 1, 0, 0,
+                                   value(bench::rng()), 10., 0};
+        }
+        auto next = previous;
+        for (auto i = std::size_t{0}; i < count / 100; ++i) {
+            auto& position = next[value(bench::rng()) % count];
+            position.quantity += 1;
+            position.realized += 5;
+        }
+        return std::array{previous, next};
+    }();
+    return result;
+}
+
+}  // namespace
+
+// "hal" compares blocks of rows with memcmp, then the members of blocks that
+// differ, "handwritten" compares each member of each row.
+
+TEST_CASE("diff: 1M positions, 1% changed", "[bench]")
+{
+    auto const& [previous, next] = snapshots();
+    auto masks = std::vector<hal::memberwise::diff_mask_t<Position>>(count);
+
+    BENCHMARK("hal")
+    {
+        return hal::memberwise::diff(previous, next, masks);
+    };
+    BENCHMARK("handwritten")
+    {
+        auto changed = std::size_t{0};
+        for (auto i = std::size_t{0}; i < count; ++i) {
+            auto const& a = previous[i];
+            auto const& b = next[i];
+            masks[i] = static_cast<std::uint8_t>(
+                (a.account != b.account) | (a.venue != b.venue) << 1 |
+                (a.status != b.status) << 2 | (a.flags != b.flags) << 3 |
+                (a.quantity != b.quantity) << 4 |
+                (a.average_price != b.average_price) << 5 |
+                (a.realized != b.realized) << 6);
+            changed += masks[i] != 0;
+        }
+        return changed;
+    };
+}
+
+TEST_CASE("diff: encode 1M position updates", "[bench]")
+{
+    // Encodes the changed members of every changed row, against sending the
+    // whole row, and counts the bytes.
+    auto const& [previous, next] = snapshots();
+    auto masks = std::vector<hal::memberwise::diff_mask_t<Position>>(count);
+    hal::memberwise::diff(previous, next, masks);
+    auto out = std::vector<std::byte>(
+        count * hal::memberwise::max_delta_size_v<Position>);
+
+    BENCHMARK("hal")
+    {
+        auto size = std::size_t{0};
+        for (auto i = std::size_t{0}; i < count; ++i) {
+            if (masks[i] != 0) {
+                size += hal::memberwise::encode_delta(
+                    masks[i], next[i], std::span{out}.subspan(size));
+            }
+        }
+        return size;
+    };
+    BENCHMARK("handwritten")
+    {
+        auto size = std::size_t{0};
+        for (auto i = std::size_t{0}; i < count; ++i) {
+            if (masks[i] != 0) {
+                hal::memberwise::serialize(next[i],
+                                           std::span{out}.subspan(size));
+                size += hal::memberwise::serialized_size_v<Position>;
+            }
+        }
+        return size;
+    };
+}
@@ -0,0 +1,79 @@
+#include <cstddef>
+#include <string>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+#include "bench_data.hpp"
+
+using Catch::Benchmark::keep_memory;
+
+namespace {
+
+/// Hand unrolled search, stops at the first match.
+template <typename T, typename Predicate>
+auto find_if_8(T const& x, Predicate p) -> std::size_t
+{
+    if (p(x[0])) return 0;
+    if (p(x[1])) return 1;
+    if (p(x[2])) return 2;
+    if (p(x[3])) return 3;
+    if (p(x[4])) return 4;
+    if (p(x[5])) return 5;
+    if (p(x[6])) return 6;
+    if (p(x[7])) return 7;
+    return 8;
+}
+
+}  // namespace
+
+TEST_CASE("find_if: scalar", "[bench]")
+{
+    auto s          = bench::scalars();
+    auto const pred = [](long x) { return x > 90; };
+
+    BENCHMARK("hal")
+    {
+        keep_memory(&s);
+        return hal::find_if(pred, HAL_BENCH_PACK8(s));
+    };
+    BENCHMARK("handwritten")
+    {
+        keep_memory(&s);
+        return find_if_8(s, pred);
+    };
+}
+
+TEST_CASE("find_if: string", "[bench]")
+{
+    auto s          = bench::strings();
+    auto const pred = [](std::string const& x) { return x == "needle"; };
+
+    BENCHMARK("hal")
+    {
+        keep_memory(&s);
+        return hal::find_if(pred, HAL_BENCH_PACK8(s));
+    };
+    BENCHMARK("handwritten")
+    {
+        keep_memory(&s);
+        return find_if_8(s, pred);
+    };
+}
+
+TEST_CASE("find_if: heavy", "[bench]")
+{
+    auto h          = bench::heavies();
+    auto const pred = [](bench::Heavy const& x) { return x.values[9] > 0.9; };
+
+    BENCHMARK("hal")
+    {
+        keep_memory(&h);
+        return hal::find_if(pred, HAL_BENCH_PACK8(h));
+    };
+    BENCHMARK("handwritten")
+    {
+        keep_memory(&h);
+        return find_if_8(h, pred);
+    };
+}
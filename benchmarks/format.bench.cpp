@@ -0,0 +1,98 @@
+#include <array>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <hal/format.hpp>
+#include "bench_data.hpp"
+
+namespace {
+
+struct Trade {
+    std::array<char, 8> symbol;
+    std::int64_t time;
+    double price;
+    std::uint32_t size;
+    std::uint8_t side;
+};
+
+constexpr auto count = std::size_t{100'000};
+
+auto trades() -> std::vector<Trade> const&
+{
+    static auto const result = [] {
+        auto price  = std::uniform_real_distribution<double>{10., 500.};
+        auto size   = std::uniform_int_distribution<std::uint32_t>{1, 10'000};
+        auto trades = std::vector<Trade>(count);
+        for (auto i = std::size_t{0}; i < count; ++i) {
+            trades[i] = Trade{{'S', 'Y', 'M', char('A' + i % 26)},
+                              static_cast<std::int64_t>(1'700'000'000'000 + i),
+                              price(bench::rng()), size(bench::rng()),
+                              static_cast<std::uint8_t>(i % 2)};
+        }
+        return trades;
+    }();
+    return result;
+}
+
+}  // namespace
+
+// Formats each trade as a log line into one output buffer. "hal" writes into
+// a stack buffer of the compile time size, "handwritten" streams each member
+// into a std::ostringstream, "snprintf" stands in for std::format, which GCC
+// 12 doesn't ship.
+
+TEST_CASE("format: 100k trades as log lines", "[bench]")
+{
+    auto const& records = trades();
+    auto out            = std::vector<char>(count * 80);
+
+    BENCHMARK("hal")
+    {
+        auto* end = out.data();
+        for (auto const& trade : records) {
+            auto line =
+                std::array<char,
+                           hal::memberwise::max_formatted_size_v<Trade> + 1>{};
+            auto* const last = hal::memberwise::format_to(line.data(), trade);
+            *last            = '\n';
+            auto const size  = static_cast<std::size_t>(last + 1 - line.data());
+            std::memcpy(end, line.data(), size);
+            end += size;
+        }
+        return end - out.data();
+    };
+    BENCHMARK("handwritten")
+    {
+        auto* end = out.data();
+        for (auto const& trade : records) {
+            auto stream = std::ostringstream{};
+            stream.precision(17);
+            stream << trade.symbol.data() << ' ' << trade.time << ' '
+                   << trade.price << ' ' << trade.size << ' '
+                   << int{trade.side} << '\n';
+            auto const line = stream.str();
+            std::memcpy(end, line.data(), line.size());
+            end += line.size();
+        }
+        return end - out.data();
+    };
+    BENCHMARK("snprintf")
+    {
+        auto* end = out.data();
+        for (auto const& trade : records) {
+            end += std::snprintf(end, 80, "%.8s %" PRId64 " %.17g %" PRIu32
+                                          " %d\n",
+                                 trade.symbol.data(), trade.time, trade.price,
+                                 trade.size, int{trade.side});
+        }
+        return end - out.data();
+    };
+}
@@ -0,0 +1,120 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <hal/hash.hpp>
+#include "bench_data.hpp"
+
+namespace {
+
+struct Key {
+    std::uint32_t account;
+    std::uint16_t venue;
+    std::uint16_t book;
+    std::uint64_t order;
+};
+
+constexpr auto operator==(Key const& a, Key const& b) -> bool
+{
+    return a.account == b.account && a.venue == b.venue && a.book == b.book &&
+           a.order == b.order;
+}
+
+/// The usual hand written hash, std::hash per member and boost's combine.
+struct Handwritten_hash {
+    static void combine(std::size_t& seed, std::size_t value)
+    {
+        seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+
+    auto operator()(Key const& key) const -> std::size_t
+    {
+        auto seed = std::size_t{0};
+        combine(seed, std::hash<std::uint32_t>{}(key.account));
+        combine(seed, std::hash<std::uint16_t>{}(key.venue));
+        combine(seed, std::hash<std::uint16_t>{}(key.book));
+        combine(seed, std::hash<std::uint64_t>{}(key.order));
+        return seed;
+    }
+};
+
+constexpr auto count = std::size_t{100'000};
+
+auto keys() -> std::vector<Key> const&
+{
+    static auto const result = [] {
+        auto account = std::uniform_int_distribution<std::uint32_t>{0, 999};
+        auto keys    = std::vector<Key>(count);
+        for (auto i = std::size_t{0}; i < count; ++i) {
+            keys[i] = Key{account(bench::rng()),
+                          static_cast<std::uint16_t>(i % 16),
+                          static_cast<std::uint16_t>(i % 7), i * 4};
+        }
+        return keys;
+    }();
+    return result;
+}
+
+auto payload() -> std::vector<std::byte> const&
+{
+    static auto const result = [] {
+        auto byte  = std::uniform_int_distribution<int>{0, 255};
+        auto bytes = std::vector<std::byte>(1 << 20);
+        for (auto& b : bytes)
+            b = static_cast<std::byte>(byte(bench::rng()));
+        return bytes;
+    }();
+    return result;
+}
+
+/// Fills \p map with keys() and looks each of them up again.
+template <typename Map>
+auto fill_and_find(Map& map) -> std::size_t
+{
+    map.clear();
+    auto const& all = keys();
+    for (auto i = std::size_t{0}; i < count; ++i)
+        map.emplace(all[i], i);
+    auto sum = std::size_t{0};
+    for (auto const& key : all)
+        sum += map.find(key)->second;
+    return sum;
+}
+
+}  // namespace
+
+TEST_CASE("hash: 100k struct keys in an unordered_map", "[bench]")
+{
+    auto hal_map = std::unordered_map<Key, std::size_t,
+                                      hal::memberwise::hasher>{};
+    auto handwritten_map =
+        std::unordered_map<Key, std::size_t, Handwritten_hash>{};
+    hal_map.reserve(count);
+    handwritten_map.reserve(count);
+
+    BENCHMARK("hal") { return fill_and_find(hal_map); };
+    BENCHMARK("handwritten") { return fill_and_find(handwritten_map); };
+}
+
+TEST_CASE("hash: crc32c of 1 MiB", "[bench]")
+{
+    auto const& bytes = payload();
+
+    BENCHMARK("hal") { return hal::crc32c(bytes); };
+    BENCHMARK("handwritten")
+    {
+        // A byte at a time with one table.
+        auto const& table = hal::detail::crc32c_tables[0];
+        auto crc          = ~std::uint32_t{0};
+        for (auto byte : bytes)
+            crc = crc >> 8 ^
+                  table[(crc ^ std::to_integer<std::uint32_t>(byte)) & 0xFF];
+        return ~crc;
+    };
+}
@@ -0,0 +1,78 @@
+#include <functional>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+#include "bench_data.hpp"
+
+using Catch::Benchmark::keep_memory;
+
+TEST_CASE("memberwise::reduce: aggregate", "[bench]")
+{
+    auto t = bench::tick();
+
+    BENCHMARK("hal")
+    {
+        keep_memory(&t);
+        return hal::memberwise::reduce(0L, std::plus<>{}, t);
+    };
+    BENCHMARK("handwritten")
+    {
+        keep_memory(&t);
+        return 0L + t.bid + t.ask + t.bid_size + t.ask_size + t.volume +
+               t.trades + t.high + t.low;
+    };
+}
+
+TEST_CASE("memberwise::for_each: aggregate", "[bench]")
+{
+    auto const original = bench::tick();
+
+    BENCHMARK("hal")
+    {
+        auto t = original;
+        keep_memory(&t);
+        hal::memberwise::for_each([](long& x) { x *= 3; }, t);
+        return t;
+    };
+    BENCHMARK("handwritten")
+    {
+        auto t = original;
+        keep_memory(&t);
+        t.bid *= 3;
+        t.ask *= 3;
+        t.bid_size *= 3;
+        t.ask_size *= 3;
+        t.volume *= 3;
+        t.trades *= 3;
+        t.high *= 3;
+        t.low *= 3;
+        return t;
+    };
+}
+
+TEST_CASE("memberwise::partial_sum: aggregate", "[bench]")
+{
+    auto const original = bench::tick();
+
+    BENCHMARK("hal")
+    {
+        auto t = original;
+        keep_memory(&t);
+        hal::memberwise::partial_sum(t);
+        return t;
+    };
+    BENCHMARK("handwritten")
+    {
+        auto t = original;
+        keep_memory(&t);
+        t.ask += t.bid;
+        t.bid_size += t.ask;
+        t.ask_size += t.bid_size;
+        t.volume += t.ask_size;
+        t.trades += t.volume;
+        t.high += t.trades;
+        t.low += t.high;
+        return t;
+    };
+}
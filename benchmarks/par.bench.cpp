@@ -0,0 +1,71 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+#include <hal/par.hpp>
+#include "bench_data.hpp"
+
+using Catch::Benchmark::keep_memory;
+
+namespace {
+
+/// Runs an xorshift generator for \p Steps steps, seeded with \p seed.
+template <std::size_t Steps>
+auto churn(long seed) -> std::uint64_t
+{
+    auto x = static_cast<std::uint64_t>(seed) + 1;
+    for (auto i = std::size_t{0}; i < Steps; ++i) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+    }
+    return x;
+}
+
+/// Compares par::transform_reduce over 8 elements with a serial loop, and with
+/// hal::transform_reduce, for a transform of \p Steps steps.
+template <std::size_t Steps>
+void churn_eight()
+{
+    auto a = bench::scalars();
+
+    BENCHMARK("hal")
+    {
+        keep_memory(&a);
+        return hal::par::transform_reduce(std::uint64_t{0}, churn<Steps>,
+                                          std::bit_xor<>{}, HAL_BENCH_PACK8(a));
+    };
+    BENCHMARK("handwritten")
+    {
+        keep_memory(&a);
+        auto result = std::uint64_t{0};
+        for (auto x : a)
+            result ^= churn<Steps>(x);
+        return result;
+    };
+    BENCHMARK("sequential")
+    {
+        keep_memory(&a);
+        return hal::transform_reduce(std::uint64_t{0}, churn<Steps>,
+                                     std::bit_xor<>{}, HAL_BENCH_PACK8(a));
+    };
+}
+
+}  // namespace
+
+// Threads only pay off once each element is expensive, the small case shows
+// the cost of handing tasks to the pool.
+
+TEST_CASE("par: 8 elements, 100 steps each", "[bench]")
+{
+    churn_eight<100>();
+}
+
+TEST_CASE("par: 8 elements, 100000 steps each", "[bench]")
+{
+    churn_eight<100000>();
+}
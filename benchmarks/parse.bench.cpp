@@ -0,0 +1,90 @@
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <unistd.h>
+
+#include <catch2/catch.hpp>
+
+#include <hal/parse.hpp>
+#include "bench_data.hpp"
+
+namespace {
+
+struct Trade {
+    std::int64_t time;
+    std::string_view symbol;
+    double price;
+    std::uint32_t size;
+    std::uint8_t side;
+};
+
+/// The same record, owning its symbol, as a line by line reader builds it.
+struct Owned_trade {
+    std::int64_t time;
+    std::string symbol;
+    double price;
+    std::uint32_t size;
+    std::uint8_t side;
+};
+
+constexpr auto count = std::size_t{1'000'000};
+
+auto write_file() -> std::filesystem::path
+{
+    auto const path = std::filesystem::temp_directory_path() /
+                      ("hal_bench_trades_" + std::to_string(::getpid()));
+    auto price = std::uniform_real_distribution<double>{10., 500.};
+    auto size  = std::uniform_int_distribution<std::uint32_t>{1, 10'000};
+    auto out   = std::ofstream{path};
+    out << "time,symbol,price,size,side\n";
+    for (auto i = std::size_t{0}; i < count; ++i) {
+        out << 1'700'000'000'000 + i << ",SYM" << i % 500 << ","
+            << price(bench::rng()) << "," << size(bench::rng()) << ","
+            << i % 2 << "\n";
+    }
+    return path;
+}
+
+}  // namespace
+
+// "hal" parses the mapped file with std::from_chars, in parallel chunks,
+// "handwritten" reads lines with std::getline, splits them into a
+// std::string per cell, and converts each with std::stoll and friends.
+
+TEST_CASE("parse: 1M CSV lines", "[bench]")
+{
+    auto const path   = write_file();
+    auto const trades = hal::delimited_file<Trade>{path, ',', 1};
+
+    BENCHMARK("hal")
+    {
+        return trades.read().size();
+    };
+    BENCHMARK("handwritten")
+    {
+        auto records = std::vector<Owned_trade>{};
+        auto file    = std::ifstream{path};
+        auto line    = std::string{};
+        std::getline(file, line);
+        while (std::getline(file, line)) {
+            auto cells  = std::vector<std::string>{};
+            auto stream = std::istringstream{line};
+            for (auto cell = std::string{}; std::getline(stream, cell, ',');)
+                cells.push_back(cell);
+            records.push_back(Owned_trade{
+                std::stoll(cells[0]), cells[1], std::stod(cells[2]),
+                static_cast<std::uint32_t>(std::stoul(cells[3])),
+                static_cast<std::uint8_t>(std::stoi(cells[4]))});
+        }
+        return records.size();
+    };
+
+    std::filesystem::remove(path);
+}
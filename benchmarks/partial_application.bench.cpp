@@ -0,0 +1,93 @@
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+#include "bench_data.hpp"
+
+using Catch::Benchmark::keep_memory;
+
+namespace {
+
+struct Tally {
+    long copies = 0;
+    long moves  = 0;
+};
+
+/// Predicate with a large capture that records each copy and move of itself.
+class Counted_pred {
+   public:
+    Counted_pred(Tally& t, std::string s) : tally_{&t}, s_{std::move(s)} {}
+
+    Counted_pred(Counted_pred const& x) : tally_{x.tally_}, s_{x.s_}
+    {
+        ++tally_->copies;
+    }
+
+    Counted_pred(Counted_pred&& x) noexcept
+        : tally_{x.tally_}, s_{std::move(x.s_)}
+    {
+        ++tally_->moves;
+    }
+
+   public:
+    auto operator()(std::string const& x) const -> bool
+    {
+        return s_.find(x.front()) != std::string::npos;
+    }
+
+   private:
+    Tally* tally_;
+    std::string s_;
+};
+
+}  // namespace
+
+TEST_CASE("partial application: large capture", "[bench]")
+{
+    auto s        = bench::strings();
+    auto tally    = Tally{};
+    auto captured = hal::count_if(Counted_pred{tally, std::string(4'096, 'q')});
+    auto direct   = Counted_pred{tally, std::string(4'096, 'q')};
+    tally         = Tally{};
+
+    auto calls = 0L;
+    BENCHMARK("hal")
+    {
+        keep_memory(&s);
+        ++calls;
+        return captured(HAL_BENCH_PACK8(s));
+    };
+    // The captured predicate should never be copied or moved by a call.
+    CHECK(calls > 0);
+    CHECK(tally.copies == 0);
+    CHECK(tally.moves == 0);
+
+    BENCHMARK("handwritten")
+    {
+        keep_memory(&s);
+        return std::size_t{0} + direct(s[0]) + direct(s[1]) + direct(s[2]) +
+               direct(s[3]) + direct(s[4]) + direct(s[5]) + direct(s[6]) +
+               direct(s[7]);
+    };
+}
+
+TEST_CASE("partial application: string init", "[bench]")
+{
+    auto s            = bench::strings();
+    auto const prefix = std::string(256, 'p');
+    auto const concat = hal::reduce(prefix, std::plus<>{});
+
+    BENCHMARK("hal")
+    {
+        keep_memory(&s);
+        return concat(HAL_BENCH_PACK8(s));
+    };
+    BENCHMARK("handwritten")
+    {
+        keep_memory(&s);
+        return prefix + s[0] + s[1] + s[2] + s[3] + s[4] + s[5] + s[6] + s[7];
+    };
+}
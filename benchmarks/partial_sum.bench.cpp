@@ -0,0 +1,32 @@
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+#include "bench_data.hpp"
+
+using Catch::Benchmark::keep_memory;
+
+TEST_CASE("partial_sum: scalar", "[bench]")
+{
+    auto const s = bench::scalars();
+
+    BENCHMARK("hal")
+    {
+        auto x = s;
+        keep_memory(&x);
+        hal::partial_sum(HAL_BENCH_PACK8(x));
+        return x;
+    };
+    BENCHMARK("handwritten")
+    {
+        auto x = s;
+        keep_memory(&x);
+        x[1] += x[0];
+        x[2] += x[1];
+        x[3] += x[2];
+        x[4] += x[3];
+        x[5] += x[4];
+        x[6] += x[5];
+        x[7] += x[6];
+        return x;
+    };
+}
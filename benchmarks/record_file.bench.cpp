@@ -0,0 +1,121 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+#include <hal/record_file.hpp>
+#include "bench_data.hpp"
+
+namespace {
+
+/// Has padding in memory, so each record is converted member by member.
+struct Tick {
+    std::uint8_t side;
+    double price;
+    std::int32_t volume;
+};
+
+/// Laid out in memory the same way it is serialized.
+struct Quote {
+    double bid;
+    double ask;
+};
+
+constexpr auto count = std::size_t{1'000'000};
+
+template <typename T, typename Make>
+auto write_file(char const* name, Make make) -> std::filesystem::path
+{
+    constexpr auto size = hal::memberwise::serialized_size_v<T>;
+    auto const path     = std::filesystem::temp_directory_path() /
+                          (name + std::to_string(::getpid()));
+    auto bytes = std::vector<std::byte>(count * size);
+    for (auto i = std::size_t{0}; i < count; ++i)
+        hal::memberwise::serialize(make(), std::span{bytes}.subspan(i * size));
+    auto file = std::ofstream{path, std::ios::binary};
+    file.write(reinterpret_cast<char const*>(bytes.data()),
+               static_cast<std::streamsize>(bytes.size()));
+    return path;
+}
+
+/// Reads the whole file at \p path with an ifstream.
+auto read_file(std::filesystem::path const& path) -> std::vector<std::byte>
+{
+    auto bytes = std::vector<std::byte>(std::filesystem::file_size(path));
+    auto file  = std::ifstream{path, std::ios::binary};
+    file.read(reinterpret_cast<char*>(bytes.data()),
+              static_cast<std::streamsize>(bytes.size()));
+    return bytes;
+}
+
+}  // namespace
+
+// "handwritten" reads the file into a buffer with an ifstream each time, and
+// copies out each member, "hal" reads the mapped file in place.
+
+TEST_CASE("record_file: sum 1M padded records", "[bench]")
+{
+    auto price      = std::uniform_real_distribution<double>{99., 101.};
+    auto const path = write_file<Tick>("hal_bench_ticks_", [&] {
+        return Tick{1, price(bench::rng()), 100};
+    });
+    auto const ticks = hal::record_file<Tick>{path};
+
+    BENCHMARK("hal")
+    {
+        auto total = 0.;
+        for (auto const tick : ticks)
+            total += tick.price;
+        return total;
+    };
+    BENCHMARK("handwritten")
+    {
+        auto const bytes = read_file(path);
+        auto total       = 0.;
+        for (auto i = std::size_t{0}; i < bytes.size(); i += 13) {
+            auto price = 0.;
+            std::memcpy(&price, bytes.data() + i + 1, sizeof(price));
+            total += price;
+        }
+        return total;
+    };
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("record_file: sum 1M unpadded records", "[bench]")
+{
+    auto price      = std::uniform_real_distribution<double>{99., 101.};
+    auto const path = write_file<Quote>("hal_bench_quotes_", [&] {
+        return Quote{price(bench::rng()), price(bench::rng())};
+    });
+    auto const quotes = hal::record_file<Quote>{path};
+
+    BENCHMARK("hal")
+    {
+        auto total = 0.;
+        for (auto const& quote : quotes.records())
+            total += quote.ask - quote.bid;
+        return total;
+    };
+    BENCHMARK("handwritten")
+    {
+        auto const bytes = read_file(path);
+        auto records     = std::vector<Quote>(bytes.size() / sizeof(Quote));
+        std::memcpy(records.data(), bytes.data(), bytes.size());
+        auto total = 0.;
+        for (auto const& quote : records)
+            total += quote.ask - quote.bid;
+        return total;
+    };
+    std::filesystem::remove(path);
+}
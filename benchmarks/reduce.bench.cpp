@@ -0,0 +1,66 @@
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+#include "bench_data.hpp"
+
+using Catch::Benchmark::keep_memory;
+
+TEST_CASE("reduce: scalar", "[bench]")
+{
+    auto s = bench::scalars();
+
+    BENCHMARK("hal")
+    {
+        keep_memory(&s);
+        return hal::reduce(0L, std::plus<>{}, HAL_BENCH_PACK8(s));
+    };
+    BENCHMARK("handwritten")
+    {
+        keep_memory(&s);
+        return 0L + s[0] + s[1] + s[2] + s[3] + s[4] + s[5] + s[6] + s[7];
+    };
+}
+
+TEST_CASE("reduce: string", "[bench]")
+{
+    auto s = bench::strings();
+
+    BENCHMARK("hal")
+    {
+        keep_memory(&s);
+        return hal::reduce(std::string{}, std::plus<>{}, HAL_BENCH_PACK8(s));
+    };
+    BENCHMARK("handwritten")
+    {
+        keep_memory(&s);
+        return std::string{} + s[0] + s[1] + s[2] + s[3] + s[4] + s[5] + s[6] +
+               s[7];
+    };
+}
+
+TEST_CASE("reduce: heavy", "[bench]")
+{
+    auto h = bench::heavies();
+
+    BENCHMARK("hal")
+    {
+        keep_memory(&h);
+        return hal::reduce(
+            0.,
+            [](double sum, bench::Heavy const& x) {
+                return sum + x.values[7];
+            },
+            HAL_BENCH_PACK8(h));
+    };
+    BENCHMARK("handwritten")
+    {
+        keep_memory(&h);
+        return 0. + h[0].values[7] + h[1].values[7] + h[2].values[7] +
+               h[3].values[7] + h[4].values[7] + h[5].values[7] +
+               h[6].values[7] + h[7].values[7];
+    };
+}
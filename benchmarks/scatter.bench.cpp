@@ -0,0 +1,169 @@
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+#include "bench_data.hpp"
+
+namespace {
+
+struct Point {
+    float x, y, z, w;
+};
+
+struct Body {
+    double x, y, z;
+    double vx, vy, vz;
+    float mass;
+    int id;
+};
+
+constexpr auto count = std::size_t{1'000'000};
+
+auto points() -> std::vector<Point> const&
+{
+    static auto const result = [] {
+        auto value  = std::uniform_real_distribution<float>{-1.f, 1.f};
+        auto points = std::vector<Point>(count);
+        for (auto& p : points) {
+            p = Point{value(bench::rng()), value(bench::rng()),
+                      value(bench::rng()), value(bench::rng())};
+        }
+        return points;
+    }();
+    return result;
+}
+
+auto bodies() -> std::vector<Body> const&
+{
+    static auto const result = [] {
+        auto value  = std::uniform_real_distribution<double>{-1., 1.};
+        auto bodies = std::vector<Body>(count);
+        for (auto i = std::size_t{0}; i < count; ++i) {
+            bodies[i] = Body{value(bench::rng()), value(bench::rng()),
+                             value(bench::rng()), value(bench::rng()),
+                             value(bench::rng()), value(bench::rng()),
+                             static_cast<float>(value(bench::rng())),
+                             static_cast<int>(i)};
+        }
+        return bodies;
+    }();
+    return result;
+}
+
+}  // namespace
+
+// Each benchmark reads and writes count * sizeof(record) bytes, 16 MB for
+// points and 56 MB for bodies, so GB/s is 2 * MB / time in ms / 1000.
+
+TEST_CASE("scatter: 1M points into columns", "[bench]")
+{
+    auto const& records = points();
+    auto x              = std::vector<float>(count);
+    auto y              = std::vector<float>(count);
+    auto z              = std::vector<float>(count);
+    auto w              = std::vector<float>(count);
+
+    BENCHMARK("hal")
+    {
+        hal::memberwise::scatter(records, x, y, z, w);
+        return x.back();
+    };
+    BENCHMARK("handwritten")
+    {
+        for (auto i = std::size_t{0}; i < records.size(); ++i) {
+            x[i] = records[i].x;
+            y[i] = records[i].y;
+            z[i] = records[i].z;
+            w[i] = records[i].w;
+        }
+        return x.back();
+    };
+}
+
+TEST_CASE("gather: 1M points from columns", "[bench]")
+{
+    auto const& expected = points();
+    auto x               = std::vector<float>(count);
+    auto y               = std::vector<float>(count);
+    auto z               = std::vector<float>(count);
+    auto w               = std::vector<float>(count);
+    hal::memberwise::scatter(expected, x, y, z, w);
+    auto records = std::vector<Point>(count);
+
+    BENCHMARK("hal")
+    {
+        hal::memberwise::gather(x, y, z, w, records);
+        return records.back().w;
+    };
+    BENCHMARK("handwritten")
+    {
+        for (auto i = std::size_t{0}; i < records.size(); ++i)
+            records[i] = Point{x[i], y[i], z[i], w[i]};
+        return records.back().w;
+    };
+}
+
+TEST_CASE("scatter: 1M bodies into columns", "[bench]")
+{
+    auto const& records = bodies();
+    auto x              = std::vector<double>(count);
+    auto y              = std::vector<double>(count);
+    auto z              = std::vector<double>(count);
+    auto vx             = std::vector<double>(count);
+    auto vy             = std::vector<double>(count);
+    auto vz             = std::vector<double>(count);
+    auto mass           = std::vector<float>(count);
+    auto id             = std::vector<int>(count);
+
+    BENCHMARK("hal")
+    {
+        hal::memberwise::scatter(records, x, y, z, vx, vy, vz, mass, id);
+        return id.back();
+    };
+    BENCHMARK("handwritten")
+    {
+        for (auto i = std::size_t{0}; i < records.size(); ++i) {
+            x[i]    = records[i].x;
+            y[i]    = records[i].y;
+            z[i]    = records[i].z;
+            vx[i]   = records[i].vx;
+            vy[i]   = records[i].vy;
+            vz[i]   = records[i].vz;
+            mass[i] = records[i].mass;
+            id[i]   = records[i].id;
+        }
+        return id.back();
+    };
+}
+
+TEST_CASE("gather: 1M bodies from columns", "[bench]")
+{
+    auto const& expected = bodies();
+    auto x               = std::vector<double>(count);
+    auto y               = std::vector<double>(count);
+    auto z               = std::vector<double>(count);
+    auto vx              = std::vector<double>(count);
+    auto vy              = std::vector<double>(count);
+    auto vz              = std::vector<double>(count);
+    auto mass            = std::vector<float>(count);
+    auto id              = std::vector<int>(count);
+    hal::memberwise::scatter(expected, x, y, z, vx, vy, vz, mass, id);
+    auto records = std::vector<Body>(count);
+
+    BENCHMARK("hal")
+    {
+        hal::memberwise::gather(x, y, z, vx, vy, vz, mass, id, records);
+        return records.back().id;
+    };
+    BENCHMARK("handwritten")
+    {
+        for (auto i = std::size_t{0}; i < records.size(); ++i) {
+            records[i] =
+                Body{x[i], y[i], z[i], vx[i], vy[i], vz[i], mass[i], id[i]};
+        }
+        return records.back().id;
+    };
+}
@@ -0,0 +1,117 @@
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+#include "bench_data.hpp"
+
+using Catch::Benchmark::keep_memory;
+
+namespace {
+
+constexpr auto size = std::size_t{32};
+
+/// Invokes \p f with each element of \p a as a parameter pack.
+template <typename T, typename Fn>
+auto with_pack(std::array<T, size> const& a, Fn&& f) -> decltype(auto)
+{
+    return [&]<std::size_t... I>(std::index_sequence<I...>)->decltype(auto)
+    {
+        return f(a[I]...);
+    }
+    (std::make_index_sequence<size>{});
+}
+
+template <typename T>
+auto values() -> std::array<T, size>
+{
+    auto dist   = std::uniform_int_distribution<int>{0, 99};
+    auto result = std::array<T, size>{};
+    for (auto& x : result)
+        x = static_cast<T>(dist(bench::rng()));
+    return result;
+}
+
+}  // namespace
+
+TEST_CASE("simd: reduce int", "[bench]")
+{
+    auto a = values<int>();
+
+    BENCHMARK("hal")
+    {
+        keep_memory(&a);
+        return with_pack(a, hal::reduce(0, std::plus<>{}));
+    };
+    BENCHMARK("handwritten")
+    {
+        keep_memory(&a);
+        auto sum = 0;
+        for (auto x : a)
+            sum += x;
+        return sum;
+    };
+}
+
+TEST_CASE("simd: transform_reduce int", "[bench]")
+{
+    auto a            = values<int>();
+    auto const square = [](int x) { return x * x; };
+
+    BENCHMARK("hal")
+    {
+        keep_memory(&a);
+        return with_pack(a, hal::transform_reduce(0, square, std::plus<>{}));
+    };
+    BENCHMARK("handwritten")
+    {
+        keep_memory(&a);
+        auto sum = 0;
+        for (auto x : a)
+            sum += square(x);
+        return sum;
+    };
+}
+
+TEST_CASE("simd: count float", "[bench]")
+{
+    auto a       = values<float>();
+    auto const x = a[size / 2];
+
+    BENCHMARK("hal")
+    {
+        keep_memory(&a);
+        return with_pack(a, hal::count(x));
+    };
+    BENCHMARK("handwritten")
+    {
+        keep_memory(&a);
+        auto count = std::size_t{0};
+        for (auto y : a)
+            count += (y == x);
+        return count;
+    };
+}
+
+TEST_CASE("simd: find int", "[bench]")
+{
+    auto a = values<int>();
+    a[29]  = 100;
+
+    BENCHMARK("hal")
+    {
+        keep_memory(&a);
+        return with_pack(a, hal::find(100));
+    };
+    BENCHMARK("handwritten")
+    {
+        keep_memory(&a);
+        auto i = std::size_t{0};
+        while (i < size && a[i] != 100)
+            ++i;
+        return i;
+    };
+}
@@ -0,0 +1,120 @@
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+#include <hal/soa_vector.hpp>
+#include "bench_data.hpp"
+
+namespace {
+
+struct Body {
+    double x, y, z;
+    double vx, vy, vz;
+    float mass;
+    int id;
+};
+
+constexpr auto count = std::size_t{1'000'000};
+
+/// The same random bodies, as a std::vector and as a hal::soa_vector.
+auto bodies() -> std::pair<std::vector<Body>, hal::soa_vector<Body>> const&
+{
+    static auto const result = [] {
+        auto value = std::uniform_real_distribution<double>{-1., 1.};
+        auto pair  = std::pair<std::vector<Body>, hal::soa_vector<Body>>{};
+        pair.second.reserve(count);
+        for (auto i = std::size_t{0}; i < count; ++i) {
+            auto const b =
+                Body{value(bench::rng()), value(bench::rng()),
+                     value(bench::rng()), value(bench::rng()),
+                     value(bench::rng()), value(bench::rng()),
+                     static_cast<float>(value(bench::rng())) + 2.f,
+                     static_cast<int>(i)};
+            pair.first.push_back(b);
+            pair.second.push_back(b);
+        }
+        return pair;
+    }();
+    return result;
+}
+
+constexpr auto sum = [](auto x, auto y) { return x + y; };
+
+}  // namespace
+
+// "handwritten" loops over a std::vector<Body>, "hal" over a soa_vector<Body>.
+
+TEST_CASE("soa_vector: sum one member of 1M records", "[bench]")
+{
+    auto const& [aos, soa] = bodies();
+
+    BENCHMARK("hal")
+    {
+        auto total = 0.f;
+        for (auto mass : soa.column<6>())
+            total += mass;
+        return total;
+    };
+    BENCHMARK("handwritten")
+    {
+        auto total = 0.f;
+        for (auto const& b : aos)
+            total += b.mass;
+        return total;
+    };
+}
+
+TEST_CASE("soa_vector: sum every member of 1M records", "[bench]")
+{
+    auto const& [aos, soa] = bodies();
+
+    BENCHMARK("hal")
+    {
+        return hal::columnwise::reduce(Body{}, sum, soa);
+    };
+    BENCHMARK("handwritten")
+    {
+        auto total = Body{};
+        for (auto const& b : aos) {
+            total.x += b.x;
+            total.y += b.y;
+            total.z += b.z;
+            total.vx += b.vx;
+            total.vy += b.vy;
+            total.vz += b.vz;
+            total.mass += b.mass;
+            total.id += b.id;
+        }
+        return total;
+    };
+}
+
+TEST_CASE("soa_vector: scale positions of 1M records", "[bench]")
+{
+    auto data = bodies();
+    auto& aos = data.first;
+    auto& soa = data.second;
+
+    BENCHMARK("hal")
+    {
+        for (auto& x : soa.column<0>())
+            x *= 0.5;
+        for (auto& y : soa.column<1>())
+            y *= 0.5;
+        for (auto& z : soa.column<2>())
+            z *= 0.5;
+        return soa.column<0>()[0];
+    };
+    BENCHMARK("handwritten")
+    {
+        for (auto& b : aos) {
+            b.x *= 0.5;
+            b.y *= 0.5;
+            b.z *= 0.5;
+        }
+        return aos[0].x;
+    };
+}
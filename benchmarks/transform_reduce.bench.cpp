@@ -0,0 +1,74 @@
+#include <cstddef>
+#include <functional>
+#include <string>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+#include "bench_data.hpp"
+
+using Catch::Benchmark::keep_memory;
+
+TEST_CASE("transform_reduce: scalar", "[bench]")
+{
+    auto s = bench::scalars();
+
+    BENCHMARK("hal")
+    {
+        keep_memory(&s);
+        return hal::transform_reduce(
+            0L, [](long x) { return x * x; }, std::plus<>{},
+            HAL_BENCH_PACK8(s));
+    };
+    BENCHMARK("handwritten")
+    {
+        keep_memory(&s);
+        return 0L + s[0] * s[0] + s[1] * s[1] + s[2] * s[2] + s[3] * s[3] +
+               s[4] * s[4] + s[5] * s[5] + s[6] * s[6] + s[7] * s[7];
+    };
+}
+
+TEST_CASE("transform_reduce: string", "[bench]")
+{
+    auto s = bench::strings();
+
+    BENCHMARK("hal")
+    {
+        keep_memory(&s);
+        return hal::transform_reduce(
+            std::size_t{0}, [](std::string const& x) { return x.size(); },
+            std::plus<>{}, HAL_BENCH_PACK8(s));
+    };
+    BENCHMARK("handwritten")
+    {
+        keep_memory(&s);
+        return std::size_t{0} + s[0].size() + s[1].size() + s[2].size() +
+               s[3].size() + s[4].size() + s[5].size() + s[6].size() +
+               s[7].size();
+    };
+}
+
+TEST_CASE("transform_reduce: heavy", "[bench]")
+{
+    auto h = bench::heavies();
+
+    BENCHMARK("hal")
+    {
+        keep_memory(&h);
+        return hal::transform_reduce(
+            0., [](bench::Heavy const& x) { return x.values[0] * x.values[1]; },
+            std::plus<>{}, HAL_BENCH_PACK8(h));
+    };
+    BENCHMARK("handwritten")
+    {
+        keep_memory(&h);
+        return 0. + h[0].values[0] * h[0].values[1] +
+               h[1].values[0] * h[1].values[1] +
+               h[2].values[0] * h[2].values[1] +
+               h[3].values[0] * h[3].values[1] +
+               h[4].values[0] * h[4].values[1] +
+               h[5].values[0] * h[5].values[1] +
+               h[6].values[0] * h[6].values[1] +
+               h[7].values[0] * h[7].values[1];
+    };
+}
@@ -0,0 +1,80 @@
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <utility>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+#include "bench_data.hpp"
+
+using Catch::Benchmark::keep_memory;
+
+namespace {
+
+/// Invokes \p f with each element of \p a as a parameter pack.
+template <std::size_t N, typename Fn>
+auto with_pack(std::array<double, N> const& a, Fn&& f) -> decltype(auto)
+{
+    return [&]<std::size_t... I>(std::index_sequence<I...>)->decltype(auto)
+    {
+        return f(a[I]...);
+    }
+    (std::make_index_sequence<N>{});
+}
+
+template <std::size_t N>
+auto values() -> std::array<double, N>
+{
+    auto dist   = std::uniform_real_distribution<double>{0., 1.};
+    auto result = std::array<double, N>{};
+    for (auto& x : result)
+        x = dist(bench::rng());
+    return result;
+}
+
+/// Compares a tree_reduce sum of N doubles with a serial sum, and hal::reduce.
+template <std::size_t N>
+void sum_doubles()
+{
+    auto a = values<N>();
+
+    BENCHMARK("hal")
+    {
+        keep_memory(&a);
+        return with_pack(a, hal::tree_reduce(0., std::plus<>{}));
+    };
+    BENCHMARK("handwritten")
+    {
+        keep_memory(&a);
+        auto sum = 0.;
+        for (auto x : a)
+            sum += x;
+        return sum;
+    };
+    BENCHMARK("reduce")
+    {
+        keep_memory(&a);
+        return with_pack(a, hal::reduce(0., std::plus<>{}));
+    };
+}
+
+}  // namespace
+
+// "handwritten" is a serial sum, with the same dependency chain as reduce.
+
+TEST_CASE("tree_reduce: 16 doubles", "[bench]")
+{
+    sum_doubles<16>();
+}
+
+TEST_CASE("tree_reduce: 64 doubles", "[bench]")
+{
+    sum_doubles<64>();
+}
+
+TEST_CASE("tree_reduce: 256 doubles", "[bench]")
+{
+    sum_doubles<256>();
+}
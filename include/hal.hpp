@@ -1,8 +1,16 @@
 #ifndef HAL_HPP
 #define HAL_HPP
+#include <array>
+#include <bit>
+#include <cassert>
+#include <compare>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <new>
+#include <span>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -23,116 +31,308 @@ auto return_type_impl()
 template <typename Fn, typename... Args>
 using Return_t = decltype(return_type_impl<Fn, Args...>());
 
-template <typename T, typename... Args>
-auto test_is_braces_constructible(int)
-    -> decltype(void(T{std::declval<Args>()...}), std::true_type{});
-
-template <typename...>
-auto test_is_braces_constructible(...) -> std::false_type;
-
-template <typename T, typename... Args>
-using is_braces_constructible =
-    decltype(test_is_braces_constructible<T, Args...>(0));
-
-template <typename T, typename... Args>
-using has_members = is_braces_constructible<T, Args...>;
+/// The last type in \p Ts..., found with a comma fold instead of recursion.
+template <typename... Ts>
+using Last_t = typename decltype((std::type_identity<Ts>{}, ...))::type;
 
 struct any_type {
     template <typename T>
     constexpr operator T();
 };
 
-template <typename Make_tup, typename T>
-constexpr auto to_tuple_impl(Make_tup&& make_tup, T&& object)
+/// The largest aggregate that to_tuple and the memberwise algorithms support.
+inline constexpr auto max_member_count = std::size_t{64};
+
+template <std::size_t>
+using Any_t = any_type;
+
+/// Is true if \p T can be brace initialized from \p I... values.
+template <typename T, std::size_t... I>
+constexpr auto has_n_members(std::index_sequence<I...>) -> bool
+{
+    return requires { T{Any_t<I>{}...}; };
+}
+
+/** The smallest count from \p count up that \p T can be brace initialized
+    from, or max_member_count + 2 if there is none. This is 0 unless a member
+    can't be initialized from {}, such as one with an explicit constructor,
+    in which case T can't be brace initialized from fewer values than the
+    members up to and including it. */
+template <typename T, std::size_t count>
+constexpr auto min_member_count_impl() -> std::size_t
+{
+    if constexpr (count > max_member_count + 1 ||
+                  has_n_members<T>(std::make_index_sequence<count>{}))
+        return count;
+    else
+        return min_member_count_impl<T, count + 1>();
+}
+
+/** Binary search for the largest count in [low, high] that \p T can be brace
+    initialized from, where \p low is a count it can be initialized from. An
+    aggregate can be brace initialized from any count from low up to its
+    number of members, so this takes log2(high) probes instead of one per
+    count. */
+template <typename T, std::size_t low, std::size_t high>
+constexpr auto max_member_count_impl() -> std::size_t
 {
-    using namespace detail;
-    using obj_t = std::decay_t<T>;
-    using X     = any_type;
-    if constexpr (has_members<obj_t, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
-                              X, X>{}) {
-        auto&& [x0, x1, x2, x3, x4, X5, x6, x7, x8, x9, x10, x11, x12, x13, x14,
-                x15] = std::forward<T>(object);
-        return make_tup(x0, x1, x2, x3, x4, X5, x6, x7, x8, x9, x10, x11, x12,
-                        x13, x14, x15);
-    }
-    else if constexpr (has_members<obj_t, X, X, X, X, X, X, X, X, X, X, X, X, X,
-                                   X, X>{}) {
-        auto&& [x0, x1, x2, x3, x4, X5, x6, x7, x8, x9, x10, x11, x12, x13,
-                x14] = std::forward<T>(object);
-        return make_tup(x0, x1, x2, x3, x4, X5, x6, x7, x8, x9, x10, x11, x12,
-                        x13, x14);
-    }
-    else if constexpr (has_members<obj_t, X, X, X, X, X, X, X, X, X, X, X, X, X,
-                                   X>{}) {
-        auto&& [x0, x1, x2, x3, x4, X5, x6, x7, x8, x9, x10, x11, x12, x13] =
-            std::forward<T>(object);
-        return make_tup(x0, x1, x2, x3, x4, X5, x6, x7, x8, x9, x10, x11, x12,
-                        x13);
-    }
-    else if constexpr (has_members<obj_t, X, X, X, X, X, X, X, X, X, X, X, X,
-                                   X>{}) {
-        auto&& [x0, x1, x2, x3, x4, X5, x6, x7, x8, x9, x10, x11, x12] =
-            std::forward<T>(object);
-        return make_tup(x0, x1, x2, x3, x4, X5, x6, x7, x8, x9, x10, x11, x12);
-    }
-    else if constexpr (has_members<obj_t, X, X, X, X, X, X, X, X, X, X, X,
-                                   X>{}) {
-        auto&& [x0, x1, x2, x3, x4, X5, x6, x7, x8, x9, x10, x11] =
-            std::forward<T>(object);
-        return make_tup(x0, x1, x2, x3, x4, X5, x6, x7, x8, x9, x10, x11);
-    }
-    else if constexpr (has_members<obj_t, X, X, X, X, X, X, X, X, X, X, X>{}) {
-        auto&& [x0, x1, x2, x3, x4, X5, x6, x7, x8, x9, x10] =
-            std::forward<T>(object);
-        return make_tup(x0, x1, x2, x3, x4, X5, x6, x7, x8, x9, x10);
-    }
-    else if constexpr (has_members<obj_t, X, X, X, X, X, X, X, X, X, X>{}) {
-        auto&& [x0, x1, x2, x3, x4, X5, x6, x7, x8, x9] =
-            std::forward<T>(object);
-        return make_tup(x0, x1, x2, x3, x4, X5, x6, x7, x8, x9);
-    }
-    else if constexpr (has_members<obj_t, X, X, X, X, X, X, X, X, X>{}) {
-        auto&& [x0, x1, x2, x3, x4, X5, x6, x7, x8] = std::forward<T>(object);
-        return make_tup(x0, x1, x2, x3, x4, X5, x6, x7, x8);
-    }
-    else if constexpr (has_members<obj_t, X, X, X, X, X, X, X, X>{}) {
-        auto&& [x0, x1, x2, x3, x4, X5, x6, x7] = std::forward<T>(object);
-        return make_tup(x0, x1, x2, x3, x4, X5, x6, x7);
-    }
-    else if constexpr (has_members<obj_t, X, X, X, X, X, X, X>{}) {
-        auto&& [x0, x1, x2, x3, x4, X5, x6] = std::forward<T>(object);
-        return make_tup(x0, x1, x2, x3, x4, X5, x6);
-    }
-    else if constexpr (has_members<obj_t, X, X, X, X, X, X>{}) {
-        auto&& [x0, x1, x2, x3, x4, X5] = std::forward<T>(object);
-        return make_tup(x0, x1, x2, x3, x4, X5);
-    }
-    else if constexpr (has_members<obj_t, X, X, X, X, X>{}) {
-        auto&& [x0, x1, x2, x3, x4] = std::forward<T>(object);
-        return make_tup(x0, x1, x2, x3, x4);
-    }
-    else if constexpr (has_members<obj_t, X, X, X, X>{}) {
-        auto&& [x0, x1, x2, x3] = std::forward<T>(object);
-        return make_tup(x0, x1, x2, x3);
-    }
-    else if constexpr (has_members<obj_t, X, X, X>{}) {
-        auto&& [x0, x1, x2] = std::forward<T>(object);
-        return make_tup(x0, x1, x2);
-    }
-    else if constexpr (has_members<obj_t, X, X>{}) {
-        auto&& [x0, x1] = std::forward<T>(object);
-        return make_tup(x0, x1);
-    }
-    else if constexpr (has_members<obj_t, X>{}) {
-        auto&& [x0] = std::forward<T>(object);
-        return make_tup(x0);
+    if constexpr (low == high)
+        return low;
+    else {
+        constexpr auto mid = low + (high - low + 1) / 2;
+        if constexpr (has_n_members<T>(std::make_index_sequence<mid>{}))
+            return max_member_count_impl<T, mid, high>();
+        else
+            return max_member_count_impl<T, low, mid - 1>();
     }
+}
+
+/** The number of values \p T can be brace initialized from, at most. The
+    counts it can be initialized from only form a range from its smallest
+    count up, so that is found first, by one probe for most aggregates. */
+template <typename T>
+constexpr auto member_count_impl() -> std::size_t
+{
+    constexpr auto low = min_member_count_impl<T, 0>();
+    if constexpr (low > max_member_count + 1)
+        return 0;
     else
-        return make_tup();
+        return max_member_count_impl<T, low, max_member_count + 1>();
 }
 
 }  // namespace detail
 
+/// Number of members in the aggregate \p T, found once per type.
+/** Can be specialized for tuple-like types that support structured bindings,
+    so that to_tuple and the memberwise algorithms accept them. */
+template <typename T>
+struct member_count
+    : std::integral_constant<
+          std::size_t,
+          detail::member_count_impl<std::remove_cvref_t<T>>()> {
+    static_assert(member_count::value <= detail::max_member_count,
+                  "Aggregate has more members than hal supports.");
+};
+
+template <typename T>
+inline constexpr auto member_count_v =
+    member_count<std::remove_cvref_t<T>>::value;
+
+namespace detail {
+
+// Structured binding identifiers x0, x1, ..., for each number of members.
+#define HAL_BINDINGS_1 x0
+#define HAL_BINDINGS_2 HAL_BINDINGS_1, x1
+#define HAL_BINDINGS_3 HAL_BINDINGS_2, x2
+#define HAL_BINDINGS_4 HAL_BINDINGS_3, x3
+#define HAL_BINDINGS_5 HAL_BINDINGS_4, x4
+#define HAL_BINDINGS_6 HAL_BINDINGS_5, x5
+#define HAL_BINDINGS_7 HAL_BINDINGS_6, x6
+#define HAL_BINDINGS_8 HAL_BINDINGS_7, x7
+#define HAL_BINDINGS_9 HAL_BINDINGS_8, x8
+#define HAL_BINDINGS_10 HAL_BINDINGS_9, x9
+#define HAL_BINDINGS_11 HAL_BINDINGS_10, x10
+#define HAL_BINDINGS_12 HAL_BINDINGS_11, x11
+#define HAL_BINDINGS_13 HAL_BINDINGS_12, x12
+#define HAL_BINDINGS_14 HAL_BINDINGS_13, x13
+#define HAL_BINDINGS_15 HAL_BINDINGS_14, x14
+#define HAL_BINDINGS_16 HAL_BINDINGS_15, x15
+#define HAL_BINDINGS_17 HAL_BINDINGS_16, x16
+#define HAL_BINDINGS_18 HAL_BINDINGS_17, x17
+#define HAL_BINDINGS_19 HAL_BINDINGS_18, x18
+#define HAL_BINDINGS_20 HAL_BINDINGS_19, x19
+#define HAL_BINDINGS_21 HAL_BINDINGS_20, x20
+#define HAL_BINDINGS_22 HAL_BINDINGS_21, x21
+#define HAL_BINDINGS_23 HAL_BINDINGS_22, x22
+#define HAL_BINDINGS_24 HAL_BINDINGS_23, x23
+#define HAL_BINDINGS_25 HAL_BINDINGS_24, x24
+#define HAL_BINDINGS_26 HAL_BINDINGS_25, x25
+#define HAL_BINDINGS_27 HAL_BINDINGS_26, x26
+#define HAL_BINDINGS_28 HAL_BINDINGS_27, x27
+#define HAL_BINDINGS_29 HAL_BINDINGS_28, x28
+#define HAL_BINDINGS_30 HAL_BINDINGS_29, x29
+#define HAL_BINDINGS_31 HAL_BINDINGS_30, x30
+#define HAL_BINDINGS_32 HAL_BINDINGS_31, x31
+#define HAL_BINDINGS_33 HAL_BINDINGS_32, x32
+#define HAL_BINDINGS_34 HAL_BINDINGS_33, x33
+#define HAL_BINDINGS_35 HAL_BINDINGS_34, x34
+#define HAL_BINDINGS_36 HAL_BINDINGS_35, x35
+#define HAL_BINDINGS_37 HAL_BINDINGS_36, x36
+#define HAL_BINDINGS_38 HAL_BINDINGS_37, x37
+#define HAL_BINDINGS_39 HAL_BINDINGS_38, x38
+#define HAL_BINDINGS_40 HAL_BINDINGS_39, x39
+#define HAL_BINDINGS_41 HAL_BINDINGS_40, x40
+#define HAL_BINDINGS_42 HAL_BINDINGS_41, x41
+#define HAL_BINDINGS_43 HAL_BINDINGS_42, x42
+#define HAL_BINDINGS_44 HAL_BINDINGS_43, x43
+#define HAL_BINDINGS_45 HAL_BINDINGS_44, x44
+#define HAL_BINDINGS_46 HAL_BINDINGS_45, x45
+#define HAL_BINDINGS_47 HAL_BINDINGS_46, x46
+#define HAL_BINDINGS_48 HAL_BINDINGS_47, x47
+#define HAL_BINDINGS_49 HAL_BINDINGS_48, x48
+#define HAL_BINDINGS_50 HAL_BINDINGS_49, x49
+#define HAL_BINDINGS_51 HAL_BINDINGS_50, x50
+#define HAL_BINDINGS_52 HAL_BINDINGS_51, x51
+#define HAL_BINDINGS_53 HAL_BINDINGS_52, x52
+#define HAL_BINDINGS_54 HAL_BINDINGS_53, x53
+#define HAL_BINDINGS_55 HAL_BINDINGS_54, x54
+#define HAL_BINDINGS_56 HAL_BINDINGS_55, x55
+#define HAL_BINDINGS_57 HAL_BINDINGS_56, x56
+#define HAL_BINDINGS_58 HAL_BINDINGS_57, x57
+#define HAL_BINDINGS_59 HAL_BINDINGS_58, x58
+#define HAL_BINDINGS_60 HAL_BINDINGS_59, x59
+#define HAL_BINDINGS_61 HAL_BINDINGS_60, x60
+#define HAL_BINDINGS_62 HAL_BINDINGS_61, x61
+#define HAL_BINDINGS_63 HAL_BINDINGS_62, x62
+#define HAL_BINDINGS_64 HAL_BINDINGS_63, x63
+
+#define HAL_TO_TUPLE_CASE(N)                                  \
+    else if constexpr (count == N)                            \
+    {                                                         \
+        auto&& [HAL_BINDINGS_##N] = std::forward<T>(object); \
+        return make_tup(HAL_BINDINGS_##N);                    \
+    }
+
+template <typename Make_tup, typename T>
+constexpr auto to_tuple_impl(Make_tup&& make_tup, T&& object)
+{
+    constexpr auto count = member_count_v<T>;
+    if constexpr (count == 0)
+        return make_tup();
+    HAL_TO_TUPLE_CASE(1)
+    HAL_TO_TUPLE_CASE(2)
+    HAL_TO_TUPLE_CASE(3)
+    HAL_TO_TUPLE_CASE(4)
+    HAL_TO_TUPLE_CASE(5)
+    HAL_TO_TUPLE_CASE(6)
+    HAL_TO_TUPLE_CASE(7)
+    HAL_TO_TUPLE_CASE(8)
+    HAL_TO_TUPLE_CASE(9)
+    HAL_TO_TUPLE_CASE(10)
+    HAL_TO_TUPLE_CASE(11)
+    HAL_TO_TUPLE_CASE(12)
+    HAL_TO_TUPLE_CASE(13)
+    HAL_TO_TUPLE_CASE(14)
+    HAL_TO_TUPLE_CASE(15)
+    HAL_TO_TUPLE_CASE(16)
+    HAL_TO_TUPLE_CASE(17)
+    HAL_TO_TUPLE_CASE(18)
+    HAL_TO_TUPLE_CASE(19)
+    HAL_TO_TUPLE_CASE(20)
+    HAL_TO_TUPLE_CASE(21)
+    HAL_TO_TUPLE_CASE(22)
+    HAL_TO_TUPLE_CASE(23)
+    HAL_TO_TUPLE_CASE(24)
+    HAL_TO_TUPLE_CASE(25)
+    HAL_TO_TUPLE_CASE(26)
+    HAL_TO_TUPLE_CASE(27)
+    HAL_TO_TUPLE_CASE(28)
+    HAL_TO_TUPLE_CASE(29)
+    HAL_TO_TUPLE_CASE(30)
+    HAL_TO_TUPLE_CASE(31)
+    HAL_TO_TUPLE_CASE(32)
+    HAL_TO_TUPLE_CASE(33)
+    HAL_TO_TUPLE_CASE(34)
+    HAL_TO_TUPLE_CASE(35)
+    HAL_TO_TUPLE_CASE(36)
+    HAL_TO_TUPLE_CASE(37)
+    HAL_TO_TUPLE_CASE(38)
+    HAL_TO_TUPLE_CASE(39)
+    HAL_TO_TUPLE_CASE(40)
+    HAL_TO_TUPLE_CASE(41)
+    HAL_TO_TUPLE_CASE(42)
+    HAL_TO_TUPLE_CASE(43)
+    HAL_TO_TUPLE_CASE(44)
+    HAL_TO_TUPLE_CASE(45)
+    HAL_TO_TUPLE_CASE(46)
+    HAL_TO_TUPLE_CASE(47)
+    HAL_TO_TUPLE_CASE(48)
+    HAL_TO_TUPLE_CASE(49)
+    HAL_TO_TUPLE_CASE(50)
+    HAL_TO_TUPLE_CASE(51)
+    HAL_TO_TUPLE_CASE(52)
+    HAL_TO_TUPLE_CASE(53)
+    HAL_TO_TUPLE_CASE(54)
+    HAL_TO_TUPLE_CASE(55)
+    HAL_TO_TUPLE_CASE(56)
+    HAL_TO_TUPLE_CASE(57)
+    HAL_TO_TUPLE_CASE(58)
+    HAL_TO_TUPLE_CASE(59)
+    HAL_TO_TUPLE_CASE(60)
+    HAL_TO_TUPLE_CASE(61)
+    HAL_TO_TUPLE_CASE(62)
+    HAL_TO_TUPLE_CASE(63)
+    HAL_TO_TUPLE_CASE(64)
+}
+
+#undef HAL_TO_TUPLE_CASE
+#undef HAL_BINDINGS_1
+#undef HAL_BINDINGS_2
+#undef HAL_BINDINGS_3
+#undef HAL_BINDINGS_4
+#undef HAL_BINDINGS_5
+#undef HAL_BINDINGS_6
+#undef HAL_BINDINGS_7
+#undef HAL_BINDINGS_8
+#undef HAL_BINDINGS_9
+#undef HAL_BINDINGS_10
+#undef HAL_BINDINGS_11
+#undef HAL_BINDINGS_12
+#undef HAL_BINDINGS_13
+#undef HAL_BINDINGS_14
+#undef HAL_BINDINGS_15
+#undef HAL_BINDINGS_16
+#undef HAL_BINDINGS_17
+#undef HAL_BINDINGS_18
+#undef HAL_BINDINGS_19
+#undef HAL_BINDINGS_20
+#undef HAL_BINDINGS_21
+#undef HAL_BINDINGS_22
+#undef HAL_BINDINGS_23
+#undef HAL_BINDINGS_24
+#undef HAL_BINDINGS_25
+#undef HAL_BINDINGS_26
+#undef HAL_BINDINGS_27
+#undef HAL_BINDINGS_28
+#undef HAL_BINDINGS_29
+#undef HAL_BINDINGS_30
+#undef HAL_BINDINGS_31
+#undef HAL_BINDINGS_32
+#undef HAL_BINDINGS_33
+#undef HAL_BINDINGS_34
+#undef HAL_BINDINGS_35
+#undef HAL_BINDINGS_36
+#undef HAL_BINDINGS_37
+#undef HAL_BINDINGS_38
+#undef HAL_BINDINGS_39
+#undef HAL_BINDINGS_40
+#undef HAL_BINDINGS_41
+#undef HAL_BINDINGS_42
+#undef HAL_BINDINGS_43
+#undef HAL_BINDINGS_44
+#undef HAL_BINDINGS_45
+#undef HAL_BINDINGS_46
+#undef HAL_BINDINGS_47
+#undef HAL_BINDINGS_48
+#undef HAL_BINDINGS_49
+#undef HAL_BINDINGS_50
+#undef HAL_BINDINGS_51
+#undef HAL_BINDINGS_52
+#undef HAL_BINDINGS_53
+#undef HAL_BINDINGS_54
+#undef HAL_BINDINGS_55
+#undef HAL_BINDINGS_56
+#undef HAL_BINDINGS_57
+#undef HAL_BINDINGS_58
+#undef HAL_BINDINGS_59
+#undef HAL_BINDINGS_60
+#undef HAL_BINDINGS_61
+#undef HAL_BINDINGS_62
+#undef HAL_BINDINGS_63
+#undef HAL_BINDINGS_64
+
+}  // namespace detail
+
 template <typename T>
 constexpr auto to_tuple(T&& object)
 {
@@ -180,11 +380,61 @@ namespace detail {
 /* ------------------------------- Curried -----------------------------------*/
 // Inspired by Functional Programming in C++ by Ivan Cukic, section 11.3.
 
+/// Is true if P is a pointer to a call operator that isn't const.
+template <typename P>
+inline constexpr auto is_mutable_call = false;
+
+template <typename R, typename C, typename... Args>
+inline constexpr auto is_mutable_call<R (C::*)(Args...)> = true;
+
+template <typename R, typename C, typename... Args>
+inline constexpr auto is_mutable_call<R (C::*)(Args...) noexcept> = true;
+
+template <typename R, typename C, typename... Args>
+inline constexpr auto is_mutable_call<R (C::*)(Args...)&> = true;
+
+template <typename R, typename C, typename... Args>
+inline constexpr auto is_mutable_call<R (C::*)(Args...) & noexcept> = true;
+
+/// Is true if T has a single call operator which isn't const, like a mutable
+/// lambda, so it can't be called through a const reference.
+template <typename T>
+inline constexpr auto has_mutable_call = false;
+
+template <typename T>
+    requires requires { &T::operator(); }
+inline constexpr auto has_mutable_call<T> =
+    is_mutable_call<decltype(&T::operator())>;
+
+/// How a const Curried holds a captured argument while invoking the function.
+template <typename T>
+using Curried_held_t =
+    std::conditional_t<!std::is_reference_v<T> && has_mutable_call<T>,
+                       T,
+                       T const&>;
+
+/// Is true if F is invocable with the elements of Tuple followed by Args.
+template <typename F, typename Tuple, typename... Args>
+inline constexpr auto is_invocable_prefixed = false;
+
+template <typename F, typename... Elements, typename... Args>
+inline constexpr auto
+    is_invocable_prefixed<F, std::tuple<Elements...>, Args...> =
+        std::invocable<F, Elements..., Args...>;
+
 /// Creates a Curried Function.
 /** Wraps a function which captures arguments with the call operator until
     minimum_args is reached, and the function can be invoked with the captured
     arguments. Use std::reference_wrapper if you need captured arguments to be
-    references. */
+    references.
+
+    Captured arguments are passed to the function by const reference, so
+    calling a Curried object does not copy them. Captured arguments with a
+    call operator that isn't const, like mutable lambdas, are copied for each
+    call instead, so every call starts from the state they were captured with.
+    Invoke an rvalue Curried object to move its captured arguments into the
+    function, this lets move-only and expensive to copy arguments be captured
+    without copying. */
 template <std::size_t minimum_args,
           typename Function,
           typename... Captured_args>
@@ -206,27 +456,90 @@ class Curried {
    public:
     /// Either capture the args or invoke the function and return the result.
     template <typename... New_args>
-    constexpr auto operator()(New_args&&... args) const
+    constexpr auto operator()(New_args&&... args) const&
     {
-        constexpr auto arg_count =
-            sizeof...(New_args) + sizeof...(Captured_args);
+        using Held = decltype(held(captured_));
 
-        if constexpr (arg_count >= minimum_args &&
-                      std::invocable<Function, Captured_args..., New_args...>) {
+        if constexpr (is_complete<New_args...>() &&
+                      is_invocable_prefixed<Function const&,
+                                            Lvalues_t<Held>,
+                                            New_args...>) {
             // If invoking the function, use references of the args...
-            auto all_args = std::tuple_cat(
-                captured_,
-                std::forward_as_tuple(std::forward<New_args>(args)...));
-            return std::apply(function_, all_args);
+            auto captured_args = held(captured_);
+            return std::apply(
+                [&](auto&... captured) {
+                    return function_(captured...,
+                                     std::forward<New_args>(args)...);
+                },
+                captured_args);
+        }
+        else {
+            return capture(*this, std::forward<New_args>(args)...);
+        }
+    }
+
+    /// Either move the captured args to a new Curried or into the function.
+    template <typename... New_args>
+    constexpr auto operator()(New_args&&... args) &&
+    {
+        if constexpr (is_complete<New_args...>() &&
+                      is_invocable_prefixed<Function,
+                                            Rvalues_t<Captured_t>,
+                                            New_args...>) {
+            return std::apply(
+                [&](auto&&... captured) {
+                    return std::move(function_)(
+                        std::forward<decltype(captured)>(captured)...,
+                        std::forward<New_args>(args)...);
+                },
+                std::move(captured_));
         }
         else {
-            auto new_args = std::make_tuple(std::forward<New_args>(args)...);
-            auto all_args = std::tuple_cat(captured_, std::move(new_args));
-            return Curried<minimum_args, Function, Captured_args...,
-                           New_args...>{function_, all_args};
+            return capture(std::move(*this), std::forward<New_args>(args)...);
         }
     }
 
+   private:
+    template <typename... Elements>
+    static auto lvalues(std::tuple<Elements...>) -> std::tuple<Elements&...>;
+
+    template <typename... Elements>
+    static auto rvalues(std::tuple<Elements...>) -> std::tuple<Elements&&...>;
+
+    template <typename Tuple>
+    using Lvalues_t = decltype(lvalues(std::declval<Tuple>()));
+
+    template <typename Tuple>
+    using Rvalues_t = decltype(rvalues(std::declval<Tuple>()));
+
+    template <typename... New_args>
+    static constexpr auto is_complete() -> bool
+    {
+        return sizeof...(New_args) + sizeof...(Captured_args) >= minimum_args;
+    }
+
+    template <typename... Elements>
+    static constexpr auto held(std::tuple<Elements...> const& captured)
+        -> std::tuple<Curried_held_t<Elements>...>
+    {
+        return std::tuple<Curried_held_t<Elements>...>(captured);
+    }
+
+    template <typename Self, typename... New_args>
+    static constexpr auto capture(Self&& self, New_args&&... args)
+    {
+        using Next =
+            Curried<minimum_args, Function, Captured_args..., New_args...>;
+        return std::apply(
+            [&](auto&&... captured) {
+                return Next{std::forward<Self>(self).function_,
+                            typename Next::Captured_t{
+                                std::forward<decltype(captured)>(captured)...,
+                                std::forward<New_args>(args)...}};
+            },
+            std::forward<Self>(self).captured_);
+    }
+
    private:
     Function function_;
     Captured_t captured_;
@@ -240,6 +553,225 @@ constexpr auto make_curried(Function&& f) -> Curried<minimum_args, Function>
 }
 }  // namespace detail
 
+/* --------------------------------- simd ----------------------------------- */
+// Packs of a single arithmetic type are gathered into an array and processed
+// a register at a time, with the GCC and Clang vector extensions. These
+// compile to AVX2 or SSE2 instructions depending on the target flags, other
+// compilers, or defining HAL_NO_SIMD, use the generic algorithms. Shuffles
+// also need __builtin_shufflevector, from GCC 12 or Clang.
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(HAL_NO_SIMD)
+#if defined(__AVX2__)
+#define HAL_SIMD_WIDTH 32
+#elif defined(__SSE2__) || defined(__ARM_NEON)
+#define HAL_SIMD_WIDTH 16
+#endif
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_shufflevector)
+#define HAL_SIMD_SHUFFLE
+#endif
+#endif
+#endif
+
+namespace detail::simd {
+
+#if defined(HAL_SIMD_WIDTH)
+/// Register width in bytes.
+inline constexpr auto width = std::size_t{HAL_SIMD_WIDTH};
+
+template <typename T>
+using Vec [[gnu::vector_size(HAL_SIMD_WIDTH)]] = T;
+#else
+inline constexpr auto width = std::size_t{0};
+
+template <typename T>
+struct Vec;  // Never instantiated, is_packable is always false.
+#endif
+
+#if defined(__FAST_MATH__)
+inline constexpr auto fast_math = true;
+#else
+inline constexpr auto fast_math = false;
+#endif
+
+template <typename T>
+inline constexpr auto lanes = width / sizeof(T);
+
+/** Is true if \p Elements... are all of arithmetic type \p T and fill at least
+    one register of four or more lanes. Narrower types are left to the generic
+    algorithms, their lanes would overflow when counting. */
+template <typename T, typename... Elements>
+inline constexpr auto is_packable =
+    width != 0 && std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+    sizeof(T) >= 4 && lanes<T> >= 4 && sizeof...(Elements) >= lanes<T> &&
+    (std::is_same_v<T, std::remove_cvref_t<Elements>> && ...);
+
+/// Is true if a sum of \p T can be reordered without changing its result.
+template <typename T>
+inline constexpr auto is_reorderable = std::is_integral_v<T> || fast_math;
+
+/// Is true if \p BinaryOp is std::plus for \p T.
+template <typename BinaryOp, typename T>
+inline constexpr auto is_plus =
+    std::is_same_v<std::remove_cvref_t<BinaryOp>, std::plus<>> ||
+    std::is_same_v<std::remove_cvref_t<BinaryOp>, std::plus<T>>;
+
+template <typename T>
+auto load(T const* data) -> Vec<T>
+{
+    auto result = Vec<T>{};
+    std::memcpy(&result, data, sizeof(result));
+    return result;
+}
+
+/// Adds \p values to \p init, in lanes<T> independent sums.
+template <typename T, std::size_t N>
+auto sum(T init, std::array<T, N> const& values) -> T
+{
+    constexpr auto body = N / lanes<T> * lanes<T>;
+    auto total          = Vec<T>{};
+    for (auto i = std::size_t{0}; i < body; i += lanes<T>)
+        total += load(values.data() + i);
+    for (auto i = std::size_t{0}; i < lanes<T>; ++i)
+        init += total[i];
+    for (auto i = body; i < N; ++i)
+        init += values[i];
+    return init;
+}
+
+/// Counts the elements of \p values equal to \p x.
+template <typename T, std::size_t N>
+auto count(T x, std::array<T, N> const& values) -> std::size_t
+{
+    constexpr auto body = N / lanes<T> * lanes<T>;
+    // Lanes that compare equal are all ones, -1, so subtract to count them.
+    auto counts = decltype(Vec<T>{} == Vec<T>{}){};
+    for (auto i = std::size_t{0}; i < body; i += lanes<T>)
+        counts -= load(values.data() + i) == x;
+    auto result = std::size_t{0};
+    for (auto i = std::size_t{0}; i < lanes<T>; ++i)
+        result += static_cast<std::size_t>(counts[i]);
+    for (auto i = body; i < N; ++i)
+        result += values[i] == x;
+    return result;
+}
+
+/// Index of the first element of \p values equal to \p x, or N if none are.
+template <typename T, std::size_t N>
+auto find(T x, std::array<T, N> const& values) -> std::size_t
+{
+    constexpr auto body = N / lanes<T> * lanes<T>;
+    for (auto i = std::size_t{0}; i < body; i += lanes<T>) {
+        auto const equal = load(values.data() + i) == x;
+        auto words       = std::array<std::uint64_t, width / 8>{};
+        std::memcpy(words.data(), &equal, sizeof(equal));
+        auto any = std::uint64_t{0};
+        for (auto word : words)
+            any |= word;
+        if (any != 0) {
+            for (auto j = std::size_t{0}; j < lanes<T>; ++j) {
+                if (equal[j])
+                    return i + j;
+            }
+        }
+    }
+    for (auto i = body; i < N; ++i) {
+        if (values[i] == x)
+            return i;
+    }
+    return N;
+}
+
+#if defined(HAL_SIMD_SHUFFLE)
+inline constexpr auto has_shuffle = true;
+#else
+inline constexpr auto has_shuffle = false;
+#endif
+
+/** Is true if a block of lanes<T> records of \p members members of type \p T
+    is a square that transpose can turn into columns. */
+template <typename T, std::size_t members>
+inline constexpr auto is_transposable =
+    width != 0 && has_shuffle && std::is_arithmetic_v<T> &&
+    !std::is_same_v<T, bool> && sizeof(T) <= 8 && lanes<T> == members;
+
+/// Interleaves the low halves of \p a and \p b, or their high halves.
+template <bool high, typename T, std::size_t... I>
+auto interleave(Vec<T> a, Vec<T> b, std::index_sequence<I...>) -> Vec<T>
+{
+    return __builtin_shufflevector(
+        a, b, (high ? lanes<T> / 2 : 0) + I / 2 + I % 2 * lanes<T>...);
+}
+
+/// One round of transpose, interleaves row i with row i + half.
+template <typename T, std::size_t... I>
+void interleave_rows(Vec<T>* rows, std::index_sequence<I...>)
+{
+    constexpr auto half    = sizeof...(I);
+    constexpr auto indices = std::make_index_sequence<lanes<T>>{};
+    Vec<T> const low[]     = {rows[I]...};
+    Vec<T> const high[]    = {rows[I + half]...};
+    ((rows[2 * I]     = interleave<false, T>(low[I], high[I], indices),
+      rows[2 * I + 1] = interleave<true, T>(low[I], high[I], indices)),
+     ...);
+}
+
+/** Transposes \p rows, a square of lanes<T> by lanes<T> elements, in
+    log2(lanes<T>) rounds of interleaving pairs of rows. The rows are a plain
+    array, std::array would drop the vector_size attribute of Vec<T>. */
+template <typename T>
+void transpose(Vec<T>* rows)
+{
+    for (auto round = std::size_t{1}; round < lanes<T>; round *= 2)
+        simd::interleave_rows<T>(rows,
+                                 std::make_index_sequence<lanes<T> / 2>{});
+}
+
+/** Copies the members of \p count records, stored as lanes<T> values of type
+    \p T each, into \p columns. Returns the number of records copied, which
+    is \p count rounded down to a whole number of squares. */
+template <typename T>
+auto scatter(std::byte const* records,
+             std::size_t count,
+             std::array<T*, lanes<T>> columns) -> std::size_t
+{
+    auto const body = count / lanes<T> * lanes<T>;
+    [&]<std::size_t... M>(std::index_sequence<M...>)
+    {
+        for (auto i = std::size_t{0}; i < body; i += lanes<T>) {
+            Vec<T> rows[] = {
+                simd::load(reinterpret_cast<T const*>(records) +
+                           (i + M) * lanes<T>)...};
+            simd::transpose<T>(rows);
+            (std::memcpy(columns[M] + i, &rows[M], sizeof(Vec<T>)), ...);
+        }
+    }
+    (std::make_index_sequence<lanes<T>>{});
+    return body;
+}
+
+/// The inverse of scatter, copies \p columns into \p count records.
+template <typename T>
+auto gather(std::byte* records,
+            std::size_t count,
+            std::array<T const*, lanes<T>> columns) -> std::size_t
+{
+    auto const body = count / lanes<T> * lanes<T>;
+    [&]<std::size_t... M>(std::index_sequence<M...>)
+    {
+        for (auto i = std::size_t{0}; i < body; i += lanes<T>) {
+            Vec<T> rows[] = {simd::load(columns[M] + i)...};
+            simd::transpose<T>(rows);
+            (std::memcpy(records + (i + M) * sizeof(Vec<T>), &rows[M],
+                         sizeof(Vec<T>)),
+             ...);
+        }
+    }
+    (std::make_index_sequence<lanes<T>>{});
+    return body;
+}
+
+}  // namespace detail::simd
+
 /* -------------------------------- for_each -------------------------------- */
 template <typename UnaryOp, typename... Elements>
     requires((std::invocable<UnaryOp, Elements> && ...))
@@ -277,6 +809,15 @@ template <typename T, typename BinaryOp, typename... Elements>
 constexpr auto reduce_impl(T init, BinaryOp&& reduce_fn, Elements&&... elements)
     -> T
 {
+    if constexpr (detail::simd::is_packable<T, Elements...> &&
+                  detail::simd::is_reorderable<T> &&
+                  detail::simd::is_plus<BinaryOp, T>) {
+        if (!std::is_constant_evaluated()) {
+            return detail::simd::sum(
+                std::move(init),
+                std::array<T, sizeof...(Elements)>{elements...});
+        }
+    }
     ((init = reduce_fn(init, std::forward<Elements>(elements))), ...);
     return init;
 }
@@ -293,8 +834,7 @@ template <typename T, typename BinaryOp, typename Aggregate>
 constexpr auto reduce_impl(T init, BinaryOp&& reduce_fn, Aggregate&& aggregate)
     -> T
 {
-    constexpr auto size =
-        std::tuple_size_v<decltype(hal::to_ref_tuple(aggregate))>;
+    constexpr auto size = hal::member_count_v<Aggregate>;
     if constexpr (size == 0)
         return init;
     else {
@@ -312,6 +852,90 @@ inline auto constexpr reduce =
     });
 }  // namespace memberwise
 
+/* ------------------------------ tree_reduce ------------------------------- */
+namespace detail {
+/// Combines each node at a multiple of 2 * width with the node width after it.
+template <std::size_t width,
+          typename BinaryOp,
+          typename T,
+          std::size_t N,
+          std::size_t... I>
+constexpr void tree_reduce_pass(BinaryOp& reduce_fn,
+                                std::array<T, N>& nodes,
+                                std::index_sequence<I...>)
+{
+    ((nodes[2 * width * I] = reduce_fn(std::move(nodes[2 * width * I]),
+                                       std::move(nodes[2 * width * I + width]))),
+     ...);
+}
+
+/** Unrolled passes with width 1, 2, 4, ... until nodes[0] holds the result.
+    The calls within a pass are independent of each other. */
+template <std::size_t width, typename BinaryOp, typename T, std::size_t N>
+constexpr void tree_reduce_passes(BinaryOp& reduce_fn, std::array<T, N>& nodes)
+{
+    if constexpr (width < N) {
+        tree_reduce_pass<width>(
+            reduce_fn, nodes,
+            std::make_index_sequence<(N + width - 1) / (2 * width)>{});
+        tree_reduce_passes<2 * width>(reduce_fn, nodes);
+    }
+}
+}  // namespace detail
+
+template <typename T, typename BinaryOp, typename... Elements>
+    // clang-format off
+    requires(
+        (std::constructible_from<T, Elements> && ...) &&
+        std::invocable<BinaryOp, T, T> &&
+        std::assignable_from<T&, detail::Return_t<BinaryOp, T, T>>)
+// clang-format on
+constexpr auto tree_reduce_impl(T init,
+                                BinaryOp&& reduce_fn,
+                                Elements&&... elements) -> T
+{
+    if constexpr (sizeof...(Elements) == 0)
+        return init;
+    else {
+        auto nodes = std::array<T, sizeof...(Elements)>{
+            static_cast<T>(std::forward<Elements>(elements))...};
+        detail::tree_reduce_passes<1>(reduce_fn, nodes);
+        return reduce_fn(std::move(init), std::move(nodes[0]));
+    }
+}
+
+inline auto constexpr tree_reduce =
+    detail::make_curried<3>([](auto&& a, auto&& b, auto&&... c) {
+        return tree_reduce_impl(std::forward<decltype(a)>(a),
+                                std::forward<decltype(b)>(b),
+                                std::forward<decltype(c)>(c)...);
+    });
+
+namespace memberwise {
+template <typename T, typename BinaryOp, typename Aggregate>
+constexpr auto tree_reduce_impl(T init,
+                                BinaryOp&& reduce_fn,
+                                Aggregate&& aggregate) -> T
+{
+    constexpr auto size = hal::member_count_v<Aggregate>;
+    if constexpr (size == 0)
+        return init;
+    else {
+        return std::apply(
+            hal::tree_reduce(std::move(init),
+                             std::forward<BinaryOp>(reduce_fn)),
+            hal::to_ref_tuple(std::forward<Aggregate>(aggregate)));
+    }
+}
+
+inline auto constexpr tree_reduce =
+    hal::detail::make_curried<3>([](auto&& a, auto&& b, auto&& c) {
+        return hal::memberwise::tree_reduce_impl(std::forward<decltype(a)>(a),
+                                                 std::forward<decltype(b)>(b),
+                                                 std::forward<decltype(c)>(c));
+    });
+}  // namespace memberwise
+
 /* ---------------------------- partial_reduce ------------------------------ */
 template <typename T, typename BinaryOp, typename... Elements>
 constexpr void partial_reduce_impl(T init,
@@ -341,8 +965,7 @@ constexpr void partial_reduce_impl(T init,
                                    BinaryOp&& reduce_fn,
                                    Aggregate&& aggregate)
 {
-    constexpr auto size =
-        std::tuple_size_v<decltype(hal::to_ref_tuple(aggregate))>;
+    constexpr auto size = hal::member_count_v<Aggregate>;
     if constexpr (size != 0) {
         return std::apply(
             hal::partial_reduce(std::move(init),
@@ -392,6 +1015,17 @@ constexpr auto transform_reduce_impl(T init,
                                      BinaryOp&& reduce_fn,
                                      Elements&&... elements) -> T
 {
+    if constexpr (detail::simd::is_packable<
+                      T, detail::Return_t<UnaryOp, Elements>...> &&
+                  detail::simd::is_reorderable<T> &&
+                  detail::simd::is_plus<BinaryOp, T>) {
+        if (!std::is_constant_evaluated()) {
+            return detail::simd::sum(
+                std::move(init),
+                std::array<T, sizeof...(Elements)>{
+                    transform_fn(std::forward<Elements>(elements))...});
+        }
+    }
     ((init = reduce_fn(init, transform_fn(std::forward<Elements>(elements)))),
      ...);
     return init;
@@ -432,18 +1066,47 @@ inline auto constexpr partial_transform_reduce =
     });
 
 /* -------------------------------- find_if --------------------------------- */
+namespace detail {
+
+/// Index of the first element in \p elements where \p predicate is true.
+/** The predicate is not invoked on any element after the first match. Returns
+    sizeof...(Elements) if no match is found. */
 template <typename UnaryOp, typename... Elements>
-constexpr auto find_if_impl(UnaryOp&& predicate, Elements&&... elements)
+constexpr auto find_first(UnaryOp& predicate, Elements&&... elements)
+    -> std::size_t
+{
+    auto index = std::size_t{0};
+    (void)((predicate(std::forward<Elements>(elements)) ? true
+                                                        : (++index, false)) ||
+           ...);
+    return index;
+}
+
+/// Index of the last element in \p elements where \p predicate is true.
+/** The predicate is not invoked on any element before the last match. Returns
+    sizeof...(Elements) if no match is found. */
+template <typename UnaryOp, typename... Elements>
+constexpr auto find_last(UnaryOp& predicate, Elements&&... elements)
     -> std::size_t
 {
-    auto increment_until_true = [still_going = true](std::size_t count,
-                                                     auto boolean) mutable {
-        return still_going && !boolean ? count + 1
-                                       : (still_going = false, count);
+    auto index = sizeof...(Elements);
+    auto found = false;
+    [[maybe_unused]] auto visit = [&](auto& x) {
+        found = found || (--index, static_cast<bool>(predicate(x)));
     };
-    return transform_reduce_impl(0uL, std::forward<UnaryOp>(predicate),
-                                 increment_until_true,
-                                 std::forward<Elements>(elements)...);
+    // A right fold over assignment evaluates its operands from right to left.
+    [[maybe_unused]] auto foo = 0;
+    (void)((visit(elements), foo) = ... = 0);
+    return found ? index : sizeof...(Elements);
+}
+
+}  // namespace detail
+
+template <typename UnaryOp, typename... Elements>
+constexpr auto find_if_impl(UnaryOp&& predicate, Elements&&... elements)
+    -> std::size_t
+{
+    return detail::find_first(predicate, std::forward<Elements>(elements)...);
 }
 
 inline auto constexpr find_if =
@@ -473,6 +1136,13 @@ inline auto constexpr find_if_not =
 template <typename T, typename... Elements>
 constexpr auto find_impl(T&& x, Elements&&... elements) -> std::size_t
 {
+    using Value_t = std::remove_cvref_t<T>;
+    if constexpr (detail::simd::is_packable<Value_t, Elements...>) {
+        if (!std::is_constant_evaluated()) {
+            return detail::simd::find(
+                x, std::array<Value_t, sizeof...(Elements)>{elements...});
+        }
+    }
     auto equal_to_x = [&](auto y) { return y == x; };
     return find_if_impl(equal_to_x, std::forward<Elements>(elements)...);
 }
@@ -507,6 +1177,13 @@ inline auto constexpr count_if =
 template <typename T, typename... Elements>
 constexpr auto count_impl(T&& x, Elements&&... elements) -> std::size_t
 {
+    using Value_t = std::remove_cvref_t<T>;
+    if constexpr (detail::simd::is_packable<Value_t, Elements...>) {
+        if (!std::is_constant_evaluated()) {
+            return detail::simd::count(
+                x, std::array<Value_t, sizeof...(Elements)>{elements...});
+        }
+    }
     return count_if_impl([&x](auto y) { return y == x; },
                          std::forward<Elements>(elements)...);
 }
@@ -577,230 +1254,1830 @@ constexpr auto none(Elements&&... elements) -> bool
     return none_of_impl(std::identity{}, std::forward<Elements>(elements)...);
 }
 
-/* ----------------------- adjacent_transform_reduce ------------------------ */
+/* ------------------------------- match_mask ------------------------------- */
+namespace detail {
 
-template <typename T,
-          typename BinaryOp_1,
-          typename BinaryOp_2,
-          typename L,
-          typename R,
-          typename... Tail>
-constexpr auto adjacent_transform_reduce_impl(T init,
-                                              BinaryOp_1&& transform_fn,
-                                              BinaryOp_2&& reduce_fn,
-                                              L&& left,
-                                              R&& right,
-                                              Tail&&... tail) -> T
+/// Number of 64 bit words in a mask of \p N bits, at least one.
+template <std::size_t N>
+inline constexpr auto mask_words = N == 0 ? std::size_t{1} : (N + 63) / 64;
+
+/// Packs eight bytes, each 0 or 1, into the low eight bits, first byte lowest.
+constexpr auto pack_bytes(std::array<std::uint8_t, 8> const& bytes)
+    -> std::uint64_t
 {
-    auto transformed = transform_fn(std::forward<L>(left), right);
-    auto reduced     = reduce_fn(std::move(init), std::move(transformed));
-    if constexpr (sizeof...(Tail) == 0)
-        return reduced;
+    if constexpr (std::endian::native == std::endian::little) {
+        // Byte k lands on bit 56 + k of the product, the other partial
+        // products are too small to carry into the top byte.
+        return (std::bit_cast<std::uint64_t>(bytes) * 0x0102040810204080u) >>
+               56;
+    }
     else {
-        return adjacent_transform_reduce_impl(std::move(reduced), transform_fn,
-                                              reduce_fn, right,
-                                              std::forward<Tail>(tail)...);
+        auto bits = std::uint64_t{0};
+        for (auto k = std::size_t{0}; k < 8; ++k)
+            bits |= std::uint64_t{bytes[k]} << k;
+        return bits;
     }
 }
 
-inline auto constexpr adjacent_transform_reduce = detail::make_curried<5>(
-    [](auto&& a, auto&& b, auto&& c, auto&& d, auto&& e, auto&&... f) {
-        return adjacent_transform_reduce_impl(
-            std::forward<decltype(a)>(a), std::forward<decltype(b)>(b),
-            std::forward<decltype(c)>(c), std::forward<decltype(d)>(d),
-            std::forward<decltype(e)>(e), std::forward<decltype(f)>(f)...);
-    });
-
-/* --------------------------- adjacent_transform --------------------------- */
-template <typename BinaryOp, typename L, typename R, typename... Tail>
-constexpr void adjacent_transform_impl(BinaryOp&& transform_fn,
-                                       L&& left,
-                                       R&& right,
-                                       Tail&&... tail)
-{
-    left = transform_fn(std::forward<L>(left), right);
-    if constexpr (sizeof...(Tail) == 0)
-        return;
-    else {
-        return adjacent_transform_impl(transform_fn, right,
-                                       std::forward<Tail>(tail)...);
+/** Bit i of the result is set if \p predicate is true for element i. Every
+    predicate is evaluated, the results are stored as bytes and packed into
+    bits eight at a time, without branching on them. */
+template <typename UnaryOp, typename... Elements>
+constexpr auto match_words(UnaryOp& predicate, Elements&&... elements)
+    -> std::array<std::uint64_t, mask_words<sizeof...(Elements)>>
+{
+    constexpr auto size = sizeof...(Elements);
+    auto const hits     = std::array<std::uint8_t, (size + 7) / 8 * 8>{
+        static_cast<std::uint8_t>(static_cast<bool>(
+            predicate(std::forward<Elements>(elements))))...};
+    auto words = std::array<std::uint64_t, mask_words<size>>{};
+    for (auto i = std::size_t{0}; i < hits.size(); i += 8) {
+        auto bytes = std::array<std::uint8_t, 8>{};
+        if (std::is_constant_evaluated()) {
+            for (auto k = std::size_t{0}; k < 8; ++k)
+                bytes[k] = hits[i + k];
+        }
+        else {
+            std::memcpy(bytes.data(), hits.data() + i, 8);
+        }
+        words[i / 64] |= pack_bytes(bytes) << (i % 64);
     }
+    return words;
 }
 
-inline auto constexpr adjacent_transform =
-    detail::make_curried<3>([](auto&& a, auto&& b, auto&& c, auto&&... d) {
-        return adjacent_transform_impl(
-            std::forward<decltype(a)>(a), std::forward<decltype(b)>(b),
-            std::forward<decltype(c)>(c), std::forward<decltype(d)>(d)...);
-    });
+}  // namespace detail
 
-/* -------------------------- adjacent_difference --------------------------- */
-template <typename... Elements>
-constexpr void adjacent_difference(Elements&&... elements)
+/** Returns a std::uint64_t for up to 64 elements, otherwise a std::array of
+    std::uint64_t, with bit i of word i / 64 set for element i. */
+template <typename UnaryOp, typename... Elements>
+    requires((std::predicate<UnaryOp, Elements> && ...))
+constexpr auto match_mask_impl(UnaryOp&& predicate, Elements&&... elements)
 {
-    adjacent_transform_impl([](auto const& l, auto const& r) { return r - l; },
-                            std::forward<Elements>(elements)...);
+    auto const words =
+        detail::match_words(predicate, std::forward<Elements>(elements)...);
+    if constexpr (detail::mask_words<sizeof...(Elements)> == 1)
+        return words[0];
+    else
+        return words;
 }
 
-/* ----------------------------- adjacent_find ------------------------------ */
-
+inline auto constexpr match_mask =
+    detail::make_curried<2>([](auto&& a, auto&&... b) {
+        return match_mask_impl(std::forward<decltype(a)>(a),
+                               std::forward<decltype(b)>(b)...);
+    });
+
+/* ------------------------------- branchless ------------------------------- */
+// Versions of the predicate algorithms which evaluate the predicate on every
+// element with match_mask, then answer from the mask with popcount and
+// countr_zero. There is no branch per element, which is faster when the
+// results are unpredictable and the predicate is cheap, but the predicate is
+// called even after the answer is known.
+namespace branchless {
+
+/* ------------------------- branchless::count_if --------------------------- */
+template <typename UnaryOp, typename... Elements>
+    requires((std::predicate<UnaryOp, Elements> && ...))
+constexpr auto count_if_impl(UnaryOp&& predicate, Elements&&... elements)
+    -> std::size_t
+{
+    auto const words = hal::detail::match_words(
+        predicate, std::forward<Elements>(elements)...);
+    auto count = std::size_t{0};
+    for (auto word : words)
+        count += static_cast<std::size_t>(std::popcount(word));
+    return count;
+}
+
+inline auto constexpr count_if =
+    hal::detail::make_curried<2>([](auto&& a, auto&&... b) {
+        return hal::branchless::count_if_impl(std::forward<decltype(a)>(a),
+                                              std::forward<decltype(b)>(b)...);
+    });
+
+/* -------------------------- branchless::all_of ---------------------------- */
+template <typename UnaryOp, typename... Elements>
+    requires((std::predicate<UnaryOp, Elements> && ...))
+constexpr auto all_of_impl(UnaryOp&& predicate, Elements&&... elements) -> bool
+{
+    return branchless::count_if_impl(predicate,
+                                     std::forward<Elements>(elements)...) ==
+           sizeof...(Elements);
+}
+
+inline auto constexpr all_of =
+    hal::detail::make_curried<2>([](auto&& a, auto&&... b) {
+        return hal::branchless::all_of_impl(std::forward<decltype(a)>(a),
+                                            std::forward<decltype(b)>(b)...);
+    });
+
+/* -------------------------- branchless::any_of ---------------------------- */
+template <typename UnaryOp, typename... Elements>
+    requires((std::predicate<UnaryOp, Elements> && ...))
+constexpr auto any_of_impl(UnaryOp&& predicate, Elements&&... elements) -> bool
+{
+    auto const words = hal::detail::match_words(
+        predicate, std::forward<Elements>(elements)...);
+    auto any = std::uint64_t{0};
+    for (auto word : words)
+        any |= word;
+    return any != 0;
+}
+
+inline auto constexpr any_of =
+    hal::detail::make_curried<2>([](auto&& a, auto&&... b) {
+        return hal::branchless::any_of_impl(std::forward<decltype(a)>(a),
+                                            std::forward<decltype(b)>(b)...);
+    });
+
+/* -------------------------- branchless::none_of --------------------------- */
+template <typename UnaryOp, typename... Elements>
+    requires((std::predicate<UnaryOp, Elements> && ...))
+constexpr auto none_of_impl(UnaryOp&& predicate, Elements&&... elements)
+    -> bool
+{
+    return !branchless::any_of_impl(predicate,
+                                    std::forward<Elements>(elements)...);
+}
+
+inline auto constexpr none_of =
+    hal::detail::make_curried<2>([](auto&& a, auto&&... b) {
+        return hal::branchless::none_of_impl(std::forward<decltype(a)>(a),
+                                             std::forward<decltype(b)>(b)...);
+    });
+
+/* -------------------------- branchless::find_if --------------------------- */
+template <typename UnaryOp, typename... Elements>
+    requires((std::predicate<UnaryOp, Elements> && ...))
+constexpr auto find_if_impl(UnaryOp&& predicate, Elements&&... elements)
+    -> std::size_t
+{
+    auto const words = hal::detail::match_words(
+        predicate, std::forward<Elements>(elements)...);
+    for (auto i = std::size_t{0}; i < words.size(); ++i) {
+        if (words[i] != 0) {
+            return i * 64 +
+                   static_cast<std::size_t>(std::countr_zero(words[i]));
+        }
+    }
+    return sizeof...(Elements);
+}
+
+inline auto constexpr find_if =
+    hal::detail::make_curried<2>([](auto&& a, auto&&... b) {
+        return hal::branchless::find_if_impl(std::forward<decltype(a)>(a),
+                                             std::forward<decltype(b)>(b)...);
+    });
+
+}  // namespace branchless
+
+/* ----------------------- adjacent_transform_reduce ------------------------ */
+
+template <typename T,
+          typename BinaryOp_1,
+          typename BinaryOp_2,
+          typename L,
+          typename R,
+          typename... Tail>
+constexpr auto adjacent_transform_reduce_impl(T init,
+                                              BinaryOp_1&& transform_fn,
+                                              BinaryOp_2&& reduce_fn,
+                                              L&& left,
+                                              R&& right,
+                                              Tail&&... tail) -> T
+{
+    auto transformed = transform_fn(std::forward<L>(left), right);
+    auto reduced     = reduce_fn(std::move(init), std::move(transformed));
+    if constexpr (sizeof...(Tail) == 0)
+        return reduced;
+    else {
+        return adjacent_transform_reduce_impl(std::move(reduced), transform_fn,
+                                              reduce_fn, right,
+                                              std::forward<Tail>(tail)...);
+    }
+}
+
+inline auto constexpr adjacent_transform_reduce = detail::make_curried<5>(
+    [](auto&& a, auto&& b, auto&& c, auto&& d, auto&& e, auto&&... f) {
+        return adjacent_transform_reduce_impl(
+            std::forward<decltype(a)>(a), std::forward<decltype(b)>(b),
+            std::forward<decltype(c)>(c), std::forward<decltype(d)>(d),
+            std::forward<decltype(e)>(e), std::forward<decltype(f)>(f)...);
+    });
+
+/* --------------------------- adjacent_transform --------------------------- */
+template <typename BinaryOp, typename L, typename R, typename... Tail>
+constexpr void adjacent_transform_impl(BinaryOp&& transform_fn,
+                                       L&& left,
+                                       R&& right,
+                                       Tail&&... tail)
+{
+    left = transform_fn(std::forward<L>(left), right);
+    if constexpr (sizeof...(Tail) == 0)
+        return;
+    else {
+        return adjacent_transform_impl(transform_fn, right,
+                                       std::forward<Tail>(tail)...);
+    }
+}
+
+inline auto constexpr adjacent_transform =
+    detail::make_curried<3>([](auto&& a, auto&& b, auto&& c, auto&&... d) {
+        return adjacent_transform_impl(
+            std::forward<decltype(a)>(a), std::forward<decltype(b)>(b),
+            std::forward<decltype(c)>(c), std::forward<decltype(d)>(d)...);
+    });
+
+/* -------------------------- adjacent_difference --------------------------- */
+template <typename... Elements>
+constexpr void adjacent_difference(Elements&&... elements)
+{
+    adjacent_transform_impl([](auto const& l, auto const& r) { return r - l; },
+                            std::forward<Elements>(elements)...);
+}
+
+/* ----------------------------- adjacent_find ------------------------------ */
+
+namespace detail {
+template <typename Tuple, std::size_t... I>
+constexpr auto adjacent_find_impl(Tuple const& elements,
+                                  std::index_sequence<I...>) -> std::size_t
+{
+    auto index = std::size_t{0};
+    (void)((std::equal_to<>{}(std::get<I>(elements), std::get<I + 1>(elements))
+                ? true
+                : (++index, false)) ||
+           ...);
+    return index;
+}
+}  // namespace detail
+
 template <typename... Elements>
 constexpr auto adjacent_find(Elements&&... elements) -> std::size_t
 {
-    auto increment_until_true = [still_going = true](std::size_t count,
-                                                     bool found) mutable {
-        return still_going && !found ? count + 1 : (still_going = false, count);
-    };
-    return adjacent_transform_reduce_impl(0uL, std::equal_to<>{},
-                                          increment_until_true,
-                                          std::forward<Elements>(elements)...);
+    static_assert(sizeof...(Elements) > 1,
+                  "adjacent_find requires at least two elements");
+    return detail::adjacent_find_impl(
+        std::forward_as_tuple(elements...),
+        std::make_index_sequence<sizeof...(Elements) - 1>{});
+}
+
+/* ---------------------------------- get ----------------------------------- */
+namespace detail {
+
+/// Accepts and discards any argument, \p I is only used for pack expansion.
+template <std::size_t I>
+struct ignore_arg {
+    constexpr ignore_arg(auto&&) {}
+};
+
+template <typename Indices>
+struct pick;
+
+/// Skips over sizeof...(I) arguments and returns the next one.
+template <std::size_t... I>
+struct pick<std::index_sequence<I...>> {
+    template <typename T>
+    static constexpr auto get(ignore_arg<I>..., T&& x, auto&&...) -> T&&
+    {
+        return std::forward<T>(x);
+    }
+};
+
+}  // namespace detail
+
+template <std::size_t I, typename... Elements>
+constexpr auto get(Elements&&... elements) -> decltype(auto)
+{
+    static_assert(I < sizeof...(Elements),
+                  "Cannot access elements outside of parameter pack");
+    return detail::pick<std::make_index_sequence<I>>::get(
+        std::forward<Elements>(elements)...);
+}
+
+/* --------------------------------- first ---------------------------------- */
+
+template <typename... Elements>
+constexpr auto first(Elements&&... elements) -> decltype(auto)
+{
+    return hal::get<0>(std::forward<Elements>(elements)...);
+}
+
+/* --------------------------------- last ----------------------------------- */
+
+template <typename... Elements>
+constexpr auto last(Elements&&... elements) -> decltype(auto)
+{
+    return hal::get<sizeof...(Elements) - 1>(
+        std::forward<Elements>(elements)...);
+}
+
+/* ------------------------------ partial_sum ------------------------------- */
+
+template <typename... Elements>
+constexpr void partial_sum(Elements&&... elements)
+{
+    if constexpr (sizeof...(Elements) == 0uL)
+        return;
+    using reduce_t =
+        std::decay_t<decltype(hal::first(std::forward<Elements>(elements)...))>;
+    partial_reduce(reduce_t(0),
+                   std::plus<>{})(std::forward<Elements>(elements)...);
+}
+
+namespace memberwise {
+template <typename Aggregate>
+constexpr void partial_sum(Aggregate&& aggregate)
+{
+    constexpr auto size = hal::member_count_v<Aggregate>;
+    if constexpr (size != 0) {
+        std::apply(
+            [](auto&&... elements) {
+                hal::partial_sum(std::forward<decltype(elements)>(elements)...);
+            },
+            hal::to_ref_tuple(std::forward<Aggregate>(aggregate)));
+    }
+}
+}  // namespace memberwise
+
+/* -------------------------- partial_difference ---------------------------- */
+
+template <typename... Elements>
+constexpr void partial_difference(Elements&&... elements)
+{
+    if constexpr (sizeof...(Elements) == 0uL)
+        return;
+    using reduce_t =
+        std::decay_t<decltype(hal::first(std::forward<Elements>(elements)...))>;
+    partial_reduce(reduce_t(0),
+                   std::minus<>{})(std::forward<Elements>(elements)...);
+}
+
+namespace memberwise {
+template <typename Aggregate>
+constexpr void partial_difference(Aggregate&& aggregate)
+{
+    constexpr auto size = hal::member_count_v<Aggregate>;
+    if constexpr (size != 0) {
+        std::apply(
+            [](auto&&... elements) {
+                hal::partial_difference(
+                    std::forward<decltype(elements)>(elements)...);
+            },
+            hal::to_ref_tuple(std::forward<Aggregate>(aggregate)));
+    }
+}
+}  // namespace memberwise
+
+/* --------------------------- partial_product ------------------------------ */
+
+template <typename... Elements>
+constexpr void partial_product(Elements&&... elements)
+{
+    if constexpr (sizeof...(Elements) == 0uL)
+        return;
+    using reduce_t =
+        std::decay_t<decltype(hal::first(std::forward<Elements>(elements)...))>;
+    partial_reduce(reduce_t(1),
+                   std::multiplies<>{})(std::forward<Elements>(elements)...);
+}
+
+namespace memberwise {
+template <typename Aggregate>
+constexpr void partial_product(Aggregate&& aggregate)
+{
+    constexpr auto size = hal::member_count_v<Aggregate>;
+    if constexpr (size != 0) {
+        std::apply(
+            [](auto&&... elements) {
+                hal::partial_product(
+                    std::forward<decltype(elements)>(elements)...);
+            },
+            hal::to_ref_tuple(std::forward<Aggregate>(aggregate)));
+    }
+}
+}  // namespace memberwise
+
+/* --------------------------- partial_quotient ----------------------------- */
+
+template <typename... Elements>
+constexpr void partial_quotient(Elements&&... elements)
+{
+    if constexpr (sizeof...(Elements) == 0uL)
+        return;
+    using reduce_t =
+        std::decay_t<decltype(hal::first(std::forward<Elements>(elements)...))>;
+    partial_reduce(reduce_t(1),
+                   std::divides<>{})(std::forward<Elements>(elements)...);
+}
+
+namespace memberwise {
+template <typename Aggregate>
+constexpr void partial_quotient(Aggregate&& aggregate)
+{
+    constexpr auto size = hal::member_count_v<Aggregate>;
+    if constexpr (size != 0) {
+        std::apply(
+            [](auto&&... elements) {
+                hal::partial_quotient(
+                    std::forward<decltype(elements)>(elements)...);
+            },
+            hal::to_ref_tuple(std::forward<Aggregate>(aggregate)));
+    }
+}
+}  // namespace memberwise
+
+/* --------------------------- memberwise::batch ---------------------------- */
+// Algorithms over a std::span of aggregates, which treat each member as a
+// column. Records are processed in chunks of batch::chunk_size. Within a chunk
+// each member has its own accumulator, so the per-member reductions are
+// independent of each other, and the members of a record are read together.
+// The chunk results are merged in order, so hal::par::memberwise::batch can
+// reduce the chunks on separate threads and get the same result.
+namespace memberwise::batch {
+
+/// Number of records reduced before their result is merged.
+inline constexpr auto chunk_size = std::size_t{1024};
+
+}  // namespace memberwise::batch
+
+namespace detail {
+
+/// A span over the contiguous \p records, of dynamic extent.
+template <typename Range>
+constexpr auto as_span(Range&& records)
+{
+    return std::span{std::data(records), std::size(records)};
+}
+
+template <typename Tuple>
+struct Decay_tuple;
+
+template <typename... Ts>
+struct Decay_tuple<std::tuple<Ts...>> {
+    using type = std::tuple<std::remove_cvref_t<Ts>...>;
+};
+
+/// The member types of \p Aggregate, as a std::tuple of values.
+template <typename Aggregate>
+using Members_t = typename Decay_tuple<decltype(hal::to_ref_tuple(
+    std::declval<Aggregate&>()))>::type;
+
+/** Reduces the non-empty \p records into an aggregate of type \p Result,
+    member by member. Each member starts from the transform of the first
+    record's member. */
+template <typename Result,
+          typename UnaryOp,
+          typename BinaryOp,
+          typename Aggregate>
+constexpr auto batch_reduce_chunk(UnaryOp& transform_fn,
+                                  BinaryOp& reduce_fn,
+                                  std::span<Aggregate> records) -> Result
+{
+    using Accumulators = Members_t<Result>;
+    return [&]<std::size_t... I>(std::index_sequence<I...>)
+    {
+        auto const first = hal::to_ref_tuple(records[0]);
+        auto accumulators =
+            Accumulators{static_cast<std::tuple_element_t<I, Accumulators>>(
+                transform_fn(std::get<I>(first)))...};
+        for (auto i = std::size_t{1}; i < records.size(); ++i) {
+            auto const row = hal::to_ref_tuple(records[i]);
+            ((std::get<I>(accumulators) =
+                  reduce_fn(std::move(std::get<I>(accumulators)),
+                            transform_fn(std::get<I>(row)))),
+             ...);
+        }
+        return Result{std::move(std::get<I>(accumulators))...};
+    }
+    (std::make_index_sequence<hal::member_count_v<Result>>{});
+}
+
+/// Combines \p partial into \p result, member by member.
+template <typename Result, typename BinaryOp>
+constexpr auto batch_merge(BinaryOp& reduce_fn, Result result, Result partial)
+    -> Result
+{
+    return [&]<std::size_t... I>(std::index_sequence<I...>)
+    {
+        auto accumulators = hal::to_ref_tuple(result);
+        auto partials     = hal::to_ref_tuple(partial);
+        ((std::get<I>(accumulators) =
+              reduce_fn(std::move(std::get<I>(accumulators)),
+                        std::move(std::get<I>(partials)))),
+         ...);
+        return result;
+    }
+    (std::make_index_sequence<hal::member_count_v<Result>>{});
+}
+
+/// Calls \p func on each member of \p records, one member at a time.
+template <typename UnaryOp, typename Aggregate>
+constexpr void batch_for_each_chunk(UnaryOp& func,
+                                    std::span<Aggregate> records)
+{
+    [&]<std::size_t... I>(std::index_sequence<I...>)
+    {
+        auto column = [&](auto index) {
+            for (auto& record : records)
+                func(std::get<index>(hal::to_ref_tuple(record)));
+        };
+        (column(std::integral_constant<std::size_t, I>{}), ...);
+    }
+    (std::make_index_sequence<hal::member_count_v<Aggregate>>{});
+}
+
+/// The records of chunk \p index of \p records.
+template <typename Aggregate>
+constexpr auto batch_chunk(std::span<Aggregate> records, std::size_t index)
+    -> std::span<Aggregate>
+{
+    auto const first = index * memberwise::batch::chunk_size;
+    auto const rest  = records.size() - first;
+    return records.subspan(first, rest < memberwise::batch::chunk_size
+                                      ? rest
+                                      : memberwise::batch::chunk_size);
+}
+
+/// Number of chunks \p records is split into.
+template <typename Aggregate>
+constexpr auto batch_chunk_count(std::span<Aggregate> records) -> std::size_t
+{
+    return (records.size() + memberwise::batch::chunk_size - 1) /
+           memberwise::batch::chunk_size;
+}
+
+}  // namespace detail
+
+namespace memberwise::batch {
+
+/* ------------------------ batch::transform_reduce ------------------------- */
+/** Returns an aggregate where each member is the reduction of that member
+    across all of \p records. Member i of the result starts as member i of
+    \p init. reduce_fn must be associative, as records are grouped by chunk. */
+template <typename Result,
+          typename UnaryOp,
+          typename BinaryOp,
+          typename Aggregate>
+    requires(hal::member_count_v<Result> == hal::member_count_v<Aggregate>)
+constexpr auto transform_reduce_impl(Result init,
+                                     UnaryOp&& transform_fn,
+                                     BinaryOp&& reduce_fn,
+                                     std::span<Aggregate> records) -> Result
+{
+    if constexpr (hal::member_count_v<Result> != 0) {
+        auto const chunks = hal::detail::batch_chunk_count(records);
+        for (auto i = std::size_t{0}; i < chunks; ++i) {
+            init = hal::detail::batch_merge(
+                reduce_fn, std::move(init),
+                hal::detail::batch_reduce_chunk<Result>(
+                    transform_fn, reduce_fn,
+                    hal::detail::batch_chunk(records, i)));
+        }
+    }
+    return init;
+}
+
+inline auto constexpr transform_reduce = hal::detail::make_curried<4>(
+    [](auto&& a, auto&& b, auto&& c, auto&& d) {
+        return hal::memberwise::batch::transform_reduce_impl(
+            std::forward<decltype(a)>(a), std::forward<decltype(b)>(b),
+            std::forward<decltype(c)>(c), hal::detail::as_span(d));
+    });
+
+/* ----------------------------- batch::reduce ------------------------------ */
+template <typename Result, typename BinaryOp, typename Aggregate>
+    requires(hal::member_count_v<Result> == hal::member_count_v<Aggregate>)
+constexpr auto reduce_impl(Result init,
+                           BinaryOp&& reduce_fn,
+                           std::span<Aggregate> records) -> Result
+{
+    return batch::transform_reduce_impl(std::move(init), std::identity{},
+                                        reduce_fn, records);
+}
+
+inline auto constexpr reduce =
+    hal::detail::make_curried<3>([](auto&& a, auto&& b, auto&& c) {
+        return hal::memberwise::batch::reduce_impl(
+            std::forward<decltype(a)>(a), std::forward<decltype(b)>(b),
+            hal::detail::as_span(c));
+    });
+
+/* ---------------------------- batch::for_each ----------------------------- */
+/// Calls func on every member of every record, a column at a time per chunk.
+template <typename UnaryOp, typename Aggregate>
+constexpr void for_each_impl(UnaryOp&& func, std::span<Aggregate> records)
+{
+    auto const chunks = hal::detail::batch_chunk_count(records);
+    for (auto i = std::size_t{0}; i < chunks; ++i)
+        hal::detail::batch_for_each_chunk(func,
+                                          hal::detail::batch_chunk(records, i));
+}
+
+inline auto constexpr for_each =
+    hal::detail::make_curried<2>([](auto&& a, auto&& b) {
+        return hal::memberwise::batch::for_each_impl(
+            std::forward<decltype(a)>(a), hal::detail::as_span(b));
+    });
+
+}  // namespace memberwise::batch
+
+/* -------------------------- memberwise::scatter --------------------------- */
+// Copies between a span of aggregates and one span per member. When the
+// aggregate is a square of lanes<T> scalars of one type, blocks of lanes<T>
+// records are transposed in registers with vector shuffles. Other records are
+// copied a row at a time, writing to every column in the same loop, which
+// measured faster than copying a block of records one column at a time.
+namespace detail {
+
+/** Is true if \p Aggregate is laid out as an array of its members, which
+    all have the same scalar type as \p Columns... and fill a register. */
+template <typename Aggregate, typename... Columns>
+constexpr auto is_transposable() -> bool
+{
+    using Members = Members_t<Aggregate>;
+    if constexpr (sizeof...(Columns) == 0) {
+        return false;
+    } else {
+        using T = std::tuple_element_t<0, Members>;
+        return [&]<std::size_t... I>(std::index_sequence<I...>)
+        {
+            return simd::is_transposable<T, sizeof...(I)> &&
+                   std::is_trivially_copyable_v<Aggregate> &&
+                   std::is_standard_layout_v<Aggregate> &&
+                   sizeof(Aggregate) == sizeof(T) * sizeof...(I) &&
+                   (std::is_same_v<T, std::tuple_element_t<I, Members>> &&
+                    ...) &&
+                   (std::is_same_v<T, std::remove_cv_t<Columns>> && ...);
+        }
+        (std::index_sequence_for<Columns...>{});
+    }
+}
+
+/** Copies member i of the records from \p first on into \p columns[i], or
+    the other way around if \p to_records. */
+template <bool to_records, typename Aggregate, typename... Columns>
+constexpr void transpose_rows(std::span<Aggregate> records,
+                              std::size_t first,
+                              std::span<Columns>... columns)
+{
+    for (auto i = first; i < records.size(); ++i) {
+        std::apply(
+            [&](auto&&... members) {
+                if constexpr (to_records)
+                    ((members = columns[i]), ...);
+                else
+                    ((columns[i] = members), ...);
+            },
+            hal::to_ref_tuple(records[i]));
+    }
+}
+
+}  // namespace detail
+
+namespace memberwise {
+
+/** Copies member i of every record into \p columns[i]. Each column must have
+    room for records.size() values. */
+template <typename Aggregate, typename... Columns>
+    requires(hal::member_count_v<Aggregate> == sizeof...(Columns))
+constexpr void scatter_impl(std::span<Aggregate const> records,
+                            std::span<Columns>... columns)
+{
+    assert(((columns.size() >= records.size()) && ...));
+    auto first = std::size_t{0};
+    if constexpr (hal::detail::is_transposable<Aggregate, Columns...>()) {
+        if (!std::is_constant_evaluated()) {
+            using Members = hal::detail::Members_t<Aggregate>;
+            using T       = std::tuple_element_t<0, Members>;
+            first         = hal::detail::simd::scatter<T>(
+                reinterpret_cast<std::byte const*>(records.data()),
+                records.size(), {columns.data()...});
+        }
+    }
+    hal::detail::transpose_rows<false>(records, first, columns...);
+}
+
+/// Scatters the contiguous \p records into the contiguous \p columns...
+template <typename Records, typename... Columns>
+constexpr void scatter(Records const& records, Columns&&... columns)
+{
+    auto const span = hal::detail::as_span(records);
+    using Aggregate =
+        std::remove_const_t<typename decltype(span)::element_type>;
+    memberwise::scatter_impl(std::span<Aggregate const>{span},
+                             hal::detail::as_span(columns)...);
+}
+
+/* --------------------------- memberwise::gather --------------------------- */
+/** Copies \p columns[i][j] into member i of \p records[j], the inverse of
+    scatter. Each column must have at least records.size() values. */
+template <typename Aggregate, typename... Columns>
+    requires(hal::member_count_v<Aggregate> == sizeof...(Columns))
+constexpr void gather_impl(std::span<Aggregate> records,
+                           std::span<Columns>... columns)
+{
+    assert(((columns.size() >= records.size()) && ...));
+    auto first = std::size_t{0};
+    if constexpr (hal::detail::is_transposable<Aggregate, Columns...>()) {
+        if (!std::is_constant_evaluated()) {
+            using Members = hal::detail::Members_t<Aggregate>;
+            using T       = std::tuple_element_t<0, Members>;
+            first         = hal::detail::simd::gather<T>(
+                reinterpret_cast<std::byte*>(records.data()), records.size(),
+                {columns.data()...});
+        }
+    }
+    hal::detail::transpose_rows<true>(records, first, columns...);
+}
+
+/** Gathers the contiguous columns into the contiguous records, which are
+    the last argument. */
+template <typename... Args>
+constexpr void gather(Args&&... args)
+{
+    static_assert(sizeof...(Args) > 0, "gather needs a span of records.");
+    auto const spans = std::tuple{hal::detail::as_span(args)...};
+    [&]<std::size_t... I>(std::index_sequence<I...>)
+    {
+        memberwise::gather_impl(std::get<sizeof...(I)>(spans),
+                                std::get<I>(spans)...);
+    }
+    (std::make_index_sequence<sizeof...(Args) - 1>{});
+}
+
+}  // namespace memberwise
+
+/* ------------------------- memberwise::serialize -------------------------- */
+// A serialized record is its members in order, each as its little endian
+// bytes, with no padding between them. The size of a record only depends on
+// the member types, and the bytes are the same on every platform. When the
+// aggregate is already laid out like that in memory, records are copied with
+// memcpy instead of member by member.
+namespace detail {
+
+/// Is true for an enum with a fixed underlying type, such as a scoped enum.
+template <typename T>
+inline constexpr auto has_fixed_underlying_type = false;
+
+template <typename T>
+    requires(std::is_enum_v<T>)
+inline constexpr auto has_fixed_underlying_type<T> =
+    requires { T{std::underlying_type_t<T>{}}; };
+
+/** Is true for the member types that serialize and deserialize support.
+    Enums need a fixed underlying type, for every value of it to be valid. */
+template <typename T>
+inline constexpr auto is_serializable_member =
+    (std::is_arithmetic_v<T> || has_fixed_underlying_type<T>) &&
+    sizeof(T) <= 8;
+
+template <typename Aggregate, typename Members = Members_t<Aggregate>>
+inline constexpr auto is_serializable = false;
+
+template <typename Aggregate, typename... Members>
+inline constexpr auto is_serializable<Aggregate, std::tuple<Members...>> =
+    (is_serializable_member<Members> && ...);
+
+/// Is true if a member of \p Aggregate is a bool.
+template <typename Aggregate, typename Members = Members_t<Aggregate>>
+inline constexpr auto has_bool_member = false;
+
+template <typename Aggregate, typename... Members>
+inline constexpr auto has_bool_member<Aggregate, std::tuple<Members...>> =
+    (std::is_same_v<Members, bool> || ...);
+
+/// Offset of each member in a serialized \p Aggregate, and its total size.
+template <typename Aggregate, typename Members = Members_t<Aggregate>>
+inline constexpr auto serialized_offsets = std::array<std::size_t, 1>{};
+
+template <typename Aggregate, typename... Members>
+inline constexpr auto
+    serialized_offsets<Aggregate, std::tuple<Members...>> = [] {
+        auto offsets = std::array<std::size_t, sizeof...(Members) + 1>{};
+        auto i       = std::size_t{0};
+        ((offsets[i + 1] = offsets[i] + sizeof(Members), ++i), ...);
+        return offsets;
+    }();
+
+/// Writes the little endian bytes of \p value to \p out.
+template <typename T>
+constexpr void store_little_endian(T value, std::byte* out)
+{
+    auto const bytes = std::bit_cast<std::array<std::byte, sizeof(T)>>(value);
+    for (auto i = std::size_t{0}; i < sizeof(T); ++i) {
+        out[i] = bytes[std::endian::native == std::endian::little
+                           ? i
+                           : sizeof(T) - 1 - i];
+    }
+}
+
+/** Reads a \p T from the little endian bytes at \p in. A bool is true for
+    any byte other than 0, as bytes from a file may not be a valid bool. */
+template <typename T>
+constexpr auto load_little_endian(std::byte const* in) -> T
+{
+    if constexpr (std::is_same_v<T, bool>)
+        return in[0] != std::byte{0};
+    else {
+        auto bytes = std::array<std::byte, sizeof(T)>{};
+        for (auto i = std::size_t{0}; i < sizeof(T); ++i) {
+            bytes[std::endian::native == std::endian::little
+                      ? i
+                      : sizeof(T) - 1 - i] = in[i];
+        }
+        return std::bit_cast<T>(bytes);
+    }
+}
+
+}  // namespace detail
+
+namespace memberwise {
+
+/// Number of bytes in a serialized \p Aggregate.
+template <typename Aggregate>
+    requires(hal::detail::is_serializable<Aggregate>)
+inline constexpr auto serialized_size_v =
+    hal::detail::serialized_offsets<Aggregate>.back();
+
+/** Is true if the bytes of \p Aggregate in memory are already its serialized
+    bytes, and any serialized bytes are a valid \p Aggregate, so records can
+    be copied or mapped without conversion. Not for aggregates with a bool
+    member, which must be read member by member, as only 0 and 1 are valid
+    bools. */
+template <typename Aggregate>
+    requires(hal::detail::is_serializable<Aggregate>)
+inline constexpr auto is_serialized_layout_v =
+    std::endian::native == std::endian::little &&
+    std::is_trivially_copyable_v<Aggregate> &&
+    std::is_standard_layout_v<Aggregate> &&
+    sizeof(Aggregate) == serialized_size_v<Aggregate> &&
+    !hal::detail::has_bool_member<Aggregate>;
+
+/** Writes the members of \p aggregate to the first serialized_size_v bytes
+    of \p bytes, which must be at least that long. */
+template <typename Aggregate>
+    requires(hal::detail::is_serializable<Aggregate>)
+constexpr void serialize(Aggregate const& aggregate, std::span<std::byte> bytes)
+{
+    assert(bytes.size() >= serialized_size_v<Aggregate>);
+    if constexpr (is_serialized_layout_v<Aggregate>) {
+        if (!std::is_constant_evaluated()) {
+            std::memcpy(bytes.data(), &aggregate, sizeof(Aggregate));
+            return;
+        }
+    }
+    constexpr auto& offsets = hal::detail::serialized_offsets<Aggregate>;
+    std::apply(
+        [&](auto const&... members) {
+            auto i = std::size_t{0};
+            (hal::detail::store_little_endian(members,
+                                              bytes.data() + offsets[i++]),
+             ...);
+        },
+        hal::to_ref_tuple(aggregate));
+}
+
+/** Reads an \p Aggregate from the first serialized_size_v bytes of \p bytes,
+    which must be at least that long, the inverse of serialize. */
+template <typename Aggregate>
+    requires(hal::detail::is_serializable<Aggregate>)
+constexpr auto deserialize(std::span<std::byte const> bytes) -> Aggregate
+{
+    assert(bytes.size() >= serialized_size_v<Aggregate>);
+    if constexpr (is_serialized_layout_v<Aggregate>) {
+        if (!std::is_constant_evaluated()) {
+            auto result = Aggregate{};
+            std::memcpy(&result, bytes.data(), sizeof(Aggregate));
+            return result;
+        }
+    }
+    using Members           = hal::detail::Members_t<Aggregate>;
+    constexpr auto& offsets = hal::detail::serialized_offsets<Aggregate>;
+    return [&]<std::size_t... I>(std::index_sequence<I...>)
+    {
+        return hal::from_tuple<Aggregate>(
+            std::tuple{hal::detail::load_little_endian<
+                std::tuple_element_t<I, Members>>(bytes.data() +
+                                                  offsets[I])...});
+    }
+    (std::make_index_sequence<std::tuple_size_v<Members>>{});
+}
+
+}  // namespace memberwise
+
+/* ------------------------- memberwise::byteswap --------------------------- */
+// Reverses the bytes of each member of an aggregate, for converting wire
+// structs between network and native byte order. Members of one byte are
+// left alone, and std::array members are swapped element by element. Spans
+// of records laid out without over-aligned members are swapped with byte
+// shuffles, a register of records at a time.
+namespace detail {
+
+/// \p value with its bytes in reverse order, std::byteswap before C++23.
+template <typename T>
+constexpr auto byteswap(T value) -> T
+{
+    if constexpr (sizeof(T) == 1)
+        return value;
+    else {
+        using U = std::conditional_t<
+            sizeof(T) == 2, std::uint16_t,
+            std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>;
+        auto bits = std::bit_cast<U>(value);
+#if defined(__cpp_lib_byteswap)
+        bits = std::byteswap(bits);
+#elif defined(__GNUC__) || defined(__clang__)
+        if constexpr (sizeof(T) == 2)
+            bits = __builtin_bswap16(bits);
+        else if constexpr (sizeof(T) == 4)
+            bits = __builtin_bswap32(bits);
+        else
+            bits = __builtin_bswap64(bits);
+#else
+        auto swapped = U{0};
+        for (auto i = std::size_t{0}; i < sizeof(T); ++i, bits >>= 8)
+            swapped = static_cast<U>(swapped << 8 | (bits & 0xFF));
+        bits = swapped;
+#endif
+        return std::bit_cast<T>(bits);
+    }
+}
+
+template <typename T>
+inline constexpr auto is_std_array = false;
+
+template <typename T, std::size_t N>
+inline constexpr auto is_std_array<std::array<T, N>> = true;
+
+/// Is true if \p T has std::data and std::size, so is viewed as a span.
+template <typename T>
+inline constexpr auto is_contiguous_range = requires(T& range) {
+    std::data(range);
+    std::size(range);
+};
+
+/// Is true for the member types that byteswap supports.
+template <typename T>
+inline constexpr auto is_byteswappable_member =
+    (std::is_arithmetic_v<T> || std::is_enum_v<T>) &&
+    (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+template <typename T, std::size_t N>
+inline constexpr auto is_byteswappable_member<std::array<T, N>> =
+    is_byteswappable_member<T>;
+
+template <typename Aggregate, typename Members = Members_t<Aggregate>>
+inline constexpr auto is_byteswappable = false;
+
+template <typename Aggregate, typename... Members>
+inline constexpr auto is_byteswappable<Aggregate, std::tuple<Members...>> =
+    (is_byteswappable_member<Members> && ...);
+
+template <typename T>
+constexpr auto byteswap_member(T const& member) -> T
+{
+    if constexpr (is_std_array<T>) {
+        auto result = member;
+        for (auto& element : result)
+            element = detail::byteswap_member(element);
+        return result;
+    }
+    else
+        return detail::byteswap(member);
+}
+
+/// Sets the bytes of \p T at \p offset in \p pattern to their swapped ones.
+template <typename T, std::size_t N>
+constexpr void byteswap_pattern(std::array<std::size_t, N>& pattern,
+                                std::size_t offset)
+{
+    if constexpr (is_std_array<T>) {
+        using Element = typename T::value_type;
+        for (auto i = std::size_t{0}; i < std::tuple_size_v<T>; ++i)
+            detail::byteswap_pattern<Element>(pattern,
+                                              offset + i * sizeof(Element));
+    }
+    else {
+        for (auto i = std::size_t{0}; i < sizeof(T); ++i)
+            pattern[offset + i] = offset + sizeof(T) - 1 - i;
+    }
+}
+
+/** Where each byte of a byteswapped \p Aggregate comes from, assuming each
+    member is at the next offset aligned to its type. Padding stays put. */
+template <typename Aggregate, typename... Members>
+constexpr auto byteswap_layout(std::tuple<Members...> const*)
+{
+    struct Layout {
+        std::array<std::size_t, sizeof(Aggregate)> pattern;
+        bool natural;
+    };
+    auto layout = Layout{};
+    for (auto i = std::size_t{0}; i < sizeof(Aggregate); ++i)
+        layout.pattern[i] = i;
+    auto offset = std::size_t{0};
+    ((offset = (offset + alignof(Members) - 1) / alignof(Members) *
+               alignof(Members),
+      detail::byteswap_pattern<Members>(layout.pattern, offset),
+      offset += sizeof(Members)),
+     ...);
+    auto align = std::size_t{1};
+    ((align = alignof(Members) > align ? alignof(Members) : align), ...);
+    offset = (offset + align - 1) / align * align;
+    // Over-aligned or packed members change alignof(Aggregate) or its size.
+    layout.natural = offset == sizeof(Aggregate) &&
+                     align == alignof(Aggregate) &&
+                     std::is_standard_layout_v<Aggregate> &&
+                     std::is_trivially_copyable_v<Aggregate>;
+    return layout;
+}
+
+template <typename Aggregate>
+inline constexpr auto byteswap_layout_v = detail::byteswap_layout<Aggregate>(
+    static_cast<Members_t<Aggregate> const*>(nullptr));
+
+}  // namespace detail
+
+namespace detail::simd {
+
+// Byte shuffles with pshufb need SSSE3, SSE2 alone has none.
+#if defined(__SSSE3__) || defined(__ARM_NEON)
+inline constexpr auto has_byte_shuffle = has_shuffle;
+#else
+inline constexpr auto has_byte_shuffle = false;
+#endif
+
+/** Where each byte of a stream of byteswapped \p Aggregate comes from, over
+    the shortest run of whole registers that holds whole records. */
+template <typename Aggregate>
+inline constexpr auto byteswap_stream = [] {
+    constexpr auto size = sizeof(Aggregate);
+    constexpr auto run  = [] {
+        auto a = size;
+        for (auto b = width; b != 0;)
+            a = std::exchange(b, a % b);
+        return size / a * width;
+    }();
+    auto const& record = byteswap_layout_v<Aggregate>.pattern;
+    auto stream        = std::array<std::size_t, run>{};
+    for (auto i = std::size_t{0}; i < run; ++i)
+        stream[i] = i / size * size + record[i % size];
+    return stream;
+}();
+
+/** Is true if spans of \p Aggregate are byteswapped with byte shuffles, in
+    at most 16 registers per run. AVX2 shuffles bytes within 16 byte halves,
+    which naturally aligned members never cross. */
+template <typename Aggregate>
+inline constexpr auto is_byteswap_shufflable = [] {
+    if constexpr (width == 0 || !has_byte_shuffle ||
+                  !byteswap_layout_v<Aggregate>.natural)
+        return false;
+    else {
+        constexpr auto& stream = byteswap_stream<Aggregate>;
+        auto in_lane           = stream.size() <= 16 * width;
+        for (auto i = std::size_t{0}; i < stream.size(); ++i)
+            in_lane = in_lane && stream[i] / 16 == i / 16;
+        return in_lane;
+    }
+}();
+
+template <typename Aggregate, std::size_t K, typename Byte, std::size_t... I>
+void byteswap_register(Byte* bytes, std::index_sequence<I...>)
+{
+    constexpr auto& stream = byteswap_stream<Aggregate>;
+    auto v                 = simd::load(bytes + K * width);
+    v = __builtin_shufflevector(v, v, (stream[K * width + I] - K * width)...);
+    std::memcpy(bytes + K * width, &v, sizeof(v));
+}
+
+/** Byteswaps the \p count records of \p Aggregate at \p bytes a run of
+    registers at a time, and returns the number of records swapped, the
+    rest don't fill a run. */
+template <typename Aggregate, std::size_t... K>
+auto byteswap_records(unsigned char* bytes,
+                      std::size_t count,
+                      std::index_sequence<K...>) -> std::size_t
+{
+    constexpr auto run     = byteswap_stream<Aggregate>.size();
+    constexpr auto records = run / sizeof(Aggregate);
+    constexpr auto indices = std::make_index_sequence<width>{};
+    auto const whole       = count - count % records;
+    for (auto i = std::size_t{0}; i < whole; i += records) {
+        auto* const first = bytes + i * sizeof(Aggregate);
+        (simd::byteswap_register<Aggregate, K>(first, indices), ...);
+    }
+    return whole;
+}
+
+}  // namespace detail::simd
+
+namespace memberwise {
+
+/// \p aggregate with the bytes of each member in reverse order.
+template <typename Aggregate>
+    requires(!hal::detail::is_contiguous_range<Aggregate>) &&
+            (hal::detail::is_byteswappable<Aggregate>)
+constexpr auto byteswap(Aggregate const& aggregate) -> Aggregate
+{
+    return std::apply(
+        [](auto const&... members) {
+            return hal::from_tuple<Aggregate>(
+                std::tuple{hal::detail::byteswap_member(members)...});
+        },
+        hal::to_ref_tuple(aggregate));
+}
+
+/** Reverses the bytes of each member of each of \p records, in place. Uses
+    byte shuffles when the members are naturally aligned and none crosses a
+    16 byte boundary of the records laid end to end. */
+template <typename Aggregate>
+    requires(hal::detail::is_byteswappable<Aggregate>)
+constexpr void byteswap_impl(std::span<Aggregate> records)
+{
+    auto first = std::size_t{0};
+    if constexpr (hal::detail::simd::is_byteswap_shufflable<Aggregate>) {
+        if (!std::is_constant_evaluated()) {
+            constexpr auto registers =
+                hal::detail::simd::byteswap_stream<Aggregate>.size() /
+                hal::detail::simd::width;
+            first = hal::detail::simd::byteswap_records<Aggregate>(
+                reinterpret_cast<unsigned char*>(records.data()),
+                records.size(), std::make_index_sequence<registers>{});
+        }
+    }
+    for (auto i = first; i < records.size(); ++i)
+        records[i] = memberwise::byteswap(std::as_const(records[i]));
+}
+
+template <typename Records>
+    requires(hal::detail::is_contiguous_range<Records>)
+constexpr void byteswap(Records&& records)
+{
+    memberwise::byteswap_impl(hal::detail::as_span(records));
+}
+
+/// \p aggregate from network byte order, big endian, to native byte order.
+template <typename Aggregate>
+    requires(!hal::detail::is_contiguous_range<Aggregate>) &&
+            (hal::detail::is_byteswappable<Aggregate>)
+constexpr auto to_native_endian(Aggregate const& aggregate) -> Aggregate
+{
+    if constexpr (std::endian::native == std::endian::big)
+        return aggregate;
+    else
+        return memberwise::byteswap(aggregate);
+}
+
+/// Converts \p records from network to native byte order, in place.
+template <typename Records>
+    requires(hal::detail::is_contiguous_range<Records>)
+constexpr void to_native_endian(Records&& records)
+{
+    if constexpr (std::endian::native != std::endian::big)
+        memberwise::byteswap_impl(hal::detail::as_span(records));
+}
+
+/// \p aggregate from native byte order to network byte order, big endian.
+template <typename Aggregate>
+    requires(!hal::detail::is_contiguous_range<Aggregate>) &&
+            (hal::detail::is_byteswappable<Aggregate>)
+constexpr auto to_network_endian(Aggregate const& aggregate) -> Aggregate
+{
+    return memberwise::to_native_endian(aggregate);
+}
+
+/// Converts \p records from native to network byte order, in place.
+template <typename Records>
+    requires(hal::detail::is_contiguous_range<Records>)
+constexpr void to_network_endian(Records&& records)
+{
+    memberwise::to_native_endian(records);
+}
+
+}  // namespace memberwise
+
+/* -------------------------- memberwise::compare --------------------------- */
+// Compares aggregates member by member, in declaration order, stopping at the
+// first member that differs. Aggregates whose bytes are their value, integers
+// and enums without padding, are compared for equality with one memcmp, and
+// members that are arrays of unsigned bytes, such as fixed width symbols, are
+// ordered with memcmp.
+namespace detail {
+
+template <typename T>
+inline constexpr auto is_bitwise_comparable_member =
+    std::is_integral_v<T> || std::is_enum_v<T>;
+
+template <typename T, std::size_t N>
+inline constexpr auto is_bitwise_comparable_member<std::array<T, N>> =
+    is_bitwise_comparable_member<T>;
+
+/** Is true if two \p Aggregate are equal exactly when their bytes are: all
+    members are integers, enums or std::arrays of them, and there is no
+    padding. */
+template <typename Aggregate, typename Members = Members_t<Aggregate>>
+inline constexpr auto is_bitwise_comparable = false;
+
+template <typename Aggregate, typename... Members>
+inline constexpr auto is_bitwise_comparable<Aggregate, std::tuple<Members...>> =
+    std::has_unique_object_representations_v<Aggregate> &&
+    (is_bitwise_comparable_member<Members> && ...);
+
+/// Is true for types that memcmp orders the same as operator<.
+template <typename T>
+inline constexpr auto is_bytewise_ordered =
+    sizeof(T) == 1 && (std::is_unsigned_v<T> || std::is_same_v<T, std::byte>);
+
+template <typename T, std::size_t N>
+inline constexpr auto is_bytewise_ordered<std::array<T, N>> =
+    is_bytewise_ordered<T>;
+
+template <typename T>
+inline constexpr auto is_tuple_like =
+    requires { std::tuple_size<std::remove_cvref_t<T>>::value; };
+
+/// Three way comparison of \p a and \p b, with memcmp for arrays of bytes.
+template <typename T, typename U>
+constexpr auto compare_element(T const& a, U const& b)
+{
+    if constexpr (std::is_same_v<T, U> && is_std_array<T> &&
+                  is_bytewise_ordered<T>) {
+        if (!std::is_constant_evaluated())
+            return std::memcmp(a.data(), b.data(), sizeof(T)) <=> 0;
+    }
+    return std::compare_three_way{}(a, b);
+}
+
+/// Compares the elements of \p a and \p b in order, up to the first unequal.
+template <typename Ordering, typename A, typename B, std::size_t... I>
+constexpr auto compare_elements(A const& a,
+                                B const& b,
+                                std::index_sequence<I...>) -> Ordering
+{
+    auto result = Ordering::equivalent;
+    (void)(((result = detail::compare_element(std::get<I>(a), std::get<I>(b))),
+            result == 0) &&
+           ...);
+    return result;
+}
+
+}  // namespace detail
+
+/** Is true if each element of the tuple-like \p a equals the element of \p b
+    at the same index. Stops at the first that doesn't. */
+template <typename A, typename B>
+    requires(hal::detail::is_tuple_like<A> && hal::detail::is_tuple_like<B> &&
+             std::tuple_size_v<A> == std::tuple_size_v<B>)
+constexpr auto equal(A const& a, B const& b) -> bool
+{
+    return [&]<std::size_t... I>(std::index_sequence<I...>)
+    {
+        return ((std::get<I>(a) == std::get<I>(b)) && ...);
+    }
+    (std::make_index_sequence<std::tuple_size_v<A>>{});
+}
+
+/** Lexicographic three way comparison of the elements of the tuple-like \p a
+    and \p b. Returns the common comparison category of the elements, such as
+    std::partial_ordering if one is a floating point number. */
+template <typename A, typename B>
+    requires(hal::detail::is_tuple_like<A> && hal::detail::is_tuple_like<B> &&
+             std::tuple_size_v<A> == std::tuple_size_v<B>)
+constexpr auto compare(A const& a, B const& b)
+{
+    return [&]<std::size_t... I>(std::index_sequence<I...>)
+    {
+        using Ordering = std::common_comparison_category_t<
+            std::compare_three_way_result_t<std::tuple_element_t<I, A>,
+                                            std::tuple_element_t<I, B>>...>;
+        return hal::detail::compare_elements<Ordering>(
+            a, b, std::index_sequence<I...>{});
+    }
+    (std::make_index_sequence<std::tuple_size_v<A>>{});
+}
+
+/// Is true if \p a orders before \p b lexicographically.
+template <typename A, typename B>
+    requires(hal::detail::is_tuple_like<A> && hal::detail::is_tuple_like<B> &&
+             std::tuple_size_v<A> == std::tuple_size_v<B>)
+constexpr auto less(A const& a, B const& b) -> bool
+{
+    return hal::compare(a, b) < 0;
+}
+
+namespace memberwise {
+
+/** Is true if each member of \p a equals the same member of \p b. Stops at
+    the first that doesn't, or compares the bytes with one memcmp when
+    is_bitwise_comparable. Floating point members compare as with ==, so
+    NaNs are never equal and 0.0 equals -0.0. */
+template <typename Aggregate>
+constexpr auto equal(Aggregate const& a, Aggregate const& b) -> bool
+{
+    if constexpr (hal::detail::is_bitwise_comparable<Aggregate>) {
+        if (!std::is_constant_evaluated())
+            return std::memcmp(&a, &b, sizeof(Aggregate)) == 0;
+    }
+    return hal::equal(hal::to_ref_tuple(a), hal::to_ref_tuple(b));
 }
 
-/* ---------------------------------- get ----------------------------------- */
+/** Lexicographic three way comparison of the members of \p a and \p b, in
+    declaration order, as a defaulted operator<=> would. */
+template <typename Aggregate>
+constexpr auto compare(Aggregate const& a, Aggregate const& b)
+{
+    return hal::compare(hal::to_ref_tuple(a), hal::to_ref_tuple(b));
+}
 
-template <std::size_t I, typename... Elements>
-constexpr auto get(Elements&&... elements) -> decltype(auto)
+/// Is true if \p a orders before \p b, comparing members in order.
+template <typename Aggregate>
+constexpr auto less(Aggregate const& a, Aggregate const& b) -> bool
 {
-    static_assert(I < sizeof...(Elements),
-                  "Cannot access elements outside of parameter pack");
-    return std::get<I>(
-        std::forward_as_tuple(std::forward<Elements>(elements)...));
+    return memberwise::compare(a, b) < 0;
 }
 
-/* --------------------------------- first ---------------------------------- */
+}  // namespace memberwise
 
-template <typename... Elements>
-constexpr auto first(Elements&&... elements) -> decltype(auto)
+/* ---------------------------- memberwise::copy ---------------------------- */
+// Copies, moves, swaps, resets and relocates aggregates, one at a time or a
+// span of records at a time. Trivially copyable aggregates are handled as
+// bytes, with memcpy and memset over whole spans, others member by member
+// with each member's own assignment.
+namespace detail {
+
+/// Calls fn(to_member, from_member) for each member of \p to and \p from.
+template <typename To, typename From, typename Fn>
+constexpr void for_each_member_pair(To& to, From& from, Fn fn)
+{
+    std::apply(
+        [&](auto&&... to_members) {
+            std::apply(
+                [&](auto&&... from_members) {
+                    (fn(to_members, from_members), ...);
+                },
+                hal::to_ref_tuple(from));
+        },
+        hal::to_ref_tuple(to));
+}
+
+}  // namespace detail
+
+namespace memberwise {
+
+/** Is true if a \p T can be moved to new storage, and the old storage
+    released without running its destructor, by copying its bytes. True for
+    trivially copyable types, and arrays of trivially relocatable types. A
+    type with a destructor or move constructor of its own may rely on its
+    address, so this is only true for other types, such as std::unique_ptr
+    or an aggregate holding one, where it is specialized. Most standard
+    libraries' std::unique_ptr and std::vector are trivially relocatable, but
+    not the std::string of libstdc++, which points into itself. */
+template <typename T>
+struct is_trivially_relocatable
+    : std::bool_constant<std::is_trivially_copyable_v<T>> {
+};
+
+template <typename T, std::size_t N>
+struct is_trivially_relocatable<T[N]> : is_trivially_relocatable<T> {
+};
+
+template <typename T, std::size_t N>
+struct is_trivially_relocatable<std::array<T, N>>
+    : is_trivially_relocatable<T> {
+};
+
+template <typename T>
+inline constexpr auto is_trivially_relocatable_v =
+    is_trivially_relocatable<std::remove_cv_t<T>>::value;
+
+}  // namespace memberwise
+
+namespace detail {
+
+/// Is true if a value initialized \p Aggregate is all zero bytes.
+template <typename Aggregate, typename Members = Members_t<Aggregate>>
+inline constexpr auto is_zero_initialized = false;
+
+template <typename Aggregate, typename... Members>
+inline constexpr auto is_zero_initialized<Aggregate, std::tuple<Members...>> =
+    std::is_trivially_copyable_v<Aggregate> &&
+    std::is_trivially_default_constructible_v<Aggregate> &&
+    ((std::is_arithmetic_v<Members> || std::is_enum_v<Members> ||
+      std::is_pointer_v<Members> || is_std_array<Members>) &&
+     ...);
+
+}  // namespace detail
+
+namespace memberwise {
+
+/// Assigns each member of \p from to the same member of \p to.
+template <typename Aggregate>
+    requires(!hal::detail::is_contiguous_range<Aggregate>)
+constexpr void copy(Aggregate const& from, Aggregate& to)
+{
+    if constexpr (std::is_trivially_copyable_v<Aggregate>) {
+        if (!std::is_constant_evaluated()) {
+            // memmove, as from and to may be the same aggregate.
+            std::memmove(&to, &from, sizeof(Aggregate));
+            return;
+        }
+    }
+    hal::detail::for_each_member_pair(
+        to, from, [](auto& to_member, auto const& from_member) {
+            to_member = from_member;
+        });
+}
+
+/** Copies each of \p from to the record at the same index of \p to, which
+    must be at least as long. With one memcpy if the records are trivially
+    copyable. */
+template <typename Aggregate>
+constexpr void copy_impl(std::span<Aggregate const> from,
+                         std::span<Aggregate> to)
+{
+    assert(to.size() >= from.size());
+    if constexpr (std::is_trivially_copyable_v<Aggregate>) {
+        if (!std::is_constant_evaluated()) {
+            if (!from.empty())
+                std::memmove(to.data(), from.data(), from.size_bytes());
+            return;
+        }
+    }
+    for (auto i = std::size_t{0}; i < from.size(); ++i)
+        memberwise::copy(from[i], to[i]);
+}
+
+template <typename From, typename To>
+    requires(hal::detail::is_contiguous_range<From> &&
+             hal::detail::is_contiguous_range<To>)
+constexpr void copy(From&& from, To&& to)
 {
-    return hal::get<0>(std::forward<Elements>(elements)...);
+    auto const source = hal::detail::as_span(from);
+    using Aggregate   = std::remove_const_t<
+        typename decltype(source)::element_type>;
+    memberwise::copy_impl(std::span<Aggregate const>{source},
+                          hal::detail::as_span(to));
 }
 
-/* --------------------------------- last ----------------------------------- */
+/// Move assigns each member of \p from to the same member of \p to.
+template <typename Aggregate>
+    requires(!hal::detail::is_contiguous_range<Aggregate>)
+constexpr void move(Aggregate& from, Aggregate& to)
+{
+    if constexpr (std::is_trivially_copyable_v<Aggregate>)
+        memberwise::copy(std::as_const(from), to);
+    else {
+        hal::detail::for_each_member_pair(
+            to, from, [](auto& to_member, auto& from_member) {
+                to_member = std::move(from_member);
+            });
+    }
+}
 
-template <typename... Elements>
-constexpr auto last(Elements&&... elements) -> decltype(auto)
+/** Moves each of \p from to the record at the same index of \p to, which
+    must be at least as long. */
+template <typename Aggregate>
+constexpr void move_impl(std::span<Aggregate> from, std::span<Aggregate> to)
 {
-    return hal::get<sizeof...(Elements) - 1>(
-        std::forward<Elements>(elements)...);
+    assert(to.size() >= from.size());
+    if constexpr (std::is_trivially_copyable_v<Aggregate>)
+        memberwise::copy_impl(std::span<Aggregate const>{from}, to);
+    else {
+        for (auto i = std::size_t{0}; i < from.size(); ++i)
+            memberwise::move(from[i], to[i]);
+    }
 }
 
-/* ------------------------------ partial_sum ------------------------------- */
+template <typename From, typename To>
+    requires(hal::detail::is_contiguous_range<From> &&
+             hal::detail::is_contiguous_range<To>)
+constexpr void move(From&& from, To&& to)
+{
+    memberwise::move_impl(hal::detail::as_span(from),
+                          hal::detail::as_span(to));
+}
 
-template <typename... Elements>
-constexpr void partial_sum(Elements&&... elements)
+/// Swaps each member of \p a with the same member of \p b.
+template <typename Aggregate>
+    requires(!hal::detail::is_contiguous_range<Aggregate>)
+constexpr void swap(Aggregate& a, Aggregate& b)
+{
+    if constexpr (std::is_trivially_copyable_v<Aggregate>) {
+        if (!std::is_constant_evaluated()) {
+            if (&a == &b)
+                return;
+            unsigned char temporary[sizeof(Aggregate)];
+            std::memcpy(temporary, &a, sizeof(Aggregate));
+            std::memcpy(&a, &b, sizeof(Aggregate));
+            std::memcpy(&b, temporary, sizeof(Aggregate));
+            return;
+        }
+    }
+    hal::detail::for_each_member_pair(a, b, [](auto& x, auto& y) {
+        using std::swap;
+        swap(x, y);
+    });
+}
+
+/** Swaps each of \p a with the record at the same index of \p b, which must
+    be at least as long, and either start at \p a or not overlap it. Trivially
+    copyable records are swapped as bytes, through a buffer of a few cache
+    lines. */
+template <typename Aggregate>
+constexpr void swap_impl(std::span<Aggregate> a, std::span<Aggregate> b)
+{
+    assert(b.size() >= a.size());
+    if constexpr (std::is_trivially_copyable_v<Aggregate>) {
+        if (!std::is_constant_evaluated()) {
+            if (a.data() == b.data())
+                return;
+            auto* x          = reinterpret_cast<unsigned char*>(a.data());
+            auto* y          = reinterpret_cast<unsigned char*>(b.data());
+            auto const bytes = a.size_bytes();
+            constexpr auto buffer_size = std::size_t{256};
+            unsigned char buffer[buffer_size];
+            for (auto i = std::size_t{0}; i < bytes; i += buffer_size) {
+                auto const size =
+                    bytes - i < buffer_size ? bytes - i : buffer_size;
+                std::memcpy(buffer, x + i, size);
+                std::memcpy(x + i, y + i, size);
+                std::memcpy(y + i, buffer, size);
+            }
+            return;
+        }
+    }
+    for (auto i = std::size_t{0}; i < a.size(); ++i)
+        memberwise::swap(a[i], b[i]);
+}
+
+template <typename A, typename B>
+    requires(hal::detail::is_contiguous_range<A> &&
+             hal::detail::is_contiguous_range<B>)
+constexpr void swap(A&& a, B&& b)
 {
-    if constexpr (sizeof...(Elements) == 0uL)
-        return;
-    using reduce_t =
-        std::decay_t<decltype(hal::first(std::forward<Elements>(elements)...))>;
-    partial_reduce(reduce_t(0),
-                   std::plus<>{})(std::forward<Elements>(elements)...);
+    memberwise::swap_impl(hal::detail::as_span(a), hal::detail::as_span(b));
 }
 
-namespace memberwise {
+/** Assigns each member of \p aggregate its value in a value initialized
+    Aggregate, so default member initializers apply. */
 template <typename Aggregate>
-constexpr void partial_sum(Aggregate&& aggregate)
+    requires(!hal::detail::is_contiguous_range<Aggregate>)
+constexpr void reset(Aggregate& aggregate)
 {
-    constexpr auto size =
-        std::tuple_size_v<decltype(hal::to_ref_tuple(aggregate))>;
-    if constexpr (size != 0) {
-        std::apply(
-            [](auto&&... elements) {
-                hal::partial_sum(std::forward<decltype(elements)>(elements)...);
-            },
-            hal::to_ref_tuple(std::forward<Aggregate>(aggregate)));
+    if constexpr (hal::detail::is_zero_initialized<Aggregate>) {
+        if (!std::is_constant_evaluated()) {
+            std::memset(&aggregate, 0, sizeof(Aggregate));
+            return;
+        }
     }
+    auto initial = Aggregate{};
+    memberwise::move(initial, aggregate);
 }
-}  // namespace memberwise
 
-/* -------------------------- partial_difference ---------------------------- */
+/** Resets each of \p records, with one memset when a value initialized
+    record is all zero bytes. */
+template <typename Aggregate>
+constexpr void reset_impl(std::span<Aggregate> records)
+{
+    if constexpr (hal::detail::is_zero_initialized<Aggregate>) {
+        if (!std::is_constant_evaluated()) {
+            if (!records.empty())
+                std::memset(records.data(), 0, records.size_bytes());
+            return;
+        }
+    }
+    for (auto& record : records)
+        memberwise::reset(record);
+}
 
-template <typename... Elements>
-constexpr void partial_difference(Elements&&... elements)
+template <typename Records>
+    requires(hal::detail::is_contiguous_range<Records>)
+constexpr void reset(Records&& records)
 {
-    if constexpr (sizeof...(Elements) == 0uL)
-        return;
-    using reduce_t =
-        std::decay_t<decltype(hal::first(std::forward<Elements>(elements)...))>;
-    partial_reduce(reduce_t(0),
-                   std::minus<>{})(std::forward<Elements>(elements)...);
+    memberwise::reset_impl(hal::detail::as_span(records));
 }
 
-namespace memberwise {
+/** Moves each of \p from into the uninitialized storage at \p to, and
+    destroys it, leaving \p from uninitialized. With one memmove if the
+    records are trivially relocatable, so storage can be grown or shifted
+    in place. */
 template <typename Aggregate>
-constexpr void partial_difference(Aggregate&& aggregate)
+void relocate_impl(std::span<Aggregate> from, Aggregate* to)
 {
-    constexpr auto size =
-        std::tuple_size_v<decltype(hal::to_ref_tuple(aggregate))>;
-    if constexpr (size != 0) {
-        std::apply(
-            [](auto&&... elements) {
-                hal::partial_difference(
-                    std::forward<decltype(elements)>(elements)...);
-            },
-            hal::to_ref_tuple(std::forward<Aggregate>(aggregate)));
+    if constexpr (is_trivially_relocatable_v<Aggregate>) {
+        if (!from.empty()) {
+            std::memmove(static_cast<void*>(to), from.data(),
+                         from.size_bytes());
+        }
     }
+    else {
+        for (auto i = std::size_t{0}; i < from.size(); ++i) {
+            ::new (static_cast<void*>(to + i))
+                Aggregate(std::move(from[i]));
+            from[i].~Aggregate();
+        }
+    }
+}
+
+template <typename Records>
+    requires(hal::detail::is_contiguous_range<Records>)
+void relocate(Records&& from, decltype(std::data(from)) to)
+{
+    memberwise::relocate_impl(hal::detail::as_span(from), to);
 }
+
 }  // namespace memberwise
 
-/* --------------------------- partial_product ------------------------------ */
+/* ---------------------------- memberwise::diff ---------------------------- */
+// Finds the members that changed between two versions of an aggregate, as a
+// bitmask with a bit per member, and encodes only those members, for sending
+// updates of a struct instead of the whole struct. A delta is the mask in
+// little endian, followed by each changed member as memberwise::serialize
+// writes it.
+namespace detail {
 
-template <typename... Elements>
-constexpr void partial_product(Elements&&... elements)
+/// The smallest unsigned integer with a bit per member of \p Aggregate.
+template <typename Aggregate>
+constexpr auto diff_mask_type()
+{
+    constexpr auto count = member_count_v<Aggregate>;
+    if constexpr (count <= 8)
+        return std::uint8_t{};
+    else if constexpr (count <= 16)
+        return std::uint16_t{};
+    else if constexpr (count <= 32)
+        return std::uint32_t{};
+    else
+        return std::uint64_t{};
+}
+
+/// Is true if \p a and \p b have the same bits, so NaNs compare equal.
+template <typename T>
+constexpr auto same_bits(T const& a, T const& b) -> bool
 {
-    if constexpr (sizeof...(Elements) == 0uL)
-        return;
-    using reduce_t =
-        std::decay_t<decltype(hal::first(std::forward<Elements>(elements)...))>;
-    partial_reduce(reduce_t(1),
-                   std::multiplies<>{})(std::forward<Elements>(elements)...);
+    if constexpr (std::is_floating_point_v<T>) {
+        return std::bit_cast<std::array<std::byte, sizeof(T)>>(a) ==
+               std::bit_cast<std::array<std::byte, sizeof(T)>>(b);
+    }
+    else
+        return a == b;
 }
 
+}  // namespace detail
+
 namespace memberwise {
+
+/// A bitmask with bit i set if member i changed.
 template <typename Aggregate>
-constexpr void partial_product(Aggregate&& aggregate)
+using diff_mask_t = decltype(hal::detail::diff_mask_type<Aggregate>());
+
+/// Most bytes encode_delta writes for an \p Aggregate.
+template <typename Aggregate>
+    requires(hal::detail::is_serializable<Aggregate>)
+inline constexpr auto max_delta_size_v =
+    sizeof(diff_mask_t<Aggregate>) + serialized_size_v<Aggregate>;
+
+/** Mask of the members of \p next that differ from the same member of
+    \p previous. Floating point members are compared by their bits, so a
+    NaN that stays a NaN is unchanged and 0.0 to -0.0 is a change. */
+template <typename Aggregate>
+    requires(hal::detail::is_serializable<Aggregate>)
+constexpr auto diff(Aggregate const& previous, Aggregate const& next)
+    -> diff_mask_t<Aggregate>
+{
+    using Mask = diff_mask_t<Aggregate>;
+    auto mask  = Mask{0};
+    auto bit   = Mask{1};
+    hal::detail::for_each_member_pair(
+        previous, next, [&](auto const& a, auto const& b) {
+            if (!hal::detail::same_bits(a, b))
+                mask |= bit;
+            bit = static_cast<Mask>(bit << 1);
+        });
+    return mask;
+}
+
+/** Writes the diff mask of each of \p next against the record at the same
+    index of \p previous to \p masks, and returns the number of records that
+    changed. \p previous and \p masks must be at least as long as \p next,
+    which is checked with assert. Blocks of records are first
+    compared with memcmp, which is vectorized, and only the members of
+    blocks that differ are compared, so unchanged records cost a pass over
+    their bytes. */
+template <typename Aggregate>
+    requires(hal::detail::is_serializable<Aggregate>)
+constexpr auto diff_impl(std::span<Aggregate const> previous,
+                         std::span<Aggregate const> next,
+                         std::span<diff_mask_t<Aggregate>> masks)
+    -> std::size_t
 {
-    constexpr auto size =
-        std::tuple_size_v<decltype(hal::to_ref_tuple(aggregate))>;
-    if constexpr (size != 0) {
-        std::apply(
-            [](auto&&... elements) {
-                hal::partial_product(
-                    std::forward<decltype(elements)>(elements)...);
-            },
-            hal::to_ref_tuple(std::forward<Aggregate>(aggregate)));
+    assert(previous.size() >= next.size() && masks.size() >= next.size());
+    constexpr auto block =
+        sizeof(Aggregate) < 256 ? 256 / sizeof(Aggregate) : 1;
+    auto changed = std::size_t{0};
+    for (auto first = std::size_t{0}; first < next.size(); first += block) {
+        auto const last =
+            next.size() - first < block ? next.size() : first + block;
+        if (!std::is_constant_evaluated() &&
+            std::memcmp(previous.data() + first, next.data() + first,
+                        (last - first) * sizeof(Aggregate)) == 0) {
+            for (auto i = first; i < last; ++i)
+                masks[i] = 0;
+            continue;
+        }
+        for (auto i = first; i < last; ++i) {
+            masks[i] = memberwise::diff(previous[i], next[i]);
+            changed += masks[i] != 0;
+        }
     }
+    return changed;
 }
-}  // namespace memberwise
 
-/* --------------------------- partial_quotient ----------------------------- */
-
-template <typename... Elements>
-constexpr void partial_quotient(Elements&&... elements)
+template <typename Previous, typename Next, typename Masks>
+    requires(hal::detail::is_contiguous_range<Previous> &&
+             hal::detail::is_contiguous_range<Next> &&
+             hal::detail::is_contiguous_range<Masks>)
+constexpr auto diff(Previous&& previous, Next&& next, Masks&& masks)
+    -> std::size_t
 {
-    if constexpr (sizeof...(Elements) == 0uL)
-        return;
-    using reduce_t =
-        std::decay_t<decltype(hal::first(std::forward<Elements>(elements)...))>;
-    partial_reduce(reduce_t(1),
-                   std::divides<>{})(std::forward<Elements>(elements)...);
+    auto const records = hal::detail::as_span(next);
+    using Aggregate    = std::remove_const_t<
+        typename decltype(records)::element_type>;
+    return memberwise::diff_impl(
+        std::span<Aggregate const>{hal::detail::as_span(previous)},
+        std::span<Aggregate const>{records}, hal::detail::as_span(masks));
 }
 
-namespace memberwise {
+/** Writes \p mask and the members of \p next whose bits are set to \p out,
+    which must have room for max_delta_size_v<Aggregate> bytes, and returns
+    the number of bytes written. */
 template <typename Aggregate>
-constexpr void partial_quotient(Aggregate&& aggregate)
+    requires(hal::detail::is_serializable<Aggregate>)
+constexpr auto encode_delta(diff_mask_t<Aggregate> mask,
+                            Aggregate const& next,
+                            std::span<std::byte> out) -> std::size_t
+{
+    hal::detail::store_little_endian(mask, out.data());
+    auto size = sizeof(mask);
+    auto bit  = std::size_t{0};
+    std::apply(
+        [&](auto const&... members) {
+            ((mask >> bit++ & 1
+                  ? (hal::detail::store_little_endian(members,
+                                                      out.data() + size),
+                     size += sizeof(members))
+                  : size),
+             ...);
+        },
+        hal::to_ref_tuple(next));
+    return size;
+}
+
+/** Reads a delta written by encode_delta from the front of \p in and assigns
+    its members to \p aggregate. Returns the number of bytes read, or 0,
+    leaving \p aggregate unchanged, if \p in is shorter than the delta or
+    its mask has bits past the last member. */
+template <typename Aggregate>
+    requires(hal::detail::is_serializable<Aggregate>)
+constexpr auto apply_delta(Aggregate& aggregate, std::span<std::byte const> in)
+    -> std::size_t
 {
-    constexpr auto size =
-        std::tuple_size_v<decltype(hal::to_ref_tuple(aggregate))>;
-    if constexpr (size != 0) {
-        std::apply(
-            [](auto&&... elements) {
-                hal::partial_quotient(
-                    std::forward<decltype(elements)>(elements)...);
-            },
-            hal::to_ref_tuple(std::forward<Aggregate>(aggregate)));
+    using Mask = diff_mask_t<Aggregate>;
+    if (in.size() < sizeof(Mask))
+        return 0;
+    auto const mask = hal::detail::load_little_endian<Mask>(in.data());
+    constexpr auto count = member_count_v<Aggregate>;
+    if constexpr (count < sizeof(Mask) * 8) {
+        if (mask >> count != 0)
+            return 0;
     }
+    auto size = sizeof(Mask);
+    auto bit  = std::size_t{0};
+    std::apply(
+        [&](auto const&... members) {
+            ((size += mask >> bit++ & 1 ? sizeof(members) : 0), ...);
+        },
+        hal::to_ref_tuple(aggregate));
+    if (in.size() < size)
+        return 0;
+    auto position = sizeof(Mask);
+    bit           = 0;
+    std::apply(
+        [&](auto&&... members) {
+            ((mask >> bit++ & 1
+                  ? (members = hal::detail::load_little_endian<
+                         std::remove_cvref_t<decltype(members)>>(
+                         in.data() + position),
+                     position += sizeof(members))
+                  : position),
+             ...);
+        },
+        hal::to_ref_tuple(aggregate));
+    return size;
 }
+
 }  // namespace memberwise
 
 /* --------------------------------------------------------------------------
@@ -816,9 +3093,11 @@ template <typename UnaryOp, typename... Elements>
     requires((std::invocable<UnaryOp, Elements> && ...))
 constexpr auto for_each_impl(UnaryOp&& func, Elements&&... elements) -> void
 {
+    // A right fold over assignment evaluates its operands from right to left.
+    // The left fold (foo = ... = e) is equivalent but exponential to compile.
     // clang 11.0.0 warning on unused expression result without void cast.
     [[maybe_unused]] auto foo = 0;
-    (void)(foo = ... = (func(elements), 0));
+    (void)((func(std::forward<Elements>(elements)), foo) = ... = 0);
 }
 
 inline auto constexpr for_each =
@@ -844,18 +3123,12 @@ inline auto constexpr for_each =
 }  // namespace memberwise
 
 /* ---------------------------- reverse::all_of ----------------------------- */
-template <typename UnaryOp>
-constexpr auto all_of_impl(UnaryOp&&) -> bool
-{
-    return true;
-}
-
-template <typename UnaryOp, typename Head, typename... Tail>
-constexpr auto all_of_impl(UnaryOp&& predicate, Head&& head, Tail&&... tail)
-    -> bool
+template <typename UnaryOp, typename... Elements>
+constexpr auto all_of_impl(UnaryOp&& predicate, Elements&&... elements) -> bool
 {
-    return all_of_impl(predicate, std::forward<Tail>(tail)...) &&
-           predicate(head);
+    auto is_false = [&predicate](auto& x) -> bool { return !predicate(x); };
+    return hal::detail::find_last(is_false, elements...) ==
+           sizeof...(Elements);
 }
 
 inline auto constexpr all_of =
@@ -872,18 +3145,11 @@ constexpr auto all(Elements&&... elements) -> bool
 }
 
 /* ---------------------------- reverse::any_of ----------------------------- */
-template <typename UnaryOp>
-constexpr auto any_of_impl(UnaryOp&&) -> bool
-{
-    return false;
-}
-
-template <typename UnaryOp, typename Head, typename... Tail>
-constexpr auto any_of_impl(UnaryOp&& predicate, Head&& head, Tail&&... tail)
-    -> bool
+template <typename UnaryOp, typename... Elements>
+constexpr auto any_of_impl(UnaryOp&& predicate, Elements&&... elements) -> bool
 {
-    return any_of_impl(predicate, std::forward<Tail>(tail)...) ||
-           predicate(head);
+    return hal::detail::find_last(predicate, elements...) !=
+           sizeof...(Elements);
 }
 
 inline auto constexpr any_of =
@@ -921,24 +3187,18 @@ constexpr auto none(Elements&&... elements) -> bool
 }
 
 /* ---------------------------- reverse::reduce ----------------------------- */
-template <typename T, typename BinaryOp>
-constexpr auto reduce_impl(T init, BinaryOp&&) -> T
+template <typename T, typename BinaryOp, typename... Elements>
+constexpr auto reduce_impl(T init, BinaryOp&& reduce_fn, Elements&&... elements)
+    -> T
 {
+    reverse::for_each_impl(
+        [&](auto&& x) {
+            init = reduce_fn(std::move(init), std::forward<decltype(x)>(x));
+        },
+        std::forward<Elements>(elements)...);
     return init;
 }
 
-// Base case of zero elements is ambiguous with partial application, new name.
-template <typename T, typename BinaryOp, typename Head, typename... Tail>
-constexpr auto reduce_impl(T init,
-                           BinaryOp&& reduce_fn,
-                           Head&& head,
-                           Tail&&... tail) -> T
-{
-    return reduce_fn(
-        reduce_impl(std::move(init), reduce_fn, std::forward<Tail>(tail)...),
-        std::forward<Head>(head));
-}
-
 inline auto constexpr reduce =
     hal::detail::make_curried<3>([](auto&& a, auto&& b, auto&&... c) {
         return hal::reverse::reduce_impl(std::forward<decltype(a)>(a),
@@ -951,8 +3211,7 @@ template <typename T, typename BinaryOp, typename Aggregate>
 constexpr auto reduce_impl(T init, BinaryOp&& reduce_fn, Aggregate&& aggregate)
     -> T
 {
-    constexpr auto size =
-        std::tuple_size_v<decltype(hal::to_ref_tuple(aggregate))>;
+    constexpr auto size = hal::member_count_v<Aggregate>;
     if constexpr (size == 0)
         return init;
     else {
@@ -1000,8 +3259,7 @@ constexpr void partial_reduce_impl(T init,
                                    BinaryOp&& reduce_fn,
                                    Aggregate&& aggregate)
 {
-    constexpr auto size =
-        std::tuple_size_v<decltype(hal::to_ref_tuple(aggregate))>;
+    constexpr auto size = hal::member_count_v<Aggregate>;
     if constexpr (size != 0) {
         return std::apply(
             hal::reverse::partial_reduce(std::move(init),
@@ -1029,10 +3287,9 @@ template <typename UnaryOp, typename... Elements>
 constexpr auto transform_impl(UnaryOp&& transform_fn, Elements&&... elements)
     -> void
 {
-    // clang 11.0.0 warning on unused expression result without void cast.
-    [[maybe_unused]] auto foo = 0;
-    (void)(foo = ... =
-               (elements = transform_fn(std::forward<Elements>(elements)), 0));
+    reverse::for_each_impl(
+        [&transform_fn](auto& x) { x = transform_fn(x); },
+        std::forward<Elements>(elements)...);
 }
 
 inline auto constexpr transform =
@@ -1043,28 +3300,16 @@ inline auto constexpr transform =
 
 /* ---------------------- reverse::transform_reduce ------------------------- */
 
-template <typename T, typename UnaryOp, typename BinaryOp>
-constexpr auto transform_reduce_impl(T init, UnaryOp&&, BinaryOp&&) -> T
-{
-    return init;
-}
-
-// Base case of zero elements is ambiguous with partial application, new name.
-template <typename T,
-          typename UnaryOp,
-          typename BinaryOp,
-          typename Head,
-          typename... Tail>
+template <typename T, typename UnaryOp, typename BinaryOp, typename... Elements>
 constexpr auto transform_reduce_impl(T init,
                                      UnaryOp&& transform_fn,
                                      BinaryOp&& reduce_fn,
-                                     Head&& head,
-                                     Tail&&... tail) -> T
+                                     Elements&&... elements) -> T
 {
-    auto tail_result = transform_reduce_impl(
-        std::move(init), transform_fn, reduce_fn, std::forward<Tail>(tail)...);
-    auto head_result = transform_fn(head);
-    return reduce_fn(std::move(tail_result), std::move(head_result));
+    reverse::for_each_impl(
+        [&](auto&& x) { init = reduce_fn(std::move(init), transform_fn(x)); },
+        std::forward<Elements>(elements)...);
+    return init;
 }
 
 inline auto constexpr transform_reduce =
@@ -1075,30 +3320,21 @@ inline auto constexpr transform_reduce =
     });
 
 /* ------------------- reverse::partial_transform_reduce -------------------- */
-template <typename T, typename UnaryOp, typename BinaryOp>
-constexpr auto partial_transform_reduce_impl(T init, UnaryOp&&, BinaryOp&&) -> T
-{
-    return init;
-}
-
-// Base case of zero elements is ambiguous with partial application, new name.
-template <typename T,
-          typename UnaryOp,
-          typename BinaryOp,
-          typename Head,
-          typename... Tail>
+template <typename T, typename UnaryOp, typename BinaryOp, typename... Elements>
 constexpr auto partial_transform_reduce_impl(T init,
                                              UnaryOp&& transform_fn,
                                              BinaryOp&& reduce_fn,
-                                             Head&& head,
-                                             Tail&&... tail) -> T
-{
-    auto tail_result = partial_transform_reduce_impl(
-        std::move(init), transform_fn, reduce_fn, std::forward<Tail>(tail)...);
-    auto head_result = transform_fn(head);
-    std::forward<Head>(head) =
-        reduce_fn(std::move(tail_result), std::move(head_result));
-    return head;
+                                             Elements&&... elements) -> T
+{
+    // The reduction continues from the value stored in each element, not init.
+    reverse::for_each_impl(
+        [&](auto&& x) {
+            std::forward<decltype(x)>(x) =
+                reduce_fn(std::move(init), transform_fn(x));
+            init = x;
+        },
+        std::forward<Elements>(elements)...);
+    return init;
 }
 
 inline auto constexpr partial_transform_reduce =
@@ -1114,18 +3350,8 @@ template <typename UnaryOp, typename... Elements>
 constexpr auto find_if_impl(UnaryOp&& predicate, Elements&&... elements)
     -> std::size_t
 {
-    auto decrement_until_true =
-        [still_going = true](std::size_t count, bool predicate_result) mutable {
-            return still_going && !predicate_result
-                       ? count - 1
-                       : (still_going = false, count);
-        };
-
-    auto const result = reverse::transform_reduce_impl(
-        sizeof...(Elements) - 1, std::forward<UnaryOp>(predicate),
-        decrement_until_true, std::forward<Elements>(elements)...);
-
-    return result == -1uL ? sizeof...(Elements) : result;
+    return hal::detail::find_last(predicate,
+                                  std::forward<Elements>(elements)...);
 }
 
 inline auto constexpr find_if =
@@ -1173,8 +3399,7 @@ constexpr void partial_sum(Elements&&... elements)
 {
     if constexpr (sizeof...(Elements) == 0uL)
         return;
-    using reduce_t =
-        std::decay_t<decltype(hal::last(std::forward<Elements>(elements)...))>;
+    using reduce_t = std::decay_t<detail::Last_t<Elements...>>;
     reverse::partial_reduce(reduce_t(0),
                             std::plus<>{})(std::forward<Elements>(elements)...);
 }
@@ -1183,8 +3408,7 @@ namespace memberwise {
 template <typename Aggregate>
 constexpr void partial_sum(Aggregate&& aggregate)
 {
-    constexpr auto size =
-        std::tuple_size_v<decltype(hal::to_ref_tuple(aggregate))>;
+    constexpr auto size = hal::member_count_v<Aggregate>;
     if constexpr (size != 0) {
         std::apply(
             [](auto&&... elements) {
@@ -1203,8 +3427,7 @@ constexpr void partial_difference(Elements&&... elements)
 {
     if constexpr (sizeof...(Elements) == 0uL)
         return;
-    using reduce_t =
-        std::decay_t<decltype(hal::last(std::forward<Elements>(elements)...))>;
+    using reduce_t = std::decay_t<detail::Last_t<Elements...>>;
     reverse::partial_reduce(
         reduce_t(0), std::minus<>{})(std::forward<Elements>(elements)...);
 }
@@ -1213,8 +3436,7 @@ namespace memberwise {
 template <typename Aggregate>
 constexpr void partial_difference(Aggregate&& aggregate)
 {
-    constexpr auto size =
-        std::tuple_size_v<decltype(hal::to_ref_tuple(aggregate))>;
+    constexpr auto size = hal::member_count_v<Aggregate>;
     if constexpr (size != 0) {
         std::apply(
             [](auto&&... elements) {
@@ -1233,8 +3455,7 @@ constexpr void partial_product(Elements&&... elements)
 {
     if constexpr (sizeof...(Elements) == 0uL)
         return;
-    using reduce_t =
-        std::decay_t<decltype(hal::last(std::forward<Elements>(elements)...))>;
+    using reduce_t = std::decay_t<detail::Last_t<Elements...>>;
     reverse::partial_reduce(
         reduce_t(1), std::multiplies<>{})(std::forward<Elements>(elements)...);
 }
@@ -1243,8 +3464,7 @@ namespace memberwise {
 template <typename Aggregate>
 constexpr void partial_product(Aggregate&& aggregate)
 {
-    constexpr auto size =
-        std::tuple_size_v<decltype(hal::to_ref_tuple(aggregate))>;
+    constexpr auto size = hal::member_count_v<Aggregate>;
     if constexpr (size != 0) {
         std::apply(
             [](auto&&... elements) {
@@ -1263,8 +3483,7 @@ constexpr void partial_quotient(Elements&&... elements)
 {
     if constexpr (sizeof...(Elements) == 0uL)
         return;
-    using reduce_t =
-        std::decay_t<decltype(hal::last(std::forward<Elements>(elements)...))>;
+    using reduce_t = std::decay_t<detail::Last_t<Elements...>>;
     reverse::partial_reduce(
         reduce_t(1), std::divides<>{})(std::forward<Elements>(elements)...);
 }
@@ -1273,8 +3492,7 @@ namespace memberwise {
 template <typename Aggregate>
 constexpr void partial_quotient(Aggregate&& aggregate)
 {
-    constexpr auto size =
-        std::tuple_size_v<decltype(hal::to_ref_tuple(aggregate))>;
+    constexpr auto size = hal::member_count_v<Aggregate>;
     if constexpr (size != 0) {
         std::apply(
             [](auto&&... elements) {
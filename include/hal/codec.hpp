@@ -0,0 +1,519 @@
+#ifndef HAL_CODEC_HPP
+#define HAL_CODEC_HPP
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <hal.hpp>
+
+namespace hal {
+
+/* --------------------------------- codec ---------------------------------- */
+// Stages for compressing columns of integers, and codecs built from them.
+// Delta encoding turns sorted or slowly changing values into small numbers,
+// zigzag maps small negative numbers to small unsigned ones, and LEB128 or
+// group varint store small unsigned numbers in fewer bytes. Decoding undoes
+// the stages in reverse, ending with a prefix sum.
+namespace codec {
+
+/// Largest number of bytes in the LEB128 encoding of a \p T.
+template <std::unsigned_integral T>
+inline constexpr auto leb128_max_size =
+    std::size_t{(std::numeric_limits<T>::digits + 6) / 7};
+
+/* ------------------------------ codec::zigzag ----------------------------- */
+/// Maps 0, -1, 1, -2, ... to 0, 1, 2, 3, ...
+template <std::signed_integral T>
+constexpr auto zigzag_encode(T value) -> std::make_unsigned_t<T>
+{
+    using U = std::make_unsigned_t<T>;
+    return static_cast<U>(static_cast<U>(static_cast<U>(value) << 1) ^
+                          static_cast<U>(value >> (sizeof(T) * 8 - 1)));
+}
+
+template <std::unsigned_integral T>
+constexpr auto zigzag_decode(T value) -> std::make_signed_t<T>
+{
+    return static_cast<std::make_signed_t<T>>(
+        static_cast<T>(value >> 1) ^ static_cast<T>(T{0} - (value & 1)));
+}
+
+}  // namespace codec
+
+namespace detail::simd {
+
+/// Is true if prefix sums of \p T are computed a register at a time.
+template <typename T>
+inline constexpr auto is_scannable =
+    width != 0 && has_shuffle && std::is_unsigned_v<T> && sizeof(T) >= 4;
+
+/// \p v moved up by \p shift lanes, with zeros shifted in.
+template <typename T, std::size_t shift, std::size_t... I>
+auto shift_lanes(Vec<T> v, std::index_sequence<I...>) -> Vec<T>
+{
+    return __builtin_shufflevector(Vec<T>{}, v,
+                                   (I < shift ? I : lanes<T> + I - shift)...);
+}
+
+/// The last lane of \p v in every lane.
+template <typename T, std::size_t... I>
+auto broadcast_last(Vec<T> v, std::index_sequence<I...>) -> Vec<T>
+{
+    return __builtin_shufflevector(v, v, (I * 0 + lanes<T> - 1)...);
+}
+
+/// Prefix sum of the lanes of \p v, in log2(lanes<T>) shifts and adds.
+template <typename T, std::size_t... Round>
+auto scan_lanes(Vec<T> v, std::index_sequence<Round...>) -> Vec<T>
+{
+    constexpr auto indices = std::make_index_sequence<lanes<T>>{};
+    ((v += shift_lanes<T, std::size_t{1} << Round>(v, indices)), ...);
+    return v;
+}
+
+/** Replaces \p values with their prefix sum, starting from \p carry, and
+    returns the last sum. Two registers are summed per step, so only one add
+    and one broadcast per step wait on the previous step. */
+template <typename T>
+auto inclusive_scan(T* values, std::size_t count, T carry) -> T
+{
+    constexpr auto indices = std::make_index_sequence<lanes<T>>{};
+    constexpr auto rounds =
+        std::make_index_sequence<std::countr_zero(lanes<T>)>{};
+    auto carries     = Vec<T>{} + carry;
+    auto const whole = count - count % (2 * lanes<T>);
+    auto i           = std::size_t{0};
+    for (; i < whole; i += 2 * lanes<T>) {
+        auto low  = simd::scan_lanes<T>(simd::load(values + i), rounds);
+        auto high = simd::scan_lanes<T>(simd::load(values + i + lanes<T>),
+                                        rounds) +
+                    simd::broadcast_last<T>(low, indices);
+        low += carries;
+        high += carries;
+        std::memcpy(values + i, &low, sizeof(low));
+        std::memcpy(values + i + lanes<T>, &high, sizeof(high));
+        carries = simd::broadcast_last<T>(high, indices);
+    }
+    carry = carries[0];
+    for (; i < count; ++i) {
+        carry += values[i];
+        values[i] = carry;
+    }
+    return carry;
+}
+
+}  // namespace detail::simd
+
+namespace detail {
+
+/// Is true for the integer types the codecs support.
+template <typename T>
+inline constexpr auto is_codec_integer =
+    std::is_integral_v<T> && !std::is_same_v<T, bool>;
+
+[[noreturn]] inline void codec_truncated()
+{
+    throw std::runtime_error{"hal::codec: input is truncated"};
+}
+
+/** Replaces \p values with their prefix sum, starting from \p carry, and
+    returns the last sum. Unsigned, so sums wrap around. */
+template <typename T>
+constexpr auto prefix_sum(std::span<T> values, T carry) -> T
+{
+    if constexpr (simd::is_scannable<T>) {
+        if (!std::is_constant_evaluated())
+            return simd::inclusive_scan(values.data(), values.size(), carry);
+    }
+    for (auto& value : values) {
+        carry = static_cast<T>(carry + value);
+        value = carry;
+    }
+    return carry;
+}
+
+/// Writes the LEB128 encoding of \p value to \p out, returns its end.
+template <typename T>
+constexpr auto leb128_store(T value, std::byte* out) -> std::byte*
+{
+    while (value >= 0x80) {
+        *out++ = static_cast<std::byte>(value | 0x80);
+        value  = static_cast<T>(value >> 7);
+    }
+    *out++ = static_cast<std::byte>(value);
+    return out;
+}
+
+/** Reads one LEB128 value of \p bytes from \p position into \p value, and
+    returns the position after it. At most leb128_max_size bytes are read,
+    which skips the bounds checks when that many are left. */
+template <typename T>
+constexpr auto leb128_load(std::span<std::byte const> bytes,
+                           std::size_t position,
+                           T& value) -> std::size_t
+{
+    constexpr auto max_size = std::size_t{
+        (std::numeric_limits<T>::digits + 6) / 7};
+    if (bytes.size() - position >= max_size) {
+        auto const* const data = bytes.data();
+        auto byte  = std::to_integer<unsigned>(data[position++]);
+        value      = static_cast<T>(byte & 0x7F);
+        auto shift = 7;
+        while (byte >= 0x80 && shift < std::numeric_limits<T>::digits) {
+            byte  = std::to_integer<unsigned>(data[position++]);
+            value = static_cast<T>(value | T(byte & 0x7F) << shift);
+            shift += 7;
+        }
+        return position;
+    }
+    value = T{0};
+    for (auto shift = 0; shift < std::numeric_limits<T>::digits; shift += 7) {
+        if (position == bytes.size())
+            codec_truncated();
+        auto const byte = std::to_integer<unsigned>(bytes[position++]);
+        value           = static_cast<T>(value | T(byte & 0x7F) << shift);
+        if (byte < 0x80)
+            break;
+    }
+    return position;
+}
+
+/** Appends \p count values, read with \p get, to \p out as the LEB128 of the
+    zigzag of each value's difference from the one before. */
+template <typename T, typename Get>
+void codec_encode(std::size_t count, Get&& get, std::vector<std::byte>& out)
+{
+    static_assert(is_codec_integer<T>, "hal::codec encodes integers");
+    using U                 = std::make_unsigned_t<T>;
+    using S                 = std::make_signed_t<T>;
+    constexpr auto max_size = (std::numeric_limits<U>::digits + 6) / 7;
+    auto const start        = out.size();
+    out.resize(start + count * max_size);
+    auto* end     = out.data() + start;
+    auto previous = U{0};
+    for (auto i = std::size_t{0}; i < count; ++i) {
+        auto const value = static_cast<U>(get(i));
+        auto const delta = static_cast<S>(static_cast<U>(value - previous));
+        end              = leb128_store(codec::zigzag_encode(delta), end);
+        previous         = value;
+    }
+    out.resize(static_cast<std::size_t>(end - out.data()));
+}
+
+/** Decodes \p count values written by codec_encode from \p bytes, passing
+    each to \p put with its index. Returns the number of bytes read. The
+    running sum is kept in the same loop, its add is hidden behind the byte
+    loads, where a separate SIMD prefix sum pass would only add work. */
+template <typename T, typename Put>
+auto codec_decode(std::span<std::byte const> bytes,
+                  std::size_t count,
+                  Put&& put) -> std::size_t
+{
+    static_assert(is_codec_integer<T>, "hal::codec decodes integers");
+    using U       = std::make_unsigned_t<T>;
+    auto position = std::size_t{0};
+    auto previous = U{0};
+    for (auto i = std::size_t{0}; i < count; ++i) {
+        auto zigzag = U{0};
+        position    = leb128_load(bytes, position, zigzag);
+        previous    = static_cast<U>(
+            previous + static_cast<U>(codec::zigzag_decode(zigzag)));
+        put(i, static_cast<T>(previous));
+    }
+    return position;
+}
+
+}  // namespace detail
+
+namespace codec {
+
+/* ------------------------------ codec::delta ------------------------------ */
+/** Replaces each value after the first with its difference from the value
+    before it. Differences wrap around instead of overflowing. */
+template <typename T>
+    requires(hal::detail::is_codec_integer<T>)
+constexpr void delta_encode_impl(std::span<T> values)
+{
+    using U = std::make_unsigned_t<T>;
+    for (auto i = values.size(); i > 1; --i) {
+        values[i - 1] = static_cast<T>(static_cast<U>(
+            static_cast<U>(values[i - 1]) - static_cast<U>(values[i - 2])));
+    }
+}
+
+template <typename Values>
+constexpr void delta_encode(Values&& values)
+{
+    codec::delta_encode_impl(hal::detail::as_span(values));
+}
+
+/// The inverse of delta_encode, a prefix sum, a register at a time.
+template <typename T>
+    requires(hal::detail::is_codec_integer<T>)
+constexpr void delta_decode_impl(std::span<T> values)
+{
+    using U = std::make_unsigned_t<T>;
+    if constexpr (std::is_signed_v<T>) {
+        if (!std::is_constant_evaluated()) {
+            // Signed and unsigned versions of a type may alias.
+            hal::detail::prefix_sum(
+                std::span{reinterpret_cast<U*>(values.data()), values.size()},
+                U{0});
+            return;
+        }
+        auto carry = U{0};
+        for (auto& value : values) {
+            carry = static_cast<U>(carry + static_cast<U>(value));
+            value = static_cast<T>(carry);
+        }
+    }
+    else {
+        hal::detail::prefix_sum(values, U{0});
+    }
+}
+
+template <typename Values>
+constexpr void delta_decode(Values&& values)
+{
+    codec::delta_decode_impl(hal::detail::as_span(values));
+}
+
+/* ------------------------------ codec::leb128 ----------------------------- */
+/** Appends the LEB128 encoding of each of \p values to \p out, 7 bits per
+    byte with the high bit set on every byte but the last. */
+template <std::unsigned_integral T>
+void leb128_encode_impl(std::span<T const> values, std::vector<std::byte>& out)
+{
+    auto const start = out.size();
+    out.resize(start + values.size() * leb128_max_size<T>);
+    auto* end = out.data() + start;
+    for (auto value : values)
+        end = hal::detail::leb128_store(value, end);
+    out.resize(static_cast<std::size_t>(end - out.data()));
+}
+
+template <typename Values>
+void leb128_encode(Values const& values, std::vector<std::byte>& out)
+{
+    auto const span = hal::detail::as_span(values);
+    using T = std::remove_const_t<typename decltype(span)::element_type>;
+    codec::leb128_encode_impl(std::span<T const>{span}, out);
+}
+
+/** Decodes \p values from the LEB128 encoded \p bytes, and returns the
+    number of bytes read. Throws std::runtime_error if \p bytes ends first. */
+template <std::unsigned_integral T>
+auto leb128_decode_impl(std::span<std::byte const> bytes, std::span<T> values)
+    -> std::size_t
+{
+    auto position = std::size_t{0};
+    for (auto& value : values)
+        position = hal::detail::leb128_load(bytes, position, value);
+    return position;
+}
+
+template <typename Values>
+auto leb128_decode(std::span<std::byte const> bytes, Values&& values)
+    -> std::size_t
+{
+    return codec::leb128_decode_impl(bytes, hal::detail::as_span(values));
+}
+
+/* -------------------------- codec::group_varint --------------------------- */
+/** Appends \p values to \p out in groups of four, a tag byte with the byte
+    length of each value, then the values' 1 to 4 little endian bytes. */
+inline void group_varint_encode_impl(std::span<std::uint32_t const> values,
+                                     std::vector<std::byte>& out)
+{
+    auto const start = out.size();
+    out.resize(start + values.size() / 4 * 17 + 17);
+    auto* end = out.data() + start;
+    for (auto first = std::size_t{0}; first < values.size(); first += 4) {
+        auto* const tag = end++;
+        auto lengths    = 0u;
+        for (auto i = std::size_t{0}; i < 4 && first + i < values.size();
+             ++i) {
+            auto const value = values[first + i];
+            auto const bytes = (std::bit_width(value | 1u) + 7) / 8;
+            lengths |= (bytes - 1u) << (2 * i);
+            for (auto b = 0u; b < bytes; ++b)
+                *end++ = static_cast<std::byte>(value >> (8 * b));
+        }
+        *tag = static_cast<std::byte>(lengths);
+    }
+    out.resize(static_cast<std::size_t>(end - out.data()));
+}
+
+template <typename Values>
+void group_varint_encode(Values const& values, std::vector<std::byte>& out)
+{
+    codec::group_varint_encode_impl(hal::detail::as_span(values), out);
+}
+
+/** Decodes \p values from the group varint encoded \p bytes, and returns the
+    number of bytes read. Throws std::runtime_error if \p bytes ends first.
+    Each value is one unaligned 4 byte load and a mask while a whole group and
+    its slack are left. */
+inline auto group_varint_decode_impl(std::span<std::byte const> bytes,
+                                     std::span<std::uint32_t> values)
+    -> std::size_t
+{
+    constexpr auto masks =
+        std::array<std::uint32_t, 4>{0xFF, 0xFFFF, 0xFFFFFF, 0xFFFFFFFF};
+    auto position = std::size_t{0};
+    for (auto first = std::size_t{0}; first < values.size(); first += 4) {
+        if (position == bytes.size())
+            hal::detail::codec_truncated();
+        auto const lengths = std::to_integer<unsigned>(bytes[position++]);
+        auto const count =
+            values.size() - first < 4 ? values.size() - first : 4;
+        if (bytes.size() - position >= 16) {
+            for (auto i = std::size_t{0}; i < count; ++i) {
+                auto const length = (lengths >> (2 * i)) & 3;
+                values[first + i] =
+                    hal::detail::load_little_endian<std::uint32_t>(
+                        bytes.data() + position) &
+                    masks[length];
+                position += length + 1;
+            }
+        }
+        else {
+            for (auto i = std::size_t{0}; i < count; ++i) {
+                auto const length = ((lengths >> (2 * i)) & 3) + 1;
+                if (bytes.size() - position < length)
+                    hal::detail::codec_truncated();
+                auto value = std::uint32_t{0};
+                for (auto b = std::size_t{0}; b < length; ++b) {
+                    value |= std::to_integer<std::uint32_t>(bytes[position++])
+                             << (8 * b);
+                }
+                values[first + i] = value;
+            }
+        }
+    }
+    return position;
+}
+
+template <typename Values>
+auto group_varint_decode(std::span<std::byte const> bytes, Values&& values)
+    -> std::size_t
+{
+    return codec::group_varint_decode_impl(bytes,
+                                           hal::detail::as_span(values));
+}
+
+/* ---------------------------- codec::encode ------------------------------- */
+/** Appends \p values to \p out, each as the LEB128 of the zigzag of its
+    difference from the value before it, the first from zero. Sorted or
+    slowly changing values take one or two bytes each. */
+template <typename T>
+    requires(hal::detail::is_codec_integer<T>)
+void encode_impl(std::span<T const> values, std::vector<std::byte>& out)
+{
+    hal::detail::codec_encode<T>(
+        values.size(), [&](std::size_t i) { return values[i]; }, out);
+}
+
+template <typename Values>
+void encode(Values const& values, std::vector<std::byte>& out)
+{
+    auto const span = hal::detail::as_span(values);
+    using T = std::remove_const_t<typename decltype(span)::element_type>;
+    codec::encode_impl(std::span<T const>{span}, out);
+}
+
+/* ---------------------------- codec::decode ------------------------------- */
+/** Decodes \p values written by encode from \p bytes, and returns the number
+    of bytes read. Throws std::runtime_error if \p bytes ends first. */
+template <typename T>
+    requires(hal::detail::is_codec_integer<T>)
+auto decode_impl(std::span<std::byte const> bytes, std::span<T> values)
+    -> std::size_t
+{
+    return hal::detail::codec_decode<T>(
+        bytes, values.size(),
+        [&](std::size_t i, T value) { values[i] = value; });
+}
+
+template <typename Values>
+auto decode(std::span<std::byte const> bytes, Values&& values) -> std::size_t
+{
+    return codec::decode_impl(bytes, hal::detail::as_span(values));
+}
+
+namespace memberwise {
+
+/* ----------------------- codec::memberwise::encode ------------------------ */
+/** Appends each member of \p records to \p out as a column encoded with
+    codec::encode, one column after another. */
+template <typename Aggregate>
+void encode_impl(std::span<Aggregate const> records,
+                 std::vector<std::byte>& out)
+{
+    using Members = hal::detail::Members_t<Aggregate>;
+    [&]<std::size_t... I>(std::index_sequence<I...>)
+    {
+        (hal::detail::codec_encode<std::tuple_element_t<I, Members>>(
+             records.size(),
+             [&](std::size_t i) {
+                 return std::get<I>(hal::to_ref_tuple(records[i]));
+             },
+             out),
+         ...);
+    }
+    (std::make_index_sequence<std::tuple_size_v<Members>>{});
+}
+
+template <typename Records>
+void encode(Records const& records, std::vector<std::byte>& out)
+{
+    auto const span = hal::detail::as_span(records);
+    using Aggregate =
+        std::remove_const_t<typename decltype(span)::element_type>;
+    memberwise::encode_impl(std::span<Aggregate const>{span}, out);
+}
+
+/* ----------------------- codec::memberwise::decode ------------------------ */
+/** Decodes \p records written by memberwise::encode from \p bytes, and
+    returns the number of bytes read. */
+template <typename Aggregate>
+auto decode_impl(std::span<std::byte const> bytes,
+                 std::span<Aggregate> records) -> std::size_t
+{
+    using Members = hal::detail::Members_t<Aggregate>;
+    auto position = std::size_t{0};
+    [&]<std::size_t... I>(std::index_sequence<I...>)
+    {
+        ((position += hal::detail::codec_decode<
+              std::tuple_element_t<I, Members>>(
+              bytes.subspan(position), records.size(),
+              [&](std::size_t i, auto value) {
+                  std::get<I>(hal::to_ref_tuple(records[i])) = value;
+              })),
+         ...);
+    }
+    (std::make_index_sequence<std::tuple_size_v<Members>>{});
+    return position;
+}
+
+template <typename Records>
+auto decode(std::span<std::byte const> bytes, Records&& records)
+    -> std::size_t
+{
+    return memberwise::decode_impl(bytes, hal::detail::as_span(records));
+}
+
+}  // namespace memberwise
+}  // namespace codec
+}  // namespace hal
+#endif  // HAL_CODEC_HPP
@@ -0,0 +1,457 @@
+#ifndef HAL_COLUMNAR_HPP
+#define HAL_COLUMNAR_HPP
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <hal.hpp>
+#include <hal/mapped_file.hpp>
+#include <hal/soa_vector.hpp>
+
+namespace hal {
+
+/* -------------------------------- columnar -------------------------------- */
+// A columnar file is a sequence of row groups, then a footer. A row group
+// holds one block per member, the member's little endian values for each row
+// of the group, each block starting on a cache line. The footer is a list of
+// 64 bit little endian values:
+//
+//     for each row group: its row count, then the offset of each block
+//     the size of each member
+//     member count, row group count, offset of the footer, magic
+//
+// Readers map the file and read a block as a span of the member type, so a
+// query only touches the pages of the members it asks for.
+namespace detail {
+
+/// Blocks start at multiples of this many bytes.
+inline constexpr auto columnar_alignment = std::size_t{64};
+
+/// "HALCOLS1", the last 8 bytes of a columnar file.
+inline constexpr auto columnar_magic = std::uint64_t{0x31534C4F434C4148};
+
+/// Values in the footer after the row groups, not counting member sizes.
+inline constexpr auto columnar_trailer = std::size_t{4};
+
+}  // namespace detail
+
+/* ---------------------------- columnar_writer ----------------------------- */
+/** Writes records of type \p T to a columnar file. Records are buffered in a
+    soa_vector until a row group is full, then each column is written as one
+    block. close() writes the last row group and the footer. */
+template <typename T>
+    requires(hal::detail::is_serializable<T>)
+class columnar_writer {
+   public:
+    using value_type = T;
+    using size_type  = std::size_t;
+
+    /** Rows per row group by default. A block of 8 byte members is then 64
+        KiB, so a scan over a few members of a group stays in L2 cache. */
+    static constexpr auto default_group_rows = size_type{8192};
+
+   public:
+    /** Creates or truncates the file at \p path. Throws std::ios_base::failure,
+        a std::system_error, if it can't be opened. */
+    explicit columnar_writer(std::filesystem::path const& path,
+                             size_type group_rows = default_group_rows)
+        : file_{path, std::ios::binary | std::ios::trunc},
+          group_rows_{group_rows == 0 ? 1 : group_rows}
+    {
+        if (!file_)
+            throw_stream_error("open");
+        group_.reserve(group_rows_);
+    }
+
+    columnar_writer(columnar_writer const&)                    = delete;
+    auto operator=(columnar_writer const&) -> columnar_writer& = delete;
+
+    /// Closes the file if close() was not called, ignoring errors.
+    ~columnar_writer()
+    {
+        if (!closed_) {
+            try {
+                close();
+            }
+            catch (...) {
+            }
+        }
+    }
+
+   public:
+    /// Number of rows written so far, including buffered ones.
+    auto size() const -> size_type { return rows_ + group_.size(); }
+
+    void push_back(T const& record)
+    {
+        group_.push_back(record);
+        if (group_.size() == group_rows_)
+            write_group();
+    }
+
+    /// Appends \p records, scattered into the columns of each row group.
+    void write(std::span<T const> records)
+    {
+        while (!records.empty()) {
+            auto const first = group_.size();
+            auto const room  = group_rows_ - first;
+            auto const count = room < records.size() ? room : records.size();
+            group_.resize(first + count);
+            with_indices([&]<std::size_t... I>(std::index_sequence<I...>) {
+                memberwise::scatter(
+                    records.first(count),
+                    group_.template column<I>().subspan(first)...);
+            });
+            records = records.subspan(count);
+            if (group_.size() == group_rows_)
+                write_group();
+        }
+    }
+
+    /** Writes the buffered rows and the footer, and closes the file. Throws
+        std::ios_base::failure, a std::system_error, if the file could not be
+        written. */
+    void close()
+    {
+        if (closed_)
+            return;
+        closed_ = true;
+        if (!group_.empty())
+            write_group();
+        auto const footer_offset = offset_;
+        for (auto value : footer_)
+            write_value(value);
+        with_indices([&]<std::size_t... I>(std::index_sequence<I...>) {
+            (write_value(sizeof(std::tuple_element_t<I, Members>)), ...);
+        });
+        write_value(hal::member_count_v<T>);
+        write_value(group_count_);
+        write_value(footer_offset);
+        write_value(detail::columnar_magic);
+        file_.close();
+        if (!file_)
+            throw_stream_error("write");
+    }
+
+   private:
+    using Members = detail::Members_t<T>;
+
+    template <typename Fn>
+    static auto with_indices(Fn&& fn) -> decltype(auto)
+    {
+        return fn(std::make_index_sequence<hal::member_count_v<T>>{});
+    }
+
+    /// Writes each column of the buffered rows as a block.
+    void write_group()
+    {
+        footer_.push_back(group_.size());
+        with_indices([&]<std::size_t... I>(std::index_sequence<I...>) {
+            (write_block(std::as_const(group_).template column<I>()), ...);
+        });
+        rows_ += group_.size();
+        ++group_count_;
+        group_.clear();
+        if (!file_)
+            throw_stream_error("write");
+    }
+
+    template <typename Member>
+    void write_block(std::span<Member const> values)
+    {
+        auto const padding = (detail::columnar_alignment -
+                              offset_ % detail::columnar_alignment) %
+                             detail::columnar_alignment;
+        static constexpr auto zeros =
+            std::array<char, detail::columnar_alignment>{};
+        file_.write(zeros.data(), static_cast<std::streamsize>(padding));
+        offset_ += padding;
+        footer_.push_back(offset_);
+
+        if constexpr (std::endian::native == std::endian::little) {
+            file_.write(reinterpret_cast<char const*>(values.data()),
+                        static_cast<std::streamsize>(values.size_bytes()));
+        }
+        else {
+            for (auto value : values) {
+                auto bytes = std::array<std::byte, sizeof(Member)>{};
+                detail::store_little_endian(value, bytes.data());
+                file_.write(reinterpret_cast<char const*>(bytes.data()),
+                            sizeof(Member));
+            }
+        }
+        offset_ += values.size_bytes();
+    }
+
+    void write_value(std::uint64_t value)
+    {
+        auto bytes = std::array<std::byte, sizeof(value)>{};
+        detail::store_little_endian(value, bytes.data());
+        file_.write(reinterpret_cast<char const*>(bytes.data()), sizeof(value));
+        offset_ += sizeof(value);
+    }
+
+    /** Throws for a failed \p call on the file. std::ofstream doesn't set
+        errno reliably, so this reports the stream state instead. */
+    [[noreturn]] void throw_stream_error(char const* call) const
+    {
+        throw std::ios_base::failure{
+            std::string{"hal::columnar_writer: "} + call + " failed" +
+            (file_.bad() ? ", stream is bad" : ", stream failed")};
+    }
+
+   private:
+    std::ofstream file_;
+    soa_vector<T> group_;
+    std::vector<std::uint64_t> footer_;
+    std::uint64_t offset_      = 0;
+    std::uint64_t group_count_ = 0;
+    size_type group_rows_;
+    size_type rows_ = 0;
+    bool closed_    = false;
+};
+
+/* ---------------------------- columnar_reader ----------------------------- */
+/** Memory maps a columnar file of records of type \p T, and reads the blocks
+    of the requested members in place. Needs a little endian platform. */
+template <typename T>
+    requires(hal::detail::is_serializable<T>)
+class columnar_reader {
+    static_assert(std::endian::native == std::endian::little,
+                  "columnar_reader reads blocks in place, which needs a "
+                  "little endian platform.");
+
+   public:
+    using value_type = T;
+    using size_type  = std::size_t;
+
+    /// Type of member \p I of T.
+    template <std::size_t I>
+    using Member_t = std::tuple_element_t<I, detail::Members_t<T>>;
+
+    /** The row groups of members I..., each a std::tuple with a span per
+        member, returned by columns<I...>(). */
+    template <std::size_t... I>
+    class Projection {
+       public:
+        using value_type = std::tuple<std::span<Member_t<I> const>...>;
+
+        class Iterator {
+           public:
+            using difference_type = std::ptrdiff_t;
+            using value_type      = Projection::value_type;
+
+            Iterator() = default;
+            Iterator(columnar_reader const* reader, size_type group)
+                : reader_{reader}, group_{group}
+            {}
+
+            auto operator*() const -> value_type
+            {
+                return value_type{reader_->template column<I>(group_)...};
+            }
+
+            auto operator++() -> Iterator&
+            {
+                ++group_;
+                return *this;
+            }
+
+            auto operator++(int) -> Iterator
+            {
+                auto copy = *this;
+                ++group_;
+                return copy;
+            }
+
+            auto operator==(Iterator const& other) const -> bool
+            {
+                return group_ == other.group_;
+            }
+
+           private:
+            columnar_reader const* reader_ = nullptr;
+            size_type group_               = 0;
+        };
+
+        explicit Projection(columnar_reader const& reader) : reader_{&reader}
+        {}
+
+        /// Number of row groups.
+        auto size() const -> size_type { return reader_->group_count(); }
+
+        auto operator[](size_type group) const -> value_type
+        {
+            return value_type{reader_->template column<I>(group)...};
+        }
+
+        auto begin() const -> Iterator { return Iterator{reader_, 0}; }
+        auto end() const -> Iterator { return Iterator{reader_, size()}; }
+
+       private:
+        columnar_reader const* reader_;
+    };
+
+   public:
+    /** Maps the file at \p path. Throws std::system_error if it can't be
+        opened or mapped, and std::runtime_error if it is not a columnar file
+        of T. */
+    explicit columnar_reader(std::filesystem::path const& path)
+        : file_{path, "hal::columnar_reader"}
+    {
+        auto const bytes = file_.bytes();
+        auto const value = [&](std::size_t index_from_end) {
+            return detail::load_little_endian<std::uint64_t>(
+                bytes.data() + bytes.size() - 8 * index_from_end);
+        };
+        if (bytes.size() < 8 * detail::columnar_trailer ||
+            value(1) != detail::columnar_magic) {
+            invalid("not a columnar file");
+        }
+        auto const footer_offset = value(2);
+        auto const group_count   = value(3);
+        if (value(4) != members)
+            invalid("wrong member count");
+        if (group_count > bytes.size() / 8)
+            invalid("wrong footer size");
+        auto const footer_values =
+            group_count * (members + 1) + members + detail::columnar_trailer;
+        if (footer_offset > bytes.size() ||
+            (bytes.size() - footer_offset) / 8 != footer_values ||
+            (bytes.size() - footer_offset) % 8 != 0) {
+            invalid("wrong footer size");
+        }
+
+        auto footer = bytes.subspan(footer_offset);
+        auto next   = [&] {
+            auto const result =
+                detail::load_little_endian<std::uint64_t>(footer.data());
+            footer = footer.subspan(8);
+            return result;
+        };
+        groups_.resize(group_count);
+        for (auto& group : groups_) {
+            group.rows = next();
+            for (auto& offset : group.offsets)
+                offset = next();
+        }
+        with_indices([&]<std::size_t... I>(std::index_sequence<I...>) {
+            if (((next() != sizeof(Member_t<I>)) || ...))
+                invalid("wrong member sizes");
+            for (auto const& group : groups_) {
+                if (((group.offsets[I] % detail::columnar_alignment != 0 ||
+                      group.offsets[I] > footer_offset ||
+                      (footer_offset - group.offsets[I]) /
+                              sizeof(Member_t<I>) <
+                          group.rows) ||
+                     ...)) {
+                    invalid("block outside the file");
+                }
+            }
+        });
+        with_indices([&]<std::size_t... I>(std::index_sequence<I...>) {
+            (check_values<I>(), ...);
+        });
+        for (auto const& group : groups_)
+            rows_ += group.rows;
+    }
+
+   public:
+    /// Number of rows in the file.
+    auto size() const -> size_type { return rows_; }
+    auto empty() const -> bool { return rows_ == 0; }
+
+    auto group_count() const -> size_type { return groups_.size(); }
+
+    /// Number of rows in row group \p group.
+    auto group_size(size_type group) const -> size_type
+    {
+        return groups_[group].rows;
+    }
+
+    /// Member \p I of every row of row group \p group, read in place.
+    template <std::size_t I>
+    auto column(size_type group) const -> std::span<Member_t<I> const>
+    {
+        auto const& g = groups_[group];
+        return {reinterpret_cast<Member_t<I> const*>(file_.bytes().data() +
+                                                     g.offsets[I]),
+                g.rows};
+    }
+
+    /// The row groups of members \p I..., e.g. columns<0, 3>().
+    template <std::size_t... I>
+        requires(sizeof...(I) > 0 && ((I < hal::member_count_v<T>) && ...))
+    auto columns() const -> Projection<I...>
+    {
+        return Projection<I...>{*this};
+    }
+
+    /// Copies member \p I of every row into \p out, which has size() values.
+    template <std::size_t I>
+    void read_column(std::span<Member_t<I>> out) const
+    {
+        for (auto g = size_type{0}; g < groups_.size(); ++g) {
+            auto const block = column<I>(g);
+            std::copy(block.begin(), block.end(), out.begin());
+            out = out.subspan(block.size());
+        }
+    }
+
+   private:
+    static constexpr auto members = hal::member_count_v<T>;
+
+    struct Group {
+        std::uint64_t rows;
+        std::array<std::uint64_t, members> offsets;
+    };
+
+    template <typename Fn>
+    static auto with_indices(Fn&& fn) -> decltype(auto)
+    {
+        return fn(std::make_index_sequence<members>{});
+    }
+
+    /** Throws if a block of member \p I is a block of bools with bytes other
+        than 0 and 1, as blocks are read in place and those are not valid
+        bools. Every value of an enum's fixed underlying type is valid. */
+    template <std::size_t I>
+    void check_values() const
+    {
+        if constexpr (std::is_same_v<Member_t<I>, bool>) {
+            for (auto const& group : groups_) {
+                auto const block =
+                    file_.bytes().subspan(group.offsets[I], group.rows);
+                if (std::any_of(block.begin(), block.end(),
+                                [](auto b) { return b > std::byte{1}; }))
+                    invalid("bools other than 0 and 1");
+            }
+        }
+    }
+
+    [[noreturn]] static void invalid(char const* reason)
+    {
+        throw std::runtime_error{std::string{"hal::columnar_reader: "} +
+                                 reason};
+    }
+
+   private:
+    detail::Mapped_file file_;
+    std::vector<Group> groups_;
+    size_type rows_ = 0;
+};
+
+}  // namespace hal
+#endif  // HAL_COLUMNAR_HPP
@@ -0,0 +1,344 @@
+#ifndef HAL_CONCURRENT_HPP
+#define HAL_CONCURRENT_HPP
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <hal.hpp>
+
+namespace hal {
+namespace detail {
+
+/** Size of a cache line on the targets hal is tuned for. Used instead of
+    std::hardware_destructive_interference_size, which GCC warns may change
+    between compiler flags. */
+inline constexpr auto cache_line_size = std::size_t{64};
+
+/// Tells the CPU this is a spin wait, where it has an instruction for it.
+inline void spin_pause()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+/// Is true if the members of \p Aggregate fit lock free std::atomics.
+template <typename Aggregate, typename Members = Members_t<Aggregate>>
+inline constexpr auto has_lock_free_members = false;
+
+template <typename Aggregate, typename... Members>
+inline constexpr auto has_lock_free_members<Aggregate, std::tuple<Members...>> =
+    std::is_trivially_copyable_v<Aggregate> &&
+    (std::atomic<Members>::is_always_lock_free && ...);
+
+/** Index of the calling thread, in the order threads first ask for it, so
+    the threads of a pool get consecutive slots. */
+inline auto this_thread_slot() -> std::size_t
+{
+    static auto next = std::atomic<std::size_t>{0};
+    thread_local auto const slot =
+        next.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+
+}  // namespace detail
+
+/* ------------------------- memberwise::seqlocked -------------------------- */
+namespace memberwise {
+
+/** An aggregate of type \p T written by one thread and read by any number,
+    without locks. Each member is kept in its own std::atomic. A writer makes
+    the sequence number odd, stores the members and makes it even again; a
+    reader copies the members and retries if the sequence number was odd or
+    changed meanwhile. Every access is atomic, without fences, so there are
+    no data races, and it is clean under ThreadSanitizer. On x86 the member
+    loads and stores are plain moves.
+
+    Readers never block the writer, and only retry while a store overlaps
+    their copy. Stores from several threads must be serialized by the caller.
+    Members must be types that std::atomic supports without a lock, such as
+    arithmetic types, enums and pointers. */
+template <typename T>
+    requires(hal::detail::has_lock_free_members<T>)
+class seqlocked {
+   public:
+    using value_type = T;
+
+   public:
+    constexpr seqlocked() : seqlocked{T{}} {}
+
+    explicit constexpr seqlocked(T const& value)
+        : members_{std::apply(
+              [](auto const&... members) {
+                  return Members{members...};
+              },
+              hal::to_ref_tuple(value))}
+    {
+    }
+
+    seqlocked(seqlocked const&) = delete;
+    auto operator=(seqlocked const&) -> seqlocked& = delete;
+
+   public:
+    /// A copy of the value, from a single store.
+    auto load() const noexcept -> T
+    {
+        for (;;) {
+            auto const before = sequence_.load(std::memory_order_acquire);
+            if (before & 1) {
+                hal::detail::spin_pause();
+                continue;
+            }
+            // Acquire loads keep the second sequence load after them. If
+            // one reads a member of a store in progress, it also sees that
+            // store's odd sequence number.
+            auto const value = std::apply(
+                [](auto const&... members) {
+                    return T{members.load(std::memory_order_acquire)...};
+                },
+                members_);
+            if (sequence_.load(std::memory_order_relaxed) == before)
+                return value;
+        }
+    }
+
+    /// Replaces the value with \p value. Only one thread may store at a time.
+    void store(T const& value) noexcept
+    {
+        auto const sequence = sequence_.load(std::memory_order_relaxed);
+        sequence_.store(sequence + 1, std::memory_order_relaxed);
+        // Release stores keep the odd sequence number before them.
+        std::apply(
+            [&](auto&... members) {
+                std::apply(
+                    [&](auto const&... values) {
+                        (members.store(values, std::memory_order_release),
+                         ...);
+                    },
+                    hal::to_ref_tuple(value));
+            },
+            members_);
+        sequence_.store(sequence + 2, std::memory_order_release);
+    }
+
+    /** Calls fn(T&) on a copy of the value and stores the result, for the
+        writer to change some members. Only one thread may update or store
+        at a time. */
+    template <typename Fn>
+    void update(Fn&& fn)
+    {
+        auto value = std::apply(
+            [](auto const&... members) {
+                return T{members.load(std::memory_order_relaxed)...};
+            },
+            members_);
+        std::forward<Fn>(fn)(value);
+        store(value);
+    }
+
+    /// Number of stores so far.
+    auto version() const noexcept -> std::uint64_t
+    {
+        return sequence_.load(std::memory_order_acquire) / 2;
+    }
+
+   private:
+    template <typename Tuple>
+    struct Atomics;
+
+    template <typename... Types>
+    struct Atomics<std::tuple<Types...>> {
+        using type = std::tuple<std::atomic<Types>...>;
+    };
+
+    using Members = typename Atomics<hal::detail::Members_t<T>>::type;
+
+   private:
+    alignas(hal::detail::cache_line_size)
+        std::atomic<std::uint64_t> sequence_{0};
+    Members members_;
+};
+
+}  // namespace memberwise
+
+/* --------------------------------- sharded -------------------------------- */
+// Merge operations for sharded::snapshot, as function objects that can be
+// passed once for every member or one per member.
+namespace merge {
+
+using sum = std::plus<>;
+
+struct max {
+    template <typename T>
+    constexpr auto operator()(T const& a, T const& b) const -> T
+    {
+        return a < b ? b : a;
+    }
+};
+
+struct min {
+    template <typename T>
+    constexpr auto operator()(T const& a, T const& b) const -> T
+    {
+        return b < a ? b : a;
+    }
+};
+
+}  // namespace merge
+
+namespace detail {
+
+/// Combines \p partial into \p result, member i with merge operation i.
+template <typename Result, typename... MergeOps>
+constexpr auto merge_members(Result result,
+                             Result const& partial,
+                             MergeOps const&... merge) -> Result
+{
+    auto accumulators   = hal::to_ref_tuple(result);
+    auto const partials = hal::to_ref_tuple(partial);
+    [&]<std::size_t... I>(std::index_sequence<I...>)
+    {
+        ((std::get<I>(accumulators) =
+              merge(std::move(std::get<I>(accumulators)),
+                    std::get<I>(partials))),
+         ...);
+    }
+    (std::index_sequence_for<MergeOps...>{});
+    return result;
+}
+
+}  // namespace detail
+
+/** An aggregate of type \p T updated by many threads, such as a struct of
+    statistics, kept as one copy per thread slot. Each copy, a shard, is on
+    cache lines of its own, so threads updating their own shard don't take
+    cache lines from each other. snapshot() merges the shards member by
+    member.
+
+    Threads are assigned shards in the order they first update, wrapping
+    around when there are more threads than shards. Each shard has a spin
+    lock, so threads sharing one are safe, and snapshot() can read shards
+    while they are updated; uncontended, it costs one atomic exchange per
+    update. Shards start as \p initial, T{} by default, which should be the
+    identity of the merge operations, such as the largest value for a member
+    merged with merge::min. */
+template <typename T>
+class sharded {
+   public:
+    using value_type = T;
+
+   public:
+    /// A shard per hardware thread, or \p shard_count shards.
+    explicit sharded(T const& initial      = T{},
+                     std::size_t shard_count = default_shard_count())
+        : initial_{initial},
+          shard_count_{shard_count == 0 ? 1 : shard_count},
+          shards_{std::make_unique<Shard[]>(shard_count_)}
+    {
+        for (auto i = std::size_t{0}; i < shard_count_; ++i)
+            shards_[i].value = initial_;
+    }
+
+   public:
+    /** Calls fn(T&) on the calling thread's shard, and returns what it
+        returns. \p fn should be short, as it holds the shard's lock. */
+    template <typename Fn>
+    auto update(Fn&& fn) -> decltype(auto)
+    {
+        auto& shard = shards_[hal::detail::this_thread_slot() % shard_count_];
+        auto const lock = Lock{shard};
+        return std::forward<Fn>(fn)(shard.value);
+    }
+
+    /** The shards merged into one \p T, member by member. Pass one merge
+        operation for every member, or one per member, such as
+        snapshot(merge::sum{}, merge::sum{}, merge::max{}). Sums all members
+        without any. Each shard is read as of one point in time, but not all
+        at the same point. */
+    template <typename... MergeOps>
+        requires(sizeof...(MergeOps) <= 1 ||
+                 sizeof...(MergeOps) == hal::member_count_v<T>)
+    auto snapshot(MergeOps const&... merge) const -> T
+    {
+        auto result = read(0);
+        for (auto i = std::size_t{1}; i < shard_count_; ++i) {
+            if constexpr (sizeof...(MergeOps) <= 1) {
+                auto each = [&] {
+                    if constexpr (sizeof...(MergeOps) == 0)
+                        return merge::sum{};
+                    else
+                        return (merge, ...);
+                }();
+                result = hal::detail::batch_merge(each, std::move(result),
+                                                  read(i));
+            }
+            else {
+                result = hal::detail::merge_members(std::move(result),
+                                                    read(i), merge...);
+            }
+        }
+        return result;
+    }
+
+    /// Sets every shard back to the initial value.
+    void reset()
+    {
+        for (auto i = std::size_t{0}; i < shard_count_; ++i) {
+            auto const lock  = Lock{shards_[i]};
+            shards_[i].value = initial_;
+        }
+    }
+
+    auto shard_count() const -> std::size_t { return shard_count_; }
+
+    static auto default_shard_count() -> std::size_t
+    {
+        auto const threads = std::thread::hardware_concurrency();
+        return threads == 0 ? 1 : threads;
+    }
+
+   private:
+    struct alignas(hal::detail::cache_line_size) Shard {
+        std::atomic<bool> locked{false};
+        T value;
+    };
+
+    class Lock {
+       public:
+        explicit Lock(Shard& shard) : shard_{shard}
+        {
+            while (shard_.locked.exchange(true, std::memory_order_acquire)) {
+                while (shard_.locked.load(std::memory_order_relaxed))
+                    hal::detail::spin_pause();
+            }
+        }
+        ~Lock() { shard_.locked.store(false, std::memory_order_release); }
+        Lock(Lock const&) = delete;
+        auto operator=(Lock const&) -> Lock& = delete;
+
+       private:
+        Shard& shard_;
+    };
+
+    auto read(std::size_t i) const -> T
+    {
+        auto const lock = Lock{shards_[i]};
+        return shards_[i].value;
+    }
+
+   private:
+    T initial_;
+    std::size_t shard_count_;
+    std::unique_ptr<Shard[]> shards_;
+};
+
+}  // namespace hal
+#endif  // HAL_CONCURRENT_HPP
@@ -0,0 +1,165 @@
+#ifndef HAL_FORMAT_HPP
+#define HAL_FORMAT_HPP
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+
+#include <hal.hpp>
+
+namespace hal {
+
+/* -------------------------------- format_to ------------------------------- */
+// Writes elements as text into a caller's buffer with std::to_chars, without
+// locking or allocating. Every supported type has a bounded text length, so
+// the longest output is known at compile time and the buffer can live on the
+// stack.
+namespace detail {
+
+template <typename T>
+inline constexpr auto is_char_array = false;
+
+template <std::size_t N>
+inline constexpr auto is_char_array<std::array<char, N>> = true;
+
+template <std::size_t N>
+inline constexpr auto is_char_array<char[N]> = true;
+
+/// Is true for the types that format_to supports.
+template <typename T>
+inline constexpr auto is_formattable =
+    std::is_arithmetic_v<T> || std::is_enum_v<T> || is_char_array<T>;
+
+/// Number of decimal digits in \p value.
+constexpr auto decimal_digits(int value) -> std::size_t
+{
+    auto digits = std::size_t{1};
+    for (; value >= 10; value /= 10)
+        ++digits;
+    return digits;
+}
+
+/** Most characters format_element writes for a \p T. Floating point values
+    are written in their shortest round trip form, which is never longer
+    than scientific notation with max_digits10 digits, such as
+    -2.2250738585072014e-308. */
+template <typename T>
+constexpr auto max_formatted_chars() -> std::size_t
+{
+    using Limits = std::numeric_limits<T>;
+    if constexpr (std::is_same_v<T, bool>)
+        return 5;  // false
+    else if constexpr (std::is_same_v<T, char>)
+        return 1;
+    else if constexpr (std::is_enum_v<T>)
+        return detail::max_formatted_chars<std::underlying_type_t<T>>();
+    else if constexpr (std::is_integral_v<T>)
+        return Limits::digits10 + 1 + std::is_signed_v<T>;
+    else if constexpr (std::is_floating_point_v<T>) {
+        // Subnormals have exponents below min_exponent10.
+        constexpr auto exponent = detail::decimal_digits(
+            Limits::max_digits10 - Limits::min_exponent10);
+        return 1 + Limits::max_digits10 + 1 + 2 + exponent;
+    }
+    else if constexpr (std::is_array_v<T>)
+        return std::extent_v<T> - 1;  // A string literal, without its '\0'.
+    else
+        return std::tuple_size_v<T>;
+}
+
+/// Writes \p value to \p out, and returns the end of what was written.
+template <typename T>
+auto format_element(char* out, T const& value) -> char*
+{
+    if constexpr (std::is_same_v<T, bool>) {
+        std::memcpy(out, value ? "true" : "false", value ? 4 : 5);
+        return out + (value ? 4 : 5);
+    }
+    else if constexpr (std::is_same_v<T, char>) {
+        *out = value;
+        return out + 1;
+    }
+    else if constexpr (std::is_enum_v<T>) {
+        return detail::format_element(
+            out, static_cast<std::underlying_type_t<T>>(value));
+    }
+    else if constexpr (std::is_arithmetic_v<T>) {
+        return std::to_chars(out, out + max_formatted_chars<T>(), value).ptr;
+    }
+    else {
+        // Up to the first '\0', or the whole array.
+        constexpr auto size = max_formatted_chars<T>();
+        auto const* end     = static_cast<char const*>(
+            std::memchr(std::data(value), '\0', size));
+        auto const length =
+            end == nullptr ? size
+                           : static_cast<std::size_t>(end - std::data(value));
+        std::memcpy(out, std::data(value), length);
+        return out + length;
+    }
+}
+
+}  // namespace detail
+
+/** Most characters format_to writes for \p Elements, with a separator
+    between each. */
+template <typename... Elements>
+    requires((hal::detail::is_formattable<std::remove_cvref_t<Elements>> &&
+              ...))
+inline constexpr auto max_formatted_size_v =
+    (std::size_t{0} + ... +
+     hal::detail::max_formatted_chars<std::remove_cvref_t<Elements>>()) +
+    (sizeof...(Elements) == 0 ? 0 : sizeof...(Elements) - 1);
+
+/** Writes \p elements to \p out as text, with \p separator between each, and
+    returns the end of what was written. \p out must have room for
+    max_formatted_size_v<Elements...> characters, nothing is null terminated.
+    Integers and floating point values are written with std::to_chars, the
+    latter in their shortest round trip form, enums as their underlying
+    integers, bools as true or false, and char arrays up to their first
+    '\0'. */
+template <char separator = ' ', typename... Elements>
+    requires((hal::detail::is_formattable<Elements> && ...))
+auto format_to(char* out, Elements const&... elements) -> char*
+{
+    [[maybe_unused]] auto first = true;
+    ((first ? void() : void(*out++ = separator), first = false,
+      out = hal::detail::format_element(out, elements)),
+     ...);
+    return out;
+}
+
+namespace memberwise {
+
+/** Most characters memberwise::format_to writes for an \p Aggregate, with a
+    separator between each member. */
+template <typename Aggregate>
+inline constexpr auto max_formatted_size_v = [] {
+    using Members = hal::detail::Members_t<Aggregate>;
+    return []<typename... Types>(std::tuple<Types...> const*)
+    {
+        return hal::max_formatted_size_v<Types...>;
+    }
+    (static_cast<Members const*>(nullptr));
+}();
+
+/** Writes the members of \p aggregate to \p out as hal::format_to does, and
+    returns the end of what was written. \p out must have room for
+    max_formatted_size_v<Aggregate> characters. */
+template <char separator = ' ', typename Aggregate>
+auto format_to(char* out, Aggregate const& aggregate) -> char*
+{
+    return std::apply(
+        [out](auto const&... members) {
+            return hal::format_to<separator>(out, members...);
+        },
+        hal::to_ref_tuple(aggregate));
+}
+
+}  // namespace memberwise
+}  // namespace hal
+#endif  // HAL_FORMAT_HPP
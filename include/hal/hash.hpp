@@ -0,0 +1,324 @@
+#ifndef HAL_HASH_HPP
+#define HAL_HASH_HPP
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+
+#include <hal.hpp>
+
+namespace hal {
+
+/* ---------------------------------- hash ---------------------------------- */
+// Hashes elements, or the members of an aggregate, with the multiply and
+// fold mixing of wyhash: a 64 by 64 bit multiply whose high and low halves
+// are xored together. Each element is turned into a 64-bit word, and words
+// are mixed two at a time. Aggregates of integers without padding are hashed
+// as one run of bytes instead.
+namespace detail {
+
+inline constexpr auto hash_secret = std::array<std::uint64_t, 4>{
+    0xa0761d6478bd642f, 0xe7037ed1a0b428db, 0x8ebc6af09c88c6e3,
+    0x589965cc75374cc3};
+
+/// The high and low halves of \p a * \p b, xored together.
+constexpr auto hash_mix(std::uint64_t a, std::uint64_t b) -> std::uint64_t
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ using Product = unsigned __int128;
+    auto const product          = static_cast<Product>(a) * b;
+    return static_cast<std::uint64_t>(product) ^
+           static_cast<std::uint64_t>(product >> 64);
+#else
+    auto const a_high = a >> 32, a_low = a & 0xFFFFFFFF;
+    auto const b_high = b >> 32, b_low = b & 0xFFFFFFFF;
+    auto const high = a_high * b_high, low = a_low * b_low;
+    auto const middle_1 = a_high * b_low, middle_2 = a_low * b_high;
+    auto const carry = ((low >> 32) + (middle_1 & 0xFFFFFFFF) +
+                        (middle_2 & 0xFFFFFFFF)) >> 32;
+    return (low + (middle_1 << 32) + (middle_2 << 32)) ^
+           (high + (middle_1 >> 32) + (middle_2 >> 32) + carry);
+#endif
+}
+
+/// Reads \p size bytes at \p data as a little endian integer.
+template <typename Byte>
+constexpr auto hash_load(Byte const* data, std::size_t size) -> std::uint64_t
+{
+    if (!std::is_constant_evaluated() &&
+        std::endian::native == std::endian::little) {
+        auto result = std::uint64_t{0};
+        std::memcpy(&result, data, size);
+        return result;
+    }
+    auto result = std::uint64_t{0};
+    for (auto i = std::size_t{0}; i < size; ++i)
+        result |= std::uint64_t{static_cast<unsigned char>(data[i])} << 8 * i;
+    return result;
+}
+
+/** Hash of the \p size bytes at \p data, wyhash. Reads 48 bytes at a time,
+    in three independent chains. */
+template <typename Byte>
+constexpr auto hash_bytes(Byte const* data,
+                          std::size_t size,
+                          std::uint64_t seed) -> std::uint64_t
+{
+    constexpr auto& secret = hash_secret;
+    auto const load8 = [](Byte const* p) { return detail::hash_load(p, 8); };
+    auto const load4 = [](Byte const* p) { return detail::hash_load(p, 4); };
+    seed ^= detail::hash_mix(seed ^ secret[0], secret[1]);
+    auto a = std::uint64_t{0};
+    auto b = std::uint64_t{0};
+    if (size <= 16) {
+        if (size >= 4) {
+            auto const middle = (size >> 3) << 2;
+            a = load4(data) << 32 | load4(data + middle);
+            b = load4(data + size - 4) << 32 | load4(data + size - 4 - middle);
+        }
+        else if (size > 0) {
+            a = detail::hash_load(data, 1) << 16 |
+                detail::hash_load(data + (size >> 1), 1) << 8 |
+                detail::hash_load(data + size - 1, 1);
+        }
+    }
+    else {
+        auto rest = size;
+        if (rest > 48) {
+            auto seed_1 = seed;
+            auto seed_2 = seed;
+            do {
+                seed = detail::hash_mix(load8(data) ^ secret[1],
+                                        load8(data + 8) ^ seed);
+                seed_1 = detail::hash_mix(load8(data + 16) ^ secret[2],
+                                          load8(data + 24) ^ seed_1);
+                seed_2 = detail::hash_mix(load8(data + 32) ^ secret[3],
+                                          load8(data + 40) ^ seed_2);
+                data += 48;
+                rest -= 48;
+            } while (rest > 48);
+            seed ^= seed_1 ^ seed_2;
+        }
+        for (; rest > 16; rest -= 16, data += 16) {
+            seed = detail::hash_mix(load8(data) ^ secret[1],
+                                    load8(data + 8) ^ seed);
+        }
+        a = load8(data + rest - 16);
+        b = load8(data + rest - 8);
+    }
+    return detail::hash_mix(secret[1] ^ size,
+                            detail::hash_mix(a ^ secret[1], b ^ seed));
+}
+
+template <typename T>
+inline constexpr auto is_std_array_of = false;
+
+/// Is true for the types that hash supports.
+template <typename T>
+inline constexpr auto is_hashable =
+    ((std::is_arithmetic_v<T> || std::is_enum_v<T>) && sizeof(T) <= 8) ||
+    std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> ||
+    is_std_array_of<T>;
+
+template <typename T, std::size_t N>
+inline constexpr auto is_std_array_of<std::array<T, N>> = is_hashable<T>;
+
+template <typename... Elements>
+constexpr auto hash_elements(std::uint64_t seed, Elements const&... elements)
+    -> std::uint64_t;
+
+/// \p value as a 64-bit word, equal for equal values.
+template <typename T>
+constexpr auto hash_word(T const& value) -> std::uint64_t
+{
+    if constexpr (std::is_enum_v<T>)
+        return static_cast<std::uint64_t>(
+            static_cast<std::underlying_type_t<T>>(value));
+    else if constexpr (std::is_integral_v<T>)
+        return static_cast<std::uint64_t>(value);
+    else if constexpr (std::is_floating_point_v<T>) {
+        // -0.0 == 0.0, so both hash as 0.
+        using Bits = std::conditional_t<sizeof(T) == 4, std::uint32_t,
+                                        std::uint64_t>;
+        return value == T{0} ? 0 : std::bit_cast<Bits>(value);
+    }
+    else if constexpr (is_std_array_of<T>) {
+        return std::apply(
+            [](auto const&... elements) {
+                return detail::hash_elements(0, elements...);
+            },
+            value);
+    }
+    else
+        return detail::hash_bytes(value.data(), value.size(), 0);
+}
+
+/// Mixes the words of \p elements two at a time, into a hash.
+template <typename... Elements>
+constexpr auto hash_elements(std::uint64_t seed, Elements const&... elements)
+    -> std::uint64_t
+{
+    constexpr auto& secret = hash_secret;
+    constexpr auto count   = sizeof...(Elements);
+    auto const words = std::array<std::uint64_t, count + count % 2>{
+        detail::hash_word(elements)...};
+    seed ^= detail::hash_mix(seed ^ secret[0], secret[1]);
+    for (auto i = std::size_t{0}; i < words.size(); i += 2) {
+        seed = detail::hash_mix(words[i] ^ secret[1],
+                                words[i + 1] ^ seed);
+    }
+    return detail::hash_mix(secret[1] ^ count, seed ^ secret[2]);
+}
+
+/** Is true if the bytes of \p Aggregate are its value, so it is hashed as
+    one run of bytes: integers, enums and arrays of them, without padding. */
+template <typename Aggregate>
+inline constexpr auto is_hashed_as_bytes = is_bitwise_comparable<Aggregate>;
+
+template <typename Aggregate, typename Members = Members_t<Aggregate>>
+inline constexpr auto is_memberwise_hashable = false;
+
+template <typename Aggregate, typename... Members>
+inline constexpr auto
+    is_memberwise_hashable<Aggregate, std::tuple<Members...>> =
+        (is_hashable<Members> && ...);
+
+}  // namespace detail
+
+/** Hash of \p elements, mixed in order. Elements can be arithmetic types of
+    up to 8 bytes, enums, std::string, std::string_view and std::arrays of
+    these. Equal elements give equal hashes, including 0.0 and -0.0. */
+template <typename... Elements>
+    requires((hal::detail::is_hashable<Elements> && ...))
+constexpr auto hash(Elements const&... elements) -> std::uint64_t
+{
+    return hal::detail::hash_elements(0, elements...);
+}
+
+namespace memberwise {
+
+/** Hash of the members of \p aggregate. An aggregate of integers and enums
+    without padding is hashed as one run of bytes, others member by member as
+    with hal::hash. */
+template <typename Aggregate>
+    requires(hal::detail::is_memberwise_hashable<Aggregate>)
+constexpr auto hash(Aggregate const& aggregate) -> std::uint64_t
+{
+    if constexpr (hal::detail::is_hashed_as_bytes<Aggregate>) {
+        auto const bytes =
+            std::bit_cast<std::array<std::byte, sizeof(Aggregate)>>(aggregate);
+        return hal::detail::hash_bytes(bytes.data(), bytes.size(), 0);
+    }
+    else {
+        return std::apply(
+            [](auto const&... members) {
+                return hal::detail::hash_elements(0, members...);
+            },
+            hal::to_ref_tuple(aggregate));
+    }
+}
+
+/** Hash function object for unordered containers keyed by aggregates, as in
+    std::unordered_map<Key, Value, hal::memberwise::hasher>. */
+struct hasher {
+    template <typename Aggregate>
+        requires(hal::detail::is_memberwise_hashable<Aggregate>)
+    constexpr auto operator()(Aggregate const& aggregate) const -> std::size_t
+    {
+        return static_cast<std::size_t>(memberwise::hash(aggregate));
+    }
+};
+
+}  // namespace memberwise
+
+/* --------------------------------- crc32c --------------------------------- */
+// CRC-32C, the Castagnoli polynomial used by iSCSI, ext4 and many storage
+// formats. With SSE4.2 it is computed 8 bytes per crc32 instruction, without
+// it 8 bytes per step with eight lookup tables, slicing by 8.
+namespace detail {
+
+inline constexpr auto crc32c_tables = [] {
+    auto tables = std::array<std::array<std::uint32_t, 256>, 8>{};
+    for (auto i = std::uint32_t{0}; i < 256; ++i) {
+        auto crc = i;
+        for (auto bit = 0; bit < 8; ++bit)
+            crc = crc >> 1 ^ (crc & 1 ? 0x82F63B78u : 0u);
+        tables[0][i] = crc;
+    }
+    for (auto i = std::size_t{0}; i < 256; ++i) {
+        for (auto t = std::size_t{1}; t < 8; ++t) {
+            auto const previous = tables[t - 1][i];
+            tables[t][i] = previous >> 8 ^ tables[0][previous & 0xFF];
+        }
+    }
+    return tables;
+}();
+
+/// Updates the uninverted \p crc with \p size bytes at \p data.
+constexpr auto crc32c_update(std::uint32_t crc,
+                             std::byte const* data,
+                             std::size_t size) -> std::uint32_t
+{
+    constexpr auto& t = crc32c_tables;
+#if defined(__SSE4_2__)
+    if (!std::is_constant_evaluated()) {
+        auto crc64 = std::uint64_t{crc};
+        for (; size >= 8; size -= 8, data += 8)
+            crc64 = _mm_crc32_u64(crc64, detail::hash_load(data, 8));
+        crc = static_cast<std::uint32_t>(crc64);
+        for (; size > 0; --size, ++data)
+            crc = _mm_crc32_u8(crc, std::to_integer<unsigned char>(*data));
+        return crc;
+    }
+#endif
+    for (; size >= 8; size -= 8, data += 8) {
+        auto const word = detail::hash_load(data, 8) ^ crc;
+        crc = t[7][word & 0xFF] ^ t[6][word >> 8 & 0xFF] ^
+              t[5][word >> 16 & 0xFF] ^ t[4][word >> 24 & 0xFF] ^
+              t[3][word >> 32 & 0xFF] ^ t[2][word >> 40 & 0xFF] ^
+              t[1][word >> 48 & 0xFF] ^ t[0][word >> 56];
+    }
+    for (; size > 0; --size, ++data)
+        crc = crc >> 8 ^ t[0][(crc ^ std::to_integer<std::uint32_t>(*data)) &
+                              0xFF];
+    return crc;
+}
+
+}  // namespace detail
+
+/** CRC-32C of \p bytes. Pass the CRC of the bytes before them as \p crc to
+    continue a checksum over several pieces. */
+constexpr auto crc32c(std::span<std::byte const> bytes, std::uint32_t crc = 0)
+    -> std::uint32_t
+{
+    return ~hal::detail::crc32c_update(~crc, bytes.data(), bytes.size());
+}
+
+namespace memberwise {
+
+/** CRC-32C of the bytes of \p aggregate as written by memberwise::serialize,
+    without padding and little endian, so it is the same on every platform
+    and matches a CRC of the serialized record. */
+template <typename Aggregate>
+    requires(hal::detail::is_serializable<Aggregate>)
+constexpr auto crc32c(Aggregate const& aggregate, std::uint32_t crc = 0)
+    -> std::uint32_t
+{
+    auto bytes = std::array<std::byte, serialized_size_v<Aggregate>>{};
+    memberwise::serialize(aggregate, bytes);
+    return hal::crc32c(bytes, crc);
+}
+
+}  // namespace memberwise
+}  // namespace hal
+#endif  // HAL_HASH_HPP
@@ -0,0 +1,99 @@
+#ifndef HAL_MAPPED_FILE_HPP
+#define HAL_MAPPED_FILE_HPP
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hal::detail {
+
+/* ------------------------------ Mapped_file ------------------------------- */
+/** Read only memory mapping of a whole file, with POSIX mmap. Empty files are
+    not mapped and have no bytes. */
+class Mapped_file {
+   public:
+    Mapped_file() = default;
+
+    /** Maps the file at \p path. Throws std::system_error if it can't be
+        opened or mapped, with \p owner at the start of the message. */
+    Mapped_file(std::filesystem::path const& path, char const* owner)
+    {
+        auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1)
+            throw_errno(owner, "open", errno);
+        struct stat info {};
+        if (::fstat(fd, &info) == -1) {
+            auto const error = errno;
+            ::close(fd);
+            throw_errno(owner, "fstat", error);
+        }
+        auto const size = static_cast<std::size_t>(info.st_size);
+        if (size != 0) {
+            auto* const data =
+                ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED) {
+                auto const error = errno;
+                ::close(fd);
+                throw_errno(owner, "mmap", error);
+            }
+            data_ = static_cast<std::byte const*>(data);
+            size_ = size;
+            // Only a hint, files are usually read front to back.
+            ::madvise(data, size_, MADV_SEQUENTIAL);
+        }
+        ::close(fd);
+    }
+
+    Mapped_file(Mapped_file&& other) noexcept
+        : data_{std::exchange(other.data_, nullptr)},
+          size_{std::exchange(other.size_, 0)}
+    {}
+
+    auto operator=(Mapped_file&& other) noexcept -> Mapped_file&
+    {
+        if (this != &other) {
+            unmap();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    ~Mapped_file() { unmap(); }
+
+   public:
+    /// The mapped bytes, page aligned.
+    auto bytes() const -> std::span<std::byte const> { return {data_, size_}; }
+
+   private:
+    [[noreturn]] static void throw_errno(char const* owner,
+                                         char const* call,
+                                         int error)
+    {
+        throw std::system_error{error, std::generic_category(),
+                                std::string{owner} + ": " + call};
+    }
+
+    void unmap()
+    {
+        if (data_ != nullptr)
+            ::munmap(const_cast<std::byte*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+   private:
+    std::byte const* data_ = nullptr;
+    std::size_t size_      = 0;
+};
+
+}  // namespace hal::detail
+#endif  // HAL_MAPPED_FILE_HPP
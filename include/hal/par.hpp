@@ -0,0 +1,480 @@
+#ifndef HAL_PAR_HPP
+#define HAL_PAR_HPP
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <hal.hpp>
+
+namespace hal::par {
+
+/* --------------------------------- Pool ----------------------------------- */
+
+/** Work-stealing thread pool. Each worker thread has its own queue of tasks,
+    and takes tasks from the other queues once its own is empty. The thread
+    calling run() also executes tasks until the ones it submitted are done, so
+    nested calls to run() from within a task do not deadlock. When there are
+    none left to take, it sleeps until its tasks are done or more are queued,
+    the same way idle workers do. */
+class Pool {
+   public:
+    /// Create a pool with \p thread_count worker threads, zero is allowed.
+    explicit Pool(std::size_t thread_count) : queues_(thread_count)
+    {
+        for (auto& queue : queues_)
+            queue = std::make_unique<Queue>();
+        threads_.reserve(thread_count);
+        for (auto i = std::size_t{0}; i < thread_count; ++i)
+            threads_.emplace_back([this, i] { work(i); });
+    }
+
+    Pool(Pool const&)                    = delete;
+    auto operator=(Pool const&) -> Pool& = delete;
+
+    ~Pool()
+    {
+        {
+            auto const lock = std::lock_guard{sleep_mutex_};
+            stop_           = true;
+        }
+        wake_.notify_all();
+        for (auto& thread : threads_)
+            thread.join();
+    }
+
+   public:
+    /// Number of worker threads, not counting threads that call run().
+    auto size() const -> std::size_t { return threads_.size(); }
+
+    /** Calls invoke(context, i) for each i in [0, count), and returns once
+        all calls are done. Rethrows the first exception thrown by a call. */
+    void run(void (*invoke)(void*, std::size_t),
+             void* context,
+             std::size_t count)
+    {
+        auto group = Group{};
+        group.remaining.store(count, std::memory_order_relaxed);
+
+        if (queues_.empty()) {
+            for (auto i = std::size_t{0}; i < count; ++i)
+                execute(Task{invoke, context, i, &group});
+        }
+        else {
+            // Spread tasks over the queues, starting with this thread's own.
+            auto const first = (worker_index_ < queues_.size())
+                                   ? worker_index_
+                                   : next_queue_++ % queues_.size();
+            // Counted before they are queued, so the count never underflows.
+            {
+                auto const lock = std::lock_guard{sleep_mutex_};
+                queued_.fetch_add(count, std::memory_order_relaxed);
+            }
+            for (auto i = std::size_t{0}; i < count; ++i) {
+                auto& queue     = *queues_[(first + i) % queues_.size()];
+                auto const lock = std::lock_guard{queue.mutex};
+                queue.tasks.push_back(Task{invoke, context, i, &group});
+            }
+            wake_.notify_all();
+
+            auto const done = [&group] {
+                return group.remaining.load(std::memory_order_acquire) == 0;
+            };
+            while (!done()) {
+                if (auto task = take(first)) {
+                    execute(*task);
+                    continue;
+                }
+                auto lock = std::unique_lock{sleep_mutex_};
+                wake_.wait(lock, [&] {
+                    return done() ||
+                           queued_.load(std::memory_order_relaxed) != 0;
+                });
+            }
+        }
+
+        if (group.error)
+            std::rethrow_exception(group.error);
+    }
+
+   private:
+    /// Tasks submitted by a single call to run().
+    struct Group {
+        std::atomic<std::size_t> remaining;
+        std::mutex error_mutex;
+        std::exception_ptr error;
+    };
+
+    struct Task {
+        void (*invoke)(void*, std::size_t);
+        void* context;
+        std::size_t index;
+        Group* group;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+   private:
+    void work(std::size_t index)
+    {
+        worker_index_ = index;
+        while (true) {
+            if (auto task = take(index)) {
+                execute(*task);
+                continue;
+            }
+            auto lock = std::unique_lock{sleep_mutex_};
+            wake_.wait(lock, [this] {
+                return stop_ || queued_.load(std::memory_order_relaxed) != 0;
+            });
+            if (stop_)
+                return;
+        }
+    }
+
+    /// Newest task of queue \p index, or else the oldest of any other queue.
+    auto take(std::size_t index) -> std::optional<Task>
+    {
+        for (auto i = std::size_t{0}; i < queues_.size(); ++i) {
+            auto& queue     = *queues_[(index + i) % queues_.size()];
+            auto const lock = std::lock_guard{queue.mutex};
+            if (queue.tasks.empty())
+                continue;
+            auto task = Task{};
+            if (i == 0) {
+                task = queue.tasks.back();
+                queue.tasks.pop_back();
+            }
+            else {
+                task = queue.tasks.front();
+                queue.tasks.pop_front();
+            }
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+        return std::nullopt;
+    }
+
+    void execute(Task const& task)
+    {
+        try {
+            task.invoke(task.context, task.index);
+        }
+        catch (...) {
+            auto const lock = std::lock_guard{task.group->error_mutex};
+            if (!task.group->error)
+                task.group->error = std::current_exception();
+        }
+        auto const left =
+            task.group->remaining.fetch_sub(1, std::memory_order_acq_rel) - 1;
+        if (left == 0) {
+            // Locking orders this with a caller of run() about to sleep, so
+            // it either sees the group done or gets the notification.
+            {
+                auto const lock = std::lock_guard{sleep_mutex_};
+            }
+            wake_.notify_all();
+        }
+    }
+
+   private:
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> threads_;
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+    std::atomic<std::size_t> queued_{0};
+    std::atomic<std::size_t> next_queue_{0};
+
+    // Index of the worker running on this thread, or -1 for other threads.
+    static inline thread_local auto worker_index_ =
+        static_cast<std::size_t>(-1);
+};
+
+/// Pool used by the hal::par:: algorithms, with one worker less than there
+/// are hardware threads, since the calling thread also executes tasks.
+inline auto default_pool() -> Pool&
+{
+    static auto pool =
+        Pool{std::max(std::thread::hardware_concurrency(), 1u) - 1};
+    return pool;
+}
+
+namespace detail {
+
+/// Type erased reference to an element of a parameter pack.
+template <typename Fn>
+struct Thunk {
+    void (*call)(Fn&, void*);
+    void* element;
+};
+
+/** Calls fn(index, element), with index a std::integral_constant of \p I,
+    and the value category of \p Element. */
+template <std::size_t I, typename Element, typename Fn>
+void call_with(Fn& fn, void* element)
+{
+    fn(std::integral_constant<std::size_t, I>{},
+       static_cast<Element&&>(
+           *static_cast<std::remove_reference_t<Element>*>(element)));
+}
+
+template <typename Element>
+auto address_of(Element& element) -> void*
+{
+    return const_cast<void*>(static_cast<void const*>(std::addressof(element)));
+}
+
+/// Calls fn(index, element) for each element, as tasks on the default pool.
+template <typename Fn, typename... Elements>
+void run_each(Fn& fn, Elements&&... elements)
+{
+    auto const thunks = [&]<std::size_t... I>(std::index_sequence<I...>)
+    {
+        return std::array<Thunk<Fn>, sizeof...(Elements)>{
+            Thunk<Fn>{&call_with<I, Elements, Fn>, address_of(elements)}...};
+    }
+    (std::make_index_sequence<sizeof...(Elements)>{});
+
+    struct Context {
+        Fn& fn;
+        Thunk<Fn> const* thunks;
+    } context{fn, thunks.data()};
+
+    default_pool().run(
+        [](void* c, std::size_t i) {
+            auto& context = *static_cast<Context*>(c);
+            context.thunks[i].call(context.fn, context.thunks[i].element);
+        },
+        &context, sizeof...(Elements));
+}
+
+}  // namespace detail
+
+/* -------------------------------- for_each -------------------------------- */
+template <typename UnaryOp, typename... Elements>
+    requires((std::invocable<UnaryOp, Elements> && ...))
+constexpr auto for_each_impl(UnaryOp&& func, Elements&&... elements) -> void
+{
+    if (std::is_constant_evaluated() || sizeof...(Elements) < 2) {
+        hal::for_each_impl(func, std::forward<Elements>(elements)...);
+        return;
+    }
+    auto call = [&func](auto, auto&& x) { func(std::forward<decltype(x)>(x)); };
+    detail::run_each(call, std::forward<Elements>(elements)...);
+}
+
+inline auto constexpr for_each =
+    hal::detail::make_curried<2>([](auto&& a, auto&&... b) {
+        return hal::par::for_each_impl(std::forward<decltype(a)>(a),
+                                       std::forward<decltype(b)>(b)...);
+    });
+
+/* ------------------------------- transform -------------------------------- */
+template <typename UnaryOp, typename... Elements>
+    requires(
+        (std::invocable<UnaryOp, Elements> && ...) &&
+        (std::assignable_from<Elements,
+                              hal::detail::Return_t<UnaryOp, Elements>> &&
+         ...) &&
+        (!std::is_rvalue_reference_v<Elements> && ...))
+constexpr auto transform_impl(UnaryOp&& transform_fn, Elements&&... elements)
+    -> void
+{
+    if (std::is_constant_evaluated() || sizeof...(Elements) < 2) {
+        hal::transform_impl(transform_fn, std::forward<Elements>(elements)...);
+        return;
+    }
+    auto assign = [&transform_fn](auto, auto& x) { x = transform_fn(x); };
+    detail::run_each(assign, std::forward<Elements>(elements)...);
+}
+
+inline auto constexpr transform =
+    hal::detail::make_curried<2>([](auto&& a, auto&&... b) {
+        return hal::par::transform_impl(std::forward<decltype(a)>(a),
+                                        std::forward<decltype(b)>(b)...);
+    });
+
+/* ---------------------------- transform_reduce ---------------------------- */
+/** The transforms run in parallel, their results are then reduced in element
+    order on the calling thread, so the result matches hal::transform_reduce
+    even if reduce_fn is not associative. */
+template <typename T, typename UnaryOp, typename BinaryOp, typename... Elements>
+    // clang-format off
+    requires(
+        (std::invocable<UnaryOp, Elements> && ...) &&
+        (std::invocable<BinaryOp, T, hal::detail::Return_t<UnaryOp, Elements>> && ...))
+// clang-format on
+constexpr auto transform_reduce_impl(T init,
+                                     UnaryOp&& transform_fn,
+                                     BinaryOp&& reduce_fn,
+                                     Elements&&... elements) -> T
+{
+    if (std::is_constant_evaluated() || sizeof...(Elements) < 2) {
+        return hal::transform_reduce_impl(std::move(init), transform_fn,
+                                          reduce_fn,
+                                          std::forward<Elements>(elements)...);
+    }
+    else {
+        auto results = std::tuple<std::optional<std::remove_cvref_t<
+            hal::detail::Return_t<UnaryOp, Elements>>>...>{};
+        // Each task stores its result in its own slot.
+        auto store = [&](auto index, auto&& x) {
+            std::get<index>(results).emplace(
+                transform_fn(std::forward<decltype(x)>(x)));
+        };
+        detail::run_each(store, std::forward<Elements>(elements)...);
+
+        std::apply(
+            [&](auto&... result) {
+                ((init = reduce_fn(std::move(init), std::move(*result))), ...);
+            },
+            results);
+        return init;
+    }
+}
+
+inline auto constexpr transform_reduce = hal::detail::make_curried<4>(
+    [](auto&& a, auto&& b, auto&& c, auto&&... d) {
+        return hal::par::transform_reduce_impl(
+            std::forward<decltype(a)>(a), std::forward<decltype(b)>(b),
+            std::forward<decltype(c)>(c), std::forward<decltype(d)>(d)...);
+    });
+
+/* --------------------------- memberwise::batch ---------------------------- */
+namespace detail {
+
+/** Calls fn(first, last) on consecutive ranges that cover [0, count), as
+    tasks on the default pool. Makes a few tasks per thread, so threads that
+    finish early can steal the remaining ranges. */
+template <typename Fn>
+void run_ranges(Fn& fn, std::size_t count)
+{
+    auto& pool       = default_pool();
+    auto const tasks = std::min(count, 4 * (pool.size() + 1));
+
+    struct Context {
+        Fn& fn;
+        std::size_t count;
+        std::size_t tasks;
+    } context{fn, count, tasks};
+
+    pool.run(
+        [](void* c, std::size_t task) {
+            auto& context = *static_cast<Context*>(c);
+            context.fn(task * context.count / context.tasks,
+                       (task + 1) * context.count / context.tasks);
+        },
+        &context, tasks);
+}
+
+}  // namespace detail
+
+namespace memberwise::batch {
+
+/** The chunks are reduced in parallel, and merged in order on the calling
+    thread, so the result is the same as hal::memberwise::batch. */
+template <typename Result,
+          typename UnaryOp,
+          typename BinaryOp,
+          typename Aggregate>
+    requires(hal::member_count_v<Result> == hal::member_count_v<Aggregate>)
+constexpr auto transform_reduce_impl(Result init,
+                                     UnaryOp&& transform_fn,
+                                     BinaryOp&& reduce_fn,
+                                     std::span<Aggregate> records) -> Result
+{
+    auto const chunks = hal::detail::batch_chunk_count(records);
+    if (std::is_constant_evaluated() || chunks < 2 ||
+        hal::member_count_v<Result> == 0) {
+        return hal::memberwise::batch::transform_reduce_impl(
+            std::move(init), transform_fn, reduce_fn, records);
+    }
+    else {
+        auto partials      = std::vector<std::optional<Result>>(chunks);
+        auto reduce_chunks = [&](std::size_t first, std::size_t last) {
+            for (auto i = first; i < last; ++i) {
+                partials[i].emplace(hal::detail::batch_reduce_chunk<Result>(
+                    transform_fn, reduce_fn,
+                    hal::detail::batch_chunk(records, i)));
+            }
+        };
+        detail::run_ranges(reduce_chunks, chunks);
+
+        for (auto& partial : partials) {
+            init = hal::detail::batch_merge(reduce_fn, std::move(init),
+                                            std::move(*partial));
+        }
+        return init;
+    }
+}
+
+inline auto constexpr transform_reduce = hal::detail::make_curried<4>(
+    [](auto&& a, auto&& b, auto&& c, auto&& d) {
+        return hal::par::memberwise::batch::transform_reduce_impl(
+            std::forward<decltype(a)>(a), std::forward<decltype(b)>(b),
+            std::forward<decltype(c)>(c), hal::detail::as_span(d));
+    });
+
+template <typename Result, typename BinaryOp, typename Aggregate>
+    requires(hal::member_count_v<Result> == hal::member_count_v<Aggregate>)
+constexpr auto reduce_impl(Result init,
+                           BinaryOp&& reduce_fn,
+                           std::span<Aggregate> records) -> Result
+{
+    return batch::transform_reduce_impl(std::move(init), std::identity{},
+                                        reduce_fn, records);
+}
+
+inline auto constexpr reduce =
+    hal::detail::make_curried<3>([](auto&& a, auto&& b, auto&& c) {
+        return hal::par::memberwise::batch::reduce_impl(
+            std::forward<decltype(a)>(a), std::forward<decltype(b)>(b),
+            hal::detail::as_span(c));
+    });
+
+/// Chunks are visited in parallel, func is called from several threads.
+template <typename UnaryOp, typename Aggregate>
+constexpr void for_each_impl(UnaryOp&& func, std::span<Aggregate> records)
+{
+    auto const chunks = hal::detail::batch_chunk_count(records);
+    if (std::is_constant_evaluated() || chunks < 2) {
+        hal::memberwise::batch::for_each_impl(func, records);
+        return;
+    }
+    auto visit_chunks = [&](std::size_t first, std::size_t last) {
+        for (auto i = first; i < last; ++i) {
+            hal::detail::batch_for_each_chunk(
+                func, hal::detail::batch_chunk(records, i));
+        }
+    };
+    detail::run_ranges(visit_chunks, chunks);
+}
+
+inline auto constexpr for_each =
+    hal::detail::make_curried<2>([](auto&& a, auto&& b) {
+        return hal::par::memberwise::batch::for_each_impl(
+            std::forward<decltype(a)>(a), hal::detail::as_span(b));
+    });
+
+}  // namespace memberwise::batch
+
+}  // namespace hal::par
+
+#endif  // HAL_PAR_HPP
@@ -0,0 +1,277 @@
+#ifndef HAL_PARSE_HPP
+#define HAL_PARSE_HPP
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <filesystem>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <hal.hpp>
+#include <hal/mapped_file.hpp>
+#include <hal/par.hpp>
+
+namespace hal {
+
+/* ------------------------- memberwise::parse ------------------------------ */
+// Parses a line of delimited text, such as CSV or TSV without quoting, into
+// an aggregate. Each field is parsed according to the type of its member:
+// std::from_chars for arithmetic types and enums, a slice of the line for
+// std::string_view. Only std::string members allocate.
+namespace detail {
+
+/// Is true for the member types that parse supports.
+template <typename T>
+inline constexpr auto is_parsable_member =
+    std::is_arithmetic_v<T> || std::is_enum_v<T> ||
+    std::is_same_v<T, std::string_view> || std::is_same_v<T, std::string>;
+
+template <typename Aggregate, typename Members = Members_t<Aggregate>>
+inline constexpr auto is_parsable = false;
+
+template <typename Aggregate, typename... Members>
+inline constexpr auto is_parsable<Aggregate, std::tuple<Members...>> =
+    (is_parsable_member<Members> && ...);
+
+/** Parses all of \p field as a \p T, and clears \p ok if it isn't one.
+    Booleans are 0, 1, false or true, a char is a single character. */
+template <typename T>
+auto parse_field(std::string_view field, bool& ok) -> T
+{
+    if constexpr (std::is_same_v<T, std::string_view>)
+        return field;
+    else if constexpr (std::is_same_v<T, std::string>)
+        return std::string{field};
+    else if constexpr (std::is_same_v<T, bool>) {
+        auto const value = field == "1" || field == "true";
+        ok = ok && (value || field == "0" || field == "false");
+        return value;
+    }
+    else if constexpr (std::is_same_v<T, char>) {
+        ok = ok && field.size() == 1;
+        return field.empty() ? '\0' : field.front();
+    }
+    else if constexpr (std::is_enum_v<T>) {
+        return static_cast<T>(
+            detail::parse_field<std::underlying_type_t<T>>(field, ok));
+    }
+    else {
+        auto value              = T{};
+        auto const last         = field.data() + field.size();
+        auto const [end, error] = std::from_chars(field.data(), last, value);
+        ok = ok && error == std::errc{} && end == last;
+        return value;
+    }
+}
+
+/** The field of \p line from \p position up to the next \p delim, and moves
+    \p position past the delimiter. At the end of \p line, \p position is
+    past its size, and reading another field clears \p ok. */
+inline auto next_field(std::string_view line,
+                       char delim,
+                       std::size_t& position,
+                       bool& ok) -> std::string_view
+{
+    if (position > line.size()) {
+        ok = false;
+        return {};
+    }
+    auto const end   = std::min(line.find(delim, position), line.size());
+    auto const field = line.substr(position, end - position);
+    position         = end + 1;
+    return field;
+}
+
+}  // namespace detail
+
+namespace memberwise {
+
+/** Parses the fields of \p line, separated by \p delim, into an \p Aggregate,
+    a field per member. Returns std::nullopt if a field doesn't parse as its
+    member type, or there are too few or too many fields. A trailing '\r' is
+    ignored. std::string_view members point into \p line. */
+template <typename Aggregate>
+    requires(hal::detail::is_parsable<Aggregate>)
+auto try_parse(std::string_view line, char delim) -> std::optional<Aggregate>
+{
+    if (!line.empty() && line.back() == '\r')
+        line.remove_suffix(1);
+    using Members = hal::detail::Members_t<Aggregate>;
+    auto position = std::size_t{0};
+    auto ok       = true;
+    // Braced initializers are evaluated in order, so fields are read in order.
+    auto members = [&]<std::size_t... I>(std::index_sequence<I...>)
+    {
+        return Members{
+            hal::detail::parse_field<std::tuple_element_t<I, Members>>(
+                hal::detail::next_field(line, delim, position, ok),
+                ok)...};
+    }
+    (std::make_index_sequence<std::tuple_size_v<Members>>{});
+    if (!ok || position != line.size() + 1)
+        return std::nullopt;
+    return hal::from_tuple<Aggregate>(std::move(members));
+}
+
+/// Like try_parse, but throws std::runtime_error if \p line doesn't parse.
+template <typename Aggregate>
+    requires(hal::detail::is_parsable<Aggregate>)
+auto parse(std::string_view line, char delim) -> Aggregate
+{
+    if (auto record = memberwise::try_parse<Aggregate>(line, delim))
+        return std::move(*record);
+    throw std::runtime_error{"hal::memberwise::parse: can't parse \"" +
+                             std::string{line} + "\""};
+}
+
+}  // namespace memberwise
+
+/* ----------------------------- delimited_file ----------------------------- */
+/** Read only view of a text file with a record of type \p T per line, parsed
+    with memberwise::parse. The file is memory mapped, and split at line
+    boundaries into chunks that are parsed in parallel on a par::Pool. Empty
+    lines are skipped. Needs POSIX mmap. */
+template <typename T>
+    requires(hal::detail::is_parsable<T>)
+class delimited_file {
+   public:
+    using value_type = T;
+
+    /// Chunks are at least this many bytes, so each is worth a task.
+    static constexpr auto min_chunk_size = std::size_t{1} << 20;
+
+   public:
+    /** Maps the file at \p path, with fields separated by \p delim, and skips
+        its first \p skip_lines lines, such as a header. Throws
+        std::system_error if the file can't be opened or mapped. */
+    explicit delimited_file(std::filesystem::path const& path,
+                            char delim             = ',',
+                            std::size_t skip_lines = 0)
+        : file_{path, "hal::delimited_file"}, delim_{delim}
+    {
+        text_ = std::string_view{begin(), file_.bytes().size()};
+        for (auto i = std::size_t{0}; i < skip_lines && !text_.empty(); ++i) {
+            auto const newline = std::min(text_.find('\n'), text_.size() - 1);
+            text_.remove_prefix(newline + 1);
+        }
+    }
+
+   public:
+    /// The text after the skipped lines.
+    auto text() const -> std::string_view { return text_; }
+    auto delimiter() const -> char { return delim_; }
+
+    /** Parses every record, in parallel on \p pool, and returns them in file
+        order. Throws std::runtime_error at the first line that doesn't
+        parse. */
+    auto read(par::Pool& pool = par::default_pool()) const -> std::vector<T>
+    {
+        auto const chunks = split(pool);
+        auto parsed       = std::vector<std::vector<T>>(chunks.size());
+        run(pool, chunks, [&](std::size_t i, std::vector<T>&& records) {
+            parsed[i] = std::move(records);
+        });
+        auto size = std::size_t{0};
+        for (auto const& records : parsed)
+            size += records.size();
+        auto result = std::vector<T>{};
+        result.reserve(size);
+        for (auto& records : parsed) {
+            result.insert(result.end(),
+                          std::make_move_iterator(records.begin()),
+                          std::make_move_iterator(records.end()));
+        }
+        return result;
+    }
+
+    /** Parses the records a chunk at a time, in parallel on \p pool, and
+        calls fn(std::span<T const>) with the records of each chunk, in file
+        order within the chunk. Chunks are passed to \p fn concurrently and in
+        any order, and only a chunk per thread is held in memory. */
+    template <typename Fn>
+    void for_each_chunk(Fn&& fn, par::Pool& pool = par::default_pool()) const
+    {
+        run(pool, split(pool), [&](std::size_t, std::vector<T>&& records) {
+            fn(std::span<T const>{records});
+        });
+    }
+
+   private:
+    /// The text split into chunks of whole lines, a few per thread.
+    auto split(par::Pool const& pool) const -> std::vector<std::string_view>
+    {
+        auto const wanted = (pool.size() + 1) * 4;
+        auto const size   = std::max(text_.size() / wanted, min_chunk_size);
+        auto chunks       = std::vector<std::string_view>{};
+        for (auto rest = text_; !rest.empty();) {
+            auto const newline = size < rest.size() ? rest.find('\n', size)
+                                                    : rest.npos;
+            auto const end = std::min(newline, rest.size() - 1) + 1;
+            chunks.push_back(rest.substr(0, end));
+            rest.remove_prefix(end);
+        }
+        return chunks;
+    }
+
+    /// Parses each of \p chunks on \p pool, and passes each to \p done.
+    template <typename Done>
+    void run(par::Pool& pool,
+             std::vector<std::string_view> const& chunks,
+             Done done) const
+    {
+        struct Context {
+            delimited_file const& file;
+            std::vector<std::string_view> const& chunks;
+            Done& done;
+        } context{*this, chunks, done};
+        pool.run(
+            [](void* c, std::size_t i) {
+                auto& context = *static_cast<Context*>(c);
+                context.done(i, context.file.parse_chunk(context.chunks[i]));
+            },
+            &context, chunks.size());
+    }
+
+    auto begin() const -> char const*
+    {
+        return reinterpret_cast<char const*>(file_.bytes().data());
+    }
+
+    auto parse_chunk(std::string_view chunk) const -> std::vector<T>
+    {
+        auto records = std::vector<T>{};
+        while (!chunk.empty()) {
+            auto const end  = std::min(chunk.find('\n'), chunk.size());
+            auto const line = chunk.substr(0, end);
+            chunk.remove_prefix(std::min(end + 1, chunk.size()));
+            if (line.empty() || line == "\r")
+                continue;
+            auto record = memberwise::try_parse<T>(line, delim_);
+            if (!record) {
+                throw std::runtime_error{
+                    "hal::delimited_file: can't parse line at byte " +
+                    std::to_string(line.data() - begin()) + ": \"" +
+                    std::string{line} + "\""};
+            }
+            records.push_back(std::move(*record));
+        }
+        return records;
+    }
+
+   private:
+    detail::Mapped_file file_;
+    std::string_view text_;
+    char delim_;
+};
+
+}  // namespace hal
+#endif  // HAL_PARSE_HPP
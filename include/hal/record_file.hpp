@@ -0,0 +1,132 @@
+#ifndef HAL_RECORD_FILE_HPP
+#define HAL_RECORD_FILE_HPP
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+
+#include <hal.hpp>
+#include <hal/mapped_file.hpp>
+
+namespace hal {
+
+/* ------------------------------ record_file ------------------------------- */
+/** Read only view of a file of records written by memberwise::serialize, one
+    after another with nothing in between. The file is memory mapped, so
+    records are read from the page cache without copying the file first.
+    Needs POSIX mmap. */
+template <typename T>
+    requires(hal::detail::is_serializable<T>)
+class record_file {
+   public:
+    using value_type = T;
+    using size_type  = std::size_t;
+
+    static constexpr auto record_size = memberwise::serialized_size_v<T>;
+
+    /// Iterates over the records, dereferences to a deserialized T.
+    class Iterator {
+       public:
+        using difference_type = std::ptrdiff_t;
+        using value_type      = T;
+
+        Iterator() = default;
+        explicit Iterator(std::byte const* record) : record_{record} {}
+
+        auto operator*() const -> T
+        {
+            return memberwise::deserialize<T>(
+                std::span{record_, record_size});
+        }
+
+        auto operator++() -> Iterator&
+        {
+            record_ += record_size;
+            return *this;
+        }
+
+        auto operator++(int) -> Iterator
+        {
+            auto copy = *this;
+            record_ += record_size;
+            return copy;
+        }
+
+        auto operator==(Iterator const& other) const -> bool
+        {
+            return record_ == other.record_;
+        }
+
+       private:
+        std::byte const* record_ = nullptr;
+    };
+
+    using iterator = Iterator;
+
+   public:
+    /** Maps the file at \p path. Throws std::system_error if it can't be
+        opened or mapped, and std::runtime_error if its size is not a whole
+        number of records. */
+    explicit record_file(std::filesystem::path const& path)
+        : file_{path, "hal::record_file"}
+    {
+        if (record_size == 0 || file_.bytes().size() % record_size != 0) {
+            throw std::runtime_error{
+                "hal::record_file: file size is not a whole number of "
+                "records"};
+        }
+    }
+
+   public:
+    /// Number of records in the file.
+    auto size() const -> size_type { return bytes().size() / record_size; }
+    auto empty() const -> bool { return bytes().empty(); }
+
+    auto operator[](size_type index) const -> T
+    {
+        return memberwise::deserialize<T>(
+            bytes().subspan(index * record_size, record_size));
+    }
+
+    auto begin() const -> iterator { return iterator{bytes().data()}; }
+    auto end() const -> iterator
+    {
+        return iterator{bytes().data() + bytes().size()};
+    }
+
+    /// The serialized bytes of every record.
+    auto bytes() const -> std::span<std::byte const> { return file_.bytes(); }
+
+    /** The records, read in place from the mapped file. Only available when
+        T is laid out in memory the same way it is serialized. */
+    auto records() const -> std::span<T const>
+        requires(memberwise::is_serialized_layout_v<T>)
+    {
+        return {reinterpret_cast<T const*>(bytes().data()), size()};
+    }
+
+    /** Copies records [first, first + out.size()) into \p out. This is one
+        memcpy when T is laid out the same way it is serialized. */
+    void read(size_type first, std::span<T> out) const
+    {
+        auto const from = bytes().subspan(first * record_size,
+                                          out.size() * record_size);
+        if constexpr (memberwise::is_serialized_layout_v<T>) {
+            if (!from.empty())
+                std::memcpy(out.data(), from.data(), from.size());
+        }
+        else {
+            for (auto i = size_type{0}; i < out.size(); ++i) {
+                out[i] = memberwise::deserialize<T>(
+                    from.subspan(i * record_size, record_size));
+            }
+        }
+    }
+
+   private:
+    detail::Mapped_file file_;
+};
+
+}  // namespace hal
+#endif  // HAL_RECORD_FILE_HPP
@@ -0,0 +1,568 @@
+#ifndef HAL_SOA_VECTOR_HPP
+#define HAL_SOA_VECTOR_HPP
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <hal.hpp>
+
+namespace hal {
+
+namespace detail {
+
+/// Allocates arrays aligned to a cache line, or more if \p T needs it.
+template <typename T>
+struct Aligned_allocator {
+    using value_type = T;
+
+    static constexpr auto alignment =
+        alignof(T) > 64 ? alignof(T) : std::size_t{64};
+
+    Aligned_allocator() = default;
+
+    template <typename U>
+    Aligned_allocator(Aligned_allocator<U> const&)
+    {}
+
+    auto allocate(std::size_t n) -> T*
+    {
+        return static_cast<T*>(
+            ::operator new(n * sizeof(T), std::align_val_t{alignment}));
+    }
+
+    void deallocate(T* p, std::size_t)
+    {
+        ::operator delete(p, std::align_val_t{alignment});
+    }
+
+    template <typename U>
+    auto operator==(Aligned_allocator<U> const&) const -> bool
+    {
+        return true;
+    }
+};
+
+/** The column of a bool member. std::vector<bool> packs its values into bits,
+    so it has no bool& to a row or span<bool> of a column; this stores one
+    bool per byte instead. Has the part of std::vector that soa_vector uses,
+    and a failed allocation leaves it unchanged. */
+class Bool_vector {
+   public:
+    using value_type = bool;
+
+   public:
+    Bool_vector() = default;
+
+    Bool_vector(Bool_vector const& other)
+    {
+        reserve(other.size_);
+        std::copy(other.begin(), other.end(), data_);
+        size_ = other.size_;
+    }
+
+    Bool_vector(Bool_vector&& other) noexcept { swap(other); }
+
+    auto operator=(Bool_vector other) noexcept -> Bool_vector&
+    {
+        swap(other);
+        return *this;
+    }
+
+    ~Bool_vector()
+    {
+        if (data_ != nullptr)
+            Aligned_allocator<bool>{}.deallocate(data_, capacity_);
+    }
+
+   public:
+    auto data() -> bool* { return data_; }
+    auto data() const -> bool const* { return data_; }
+    auto begin() -> bool* { return data_; }
+    auto begin() const -> bool const* { return data_; }
+    auto end() -> bool* { return data_ + size_; }
+    auto end() const -> bool const* { return data_ + size_; }
+    auto size() const -> std::size_t { return size_; }
+    auto capacity() const -> std::size_t { return capacity_; }
+
+    auto operator[](std::size_t index) -> bool& { return data_[index]; }
+    auto operator[](std::size_t index) const -> bool const&
+    {
+        return data_[index];
+    }
+
+    void reserve(std::size_t count)
+    {
+        if (count <= capacity_)
+            return;
+        auto* const data = Aligned_allocator<bool>{}.allocate(count);
+        std::copy(begin(), end(), data);
+        if (data_ != nullptr)
+            Aligned_allocator<bool>{}.deallocate(data_, capacity_);
+        data_     = data;
+        capacity_ = count;
+    }
+
+    void resize(std::size_t count, bool value = false)
+    {
+        if (count > capacity_)
+            reserve(count < 2 * capacity_ ? 2 * capacity_ : count);
+        if (count > size_)
+            std::fill(data_ + size_, data_ + count, value);
+        size_ = count;
+    }
+
+    void push_back(bool value)
+    {
+        if (size_ == capacity_)
+            reserve(capacity_ == 0 ? 8 : 2 * capacity_);
+        data_[size_++] = value;
+    }
+
+    void pop_back() { --size_; }
+    void clear() { size_ = 0; }
+
+    void swap(Bool_vector& other) noexcept
+    {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+    }
+
+   private:
+    bool* data_           = nullptr;
+    std::size_t size_     = 0;
+    std::size_t capacity_ = 0;
+};
+
+/// The array of one member type, aligned to a cache line.
+template <typename Member>
+using Column_t =
+    std::conditional_t<std::is_same_v<Member, bool>,
+                       Bool_vector,
+                       std::vector<Member, Aligned_allocator<Member>>>;
+
+template <typename Members>
+struct Columns;
+
+/// One vector per member type.
+template <typename... Members>
+struct Columns<std::tuple<Members...>> {
+    using type = std::tuple<Column_t<Members>...>;
+};
+
+template <typename T>
+using Columns_t = typename Columns<Members_t<T>>::type;
+
+}  // namespace detail
+
+/* ----------------------------- soa_reference ------------------------------ */
+/** Refers to one row of a soa_vector, a reference to each member of \p T.
+    Supports structured bindings, so works with hal::to_ref_tuple and the
+    memberwise algorithms. Is soa_reference<T const> for a const soa_vector. */
+template <typename T>
+class soa_reference {
+   public:
+    using value_type = std::remove_const_t<T>;
+
+    template <typename Member>
+    using Ref_t =
+        std::conditional_t<std::is_const_v<T>, Member const&, Member&>;
+
+    template <typename Members>
+    struct Refs;
+
+    template <typename... Members>
+    struct Refs<std::tuple<Members...>> {
+        using type = std::tuple<Ref_t<Members>...>;
+    };
+
+    using Refs_t = typename Refs<detail::Members_t<value_type>>::type;
+
+   public:
+    explicit soa_reference(Refs_t refs) : refs_{refs} {}
+
+    soa_reference(soa_reference const&) = default;
+
+    /// Assigns \p value to the row, member by member.
+    auto operator=(value_type const& value) const -> soa_reference const&
+        requires(!std::is_const_v<T>)
+    {
+        assign(hal::to_ref_tuple(value));
+        return *this;
+    }
+
+    /// Assigns the values of \p other to this row, not the reference.
+    auto operator=(soa_reference const& other) const -> soa_reference const&
+        requires(!std::is_const_v<T>)
+    {
+        assign(other.refs_);
+        return *this;
+    }
+
+    /// A copy of the row.
+    operator value_type() const { return hal::from_tuple<value_type>(refs_); }
+
+    template <std::size_t I>
+    auto get() const -> std::tuple_element_t<I, Refs_t>
+    {
+        return std::get<I>(refs_);
+    }
+
+   private:
+    template <typename Values>
+    void assign(Values const& values) const
+    {
+        [&]<std::size_t... I>(std::index_sequence<I...>)
+        {
+            ((std::get<I>(refs_) = std::get<I>(values)), ...);
+        }
+        (std::make_index_sequence<std::tuple_size_v<Refs_t>>{});
+    }
+
+   private:
+    Refs_t refs_;
+};
+
+template <typename T>
+struct member_count<soa_reference<T>>
+    : member_count<std::remove_const_t<T>> {};
+
+/* ------------------------------- soa_vector ------------------------------- */
+/** Stores aggregates of type \p T as one contiguous array per member, each
+    aligned to a cache line. Rows are accessed through soa_reference, and each
+    member through column<I>(). */
+template <typename T>
+class soa_vector {
+   public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using reference       = soa_reference<T>;
+    using const_reference = soa_reference<T const>;
+
+    static constexpr auto column_count = hal::member_count_v<T>;
+
+    /// Iterates over the rows, dereferences to a soa_reference.
+    template <typename Vector, typename Reference>
+    class Iterator {
+       public:
+        using difference_type = std::ptrdiff_t;
+        using value_type      = T;
+
+        Iterator() = default;
+        Iterator(Vector* vector, size_type index)
+            : vector_{vector}, index_{index}
+        {}
+
+        auto operator*() const -> Reference { return (*vector_)[index_]; }
+
+        auto operator++() -> Iterator&
+        {
+            ++index_;
+            return *this;
+        }
+
+        auto operator++(int) -> Iterator
+        {
+            auto copy = *this;
+            ++index_;
+            return copy;
+        }
+
+        auto operator==(Iterator const& other) const -> bool
+        {
+            return index_ == other.index_;
+        }
+
+       private:
+        Vector* vector_  = nullptr;
+        size_type index_ = 0;
+    };
+
+    using iterator       = Iterator<soa_vector, reference>;
+    using const_iterator = Iterator<soa_vector const, const_reference>;
+
+   public:
+    soa_vector() = default;
+
+    /// Creates \p count rows, each a copy of T{}.
+    explicit soa_vector(size_type count) { resize(count); }
+
+   public:
+    auto size() const -> size_type { return size_; }
+    auto empty() const -> bool { return size_ == 0; }
+
+    void reserve(size_type count)
+    {
+        for_each_column([&](auto& column) { column.reserve(count); });
+    }
+
+    void clear()
+    {
+        for_each_column([](auto& column) { column.clear(); });
+        size_ = 0;
+    }
+
+    /** Adds or removes rows, new rows are copies of \p value. If a column
+        throws, the columns already resized are shrunk back, so the
+        soa_vector is unchanged. */
+    void resize(size_type count, T const& value = T{})
+    {
+        auto const members = hal::to_ref_tuple(value);
+        auto resized       = std::size_t{0};
+        try {
+            with_indices([&]<std::size_t... I>(std::index_sequence<I...>) {
+                ((std::get<I>(columns_).resize(count, std::get<I>(members)),
+                  ++resized),
+                 ...);
+            });
+        }
+        catch (...) {
+            with_indices([&]<std::size_t... I>(std::index_sequence<I...>) {
+                ((I < resized ? std::get<I>(columns_).resize(
+                                    size_, std::get<I>(members))
+                              : void()),
+                 ...);
+            });
+            throw;
+        }
+        size_ = count;
+    }
+
+    /** Room for the new row is reserved in every column first, so only
+        copying a member can throw. If it does, the columns already pushed to
+        are popped, so the soa_vector is unchanged. */
+    void push_back(T const& value)
+    {
+        push_members(hal::to_ref_tuple(value),
+                     [](auto const& member) -> auto const& { return member; });
+    }
+
+    /// Like push_back(T const&), but members that were moved stay moved from.
+    void push_back(T&& value)
+    {
+        push_members(hal::to_ref_tuple(value), [](auto& member) -> auto&& {
+            return std::move(member);
+        });
+    }
+
+    void pop_back()
+    {
+        for_each_column([](auto& column) { column.pop_back(); });
+        --size_;
+    }
+
+    auto operator[](size_type index) -> reference
+    {
+        return with_indices([&]<std::size_t... I>(std::index_sequence<I...>) {
+            return reference{
+                typename reference::Refs_t{std::get<I>(columns_)[index]...}};
+        });
+    }
+
+    auto operator[](size_type index) const -> const_reference
+    {
+        return with_indices([&]<std::size_t... I>(std::index_sequence<I...>) {
+            return const_reference{typename const_reference::Refs_t{
+                std::get<I>(columns_)[index]...}};
+        });
+    }
+
+    auto begin() -> iterator { return iterator{this, 0}; }
+    auto end() -> iterator { return iterator{this, size_}; }
+    auto begin() const -> const_iterator { return const_iterator{this, 0}; }
+    auto end() const -> const_iterator { return const_iterator{this, size_}; }
+
+    /// The contiguous values of member \p I, one per row.
+    template <std::size_t I>
+    auto column() -> std::span<std::tuple_element_t<I, detail::Members_t<T>>>
+    {
+        return std::get<I>(columns_);
+    }
+
+    template <std::size_t I>
+    auto column() const
+        -> std::span<std::tuple_element_t<I, detail::Members_t<T>> const>
+    {
+        return std::get<I>(columns_);
+    }
+
+   private:
+    template <typename Fn>
+    static auto with_indices(Fn&& fn) -> decltype(auto)
+    {
+        return fn(std::make_index_sequence<column_count>{});
+    }
+
+    template <typename Fn>
+    void for_each_column(Fn&& fn)
+    {
+        std::apply([&](auto&... column) { (fn(column), ...); }, columns_);
+    }
+
+    /// Doubles the capacity of the columns when one can't fit the next row.
+    void grow()
+    {
+        if constexpr (column_count != 0) {
+            auto capacity = std::get<0>(columns_).capacity();
+            for_each_column([&](auto& column) {
+                capacity = std::min(capacity, column.capacity());
+            });
+            if (size_ == capacity)
+                reserve(size_ == 0 ? 8 : 2 * size_);
+        }
+    }
+
+    /// Pushes pass(member) onto each column, popping them all if one throws.
+    template <typename Members, typename Pass>
+    void push_members(Members const& members, Pass pass)
+    {
+        grow();
+        auto pushed = std::size_t{0};
+        try {
+            with_indices([&]<std::size_t... I>(std::index_sequence<I...>) {
+                ((std::get<I>(columns_).push_back(pass(std::get<I>(members))),
+                  ++pushed),
+                 ...);
+            });
+        }
+        catch (...) {
+            with_indices([&]<std::size_t... I>(std::index_sequence<I...>) {
+                ((I < pushed ? std::get<I>(columns_).pop_back() : void()),
+                 ...);
+            });
+            throw;
+        }
+        ++size_;
+    }
+
+   private:
+    detail::Columns_t<T> columns_;
+    size_type size_ = 0;
+};
+
+/* ------------------------------- columnwise ------------------------------- */
+// Algorithms over a soa_vector, with one result or one pass per column. Every
+// column is a contiguous array, so the loops are easy to vectorize.
+namespace columnwise {
+
+/* ------------------------- columnwise::for_each --------------------------- */
+/// Calls func on every value of each column, a column at a time.
+template <typename UnaryOp, typename T>
+void for_each_impl(UnaryOp&& func, soa_vector<T>& records)
+{
+    [&]<std::size_t... I>(std::index_sequence<I...>)
+    {
+        auto column = [&](auto index) {
+            for (auto& x : records.template column<index>())
+                func(x);
+        };
+        (column(std::integral_constant<std::size_t, I>{}), ...);
+    }
+    (std::make_index_sequence<soa_vector<T>::column_count>{});
+}
+
+template <typename UnaryOp, typename T>
+void for_each_impl(UnaryOp&& func, soa_vector<T> const& records)
+{
+    [&]<std::size_t... I>(std::index_sequence<I...>)
+    {
+        auto column = [&](auto index) {
+            for (auto const& x : records.template column<index>())
+                func(x);
+        };
+        (column(std::integral_constant<std::size_t, I>{}), ...);
+    }
+    (std::make_index_sequence<soa_vector<T>::column_count>{});
+}
+
+inline auto constexpr for_each =
+    hal::detail::make_curried<2>([](auto&& a, auto&& b) {
+        return hal::columnwise::for_each_impl(std::forward<decltype(a)>(a), b);
+    });
+
+/* ------------------------- columnwise::transform -------------------------- */
+/// Replaces every value x of each column with transform_fn(x).
+template <typename UnaryOp, typename T>
+void transform_impl(UnaryOp&& transform_fn, soa_vector<T>& records)
+{
+    columnwise::for_each_impl([&](auto& x) { x = transform_fn(x); }, records);
+}
+
+inline auto constexpr transform =
+    hal::detail::make_curried<2>([](auto&& a, auto&& b) {
+        return hal::columnwise::transform_impl(std::forward<decltype(a)>(a), b);
+    });
+
+/* --------------------- columnwise::transform_reduce ----------------------- */
+/** Returns an aggregate where member i is the reduction of column i, in row
+    order, starting from member i of \p init. The columns are read side by
+    side in one pass, each with its own accumulator, so the reductions of
+    different columns overlap instead of waiting on each other. */
+template <typename Result, typename UnaryOp, typename BinaryOp, typename T>
+    requires(hal::member_count_v<Result> == hal::member_count_v<T>)
+auto transform_reduce_impl(Result init,
+                           UnaryOp&& transform_fn,
+                           BinaryOp&& reduce_fn,
+                           soa_vector<T> const& records) -> Result
+{
+    return [&]<std::size_t... I>(std::index_sequence<I...>)
+    {
+        auto const init_members = hal::to_ref_tuple(init);
+        auto accumulators       = hal::detail::Members_t<Result>{
+            std::move(std::get<I>(init_members))...};
+        auto const columns = std::tuple{records.template column<I>()...};
+        for (auto row = std::size_t{0}; row < records.size(); ++row) {
+            ((std::get<I>(accumulators) =
+                  reduce_fn(std::move(std::get<I>(accumulators)),
+                            transform_fn(std::get<I>(columns)[row]))),
+             ...);
+        }
+        return Result{std::move(std::get<I>(accumulators))...};
+    }
+    (std::make_index_sequence<hal::member_count_v<T>>{});
+}
+
+inline auto constexpr transform_reduce = hal::detail::make_curried<4>(
+    [](auto&& a, auto&& b, auto&& c, auto&& d) {
+        return hal::columnwise::transform_reduce_impl(
+            std::forward<decltype(a)>(a), std::forward<decltype(b)>(b),
+            std::forward<decltype(c)>(c), std::as_const(d));
+    });
+
+/* -------------------------- columnwise::reduce ---------------------------- */
+template <typename Result, typename BinaryOp, typename T>
+    requires(hal::member_count_v<Result> == hal::member_count_v<T>)
+auto reduce_impl(Result init,
+                 BinaryOp&& reduce_fn,
+                 soa_vector<T> const& records) -> Result
+{
+    return columnwise::transform_reduce_impl(std::move(init), std::identity{},
+                                             reduce_fn, records);
+}
+
+inline auto constexpr reduce =
+    hal::detail::make_curried<3>([](auto&& a, auto&& b, auto&& c) {
+        return hal::columnwise::reduce_impl(std::forward<decltype(a)>(a),
+                                            std::forward<decltype(b)>(b),
+                                            std::as_const(c));
+    });
+
+}  // namespace columnwise
+}  // namespace hal
+
+template <typename T>
+struct std::tuple_size<hal::soa_reference<T>>
+    : std::integral_constant<std::size_t, hal::member_count_v<T>> {};
+
+template <std::size_t I, typename T>
+struct std::tuple_element<I, hal::soa_reference<T>> {
+    using type =
+        std::tuple_element_t<I, typename hal::soa_reference<T>::Refs_t>;
+};
+
+#endif  // HAL_SOA_VECTOR_HPP
@@ -31,3 +31,29 @@ TEST_CASE("adjacent_find", "[HAL]")
         static_assert(hal::adjacent_find(1, 2, 3, 3, 4, 5, 5, 2, 3, 3) == 2);
     }
 }
+
+TEST_CASE("adjacent_find short circuit", "[HAL]")
+{
+    auto compares = 0;
+    struct Counted {
+        int value;
+        int* compares;
+        auto operator==(Counted const& other) const -> bool
+        {
+            ++*compares;
+            return value == other.value;
+        }
+    };
+    auto const c = [&compares](int x) { return Counted{x, &compares}; };
+
+    SECTION("stops at first pair")
+    {
+        CHECK(hal::adjacent_find(c(1), c(2), c(2), c(3), c(3)) == 1);
+        CHECK(compares == 2);
+    }
+    SECTION("no pair compares every neighbour")
+    {
+        CHECK(hal::adjacent_find(c(1), c(2), c(3), c(4)) == 3);
+        CHECK(compares == 3);
+    }
+}
@@ -45,6 +45,11 @@ TEST_CASE("all_of", "[HAL]")
         CHECK(!hal::reverse::all_of([](auto x) { return x; }, false, false));
         CHECK(hal::reverse::all_of([](auto x) { return x; }, true));
         CHECK(!hal::reverse::all_of([](auto x) { return x; }, false));
+
+        // Elements are passed to the predicate as non-const lvalues.
+        auto a = 1;
+        auto b = 2;
+        CHECK(hal::reverse::all_of([](int& x) { return x > 0; }, a, b));
     }
 
     SECTION("reverse and partial application")
@@ -0,0 +1,184 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+
+namespace {
+constexpr auto sum     = [](auto x, auto y) { return x + y; };
+constexpr auto maximum = [](auto x, auto y) { return std::max(x, y); };
+constexpr auto square  = [](auto x) { return x * x; };
+
+struct Tick {
+    int volume;
+    float price;
+    long time;
+};
+
+struct Totals {
+    long volume;
+    double price;
+    long time;
+};
+
+struct Empty {};
+
+/// Ticks with volume i % 10, price i / 4 and time i, for i in [0, n).
+auto ticks(std::size_t n) -> std::vector<Tick>
+{
+    auto result = std::vector<Tick>(n);
+    for (auto i = std::size_t{0}; i < n; ++i) {
+        result[i] = Tick{static_cast<int>(i % 10), static_cast<float>(i) / 4,
+                         static_cast<long>(i)};
+    }
+    return result;
+}
+}  // namespace
+
+TEST_CASE("hal::memberwise::batch::reduce", "[HAL]")
+{
+    SECTION("full call")
+    {
+        // More records than fit in one chunk, and a partial last chunk.
+        auto const records = ticks(3000);
+        auto const totals =
+            hal::memberwise::batch::reduce(Totals{1, 0., 0}, sum, records);
+        auto expected = Totals{1, 0., 0};
+        for (auto const& tick : records) {
+            expected.volume += tick.volume;
+            expected.price += tick.price;
+            expected.time += tick.time;
+        }
+        CHECK(totals.volume == expected.volume);
+        CHECK(totals.price == Approx(expected.price));
+        CHECK(totals.time == expected.time);
+
+        auto const peaks =
+            hal::memberwise::batch::reduce(Tick{}, maximum, records);
+        CHECK(peaks.volume == 9);
+        CHECK(peaks.price == 2999.f / 4);
+        CHECK(peaks.time == 2999);
+    }
+
+    SECTION("empty and single records")
+    {
+        auto const none = std::vector<Tick>{};
+        auto const a =
+            hal::memberwise::batch::reduce(Totals{1, 2., 3}, sum, none);
+        CHECK(a.volume == 1);
+        CHECK(a.price == 2.);
+        CHECK(a.time == 3);
+
+        auto const one = std::array{Tick{4, 5.f, 6}};
+        auto const b =
+            hal::memberwise::batch::reduce(Totals{1, 2., 3}, sum, one);
+        CHECK(b.volume == 5);
+        CHECK(b.price == 7.);
+        CHECK(b.time == 9);
+
+        auto const empties = std::vector<Empty>(3);
+        CHECK_NOTHROW(hal::memberwise::batch::reduce(Empty{}, sum, empties));
+    }
+
+    SECTION("record order is kept across chunks")
+    {
+        auto const cat = [](std::string const& x, std::string const& y) {
+            return x + y;
+        };
+        struct Name {
+            std::string name;
+        };
+        auto names = std::vector<Name>(hal::memberwise::batch::chunk_size + 2,
+                                       Name{"a"});
+        names.back().name = "z";
+        auto const joined =
+            hal::memberwise::batch::reduce(Name{">"}, cat, std::span{names});
+        CHECK(joined.name.size() == names.size() + 1);
+        CHECK(joined.name.front() == '>');
+        CHECK(joined.name.back() == 'z');
+    }
+
+    SECTION("partial application")
+    {
+        auto const records = ticks(10);
+        auto sum_ticks     = hal::memberwise::batch::reduce(Totals{}, sum);
+        CHECK(sum_ticks(records).time == 45);
+        CHECK(sum_ticks(std::span{records}.first(3)).volume == 3);
+    }
+
+    SECTION("constexpr")
+    {
+        constexpr auto records = std::array{Tick{1, 2.f, 3}, Tick{4, 5.f, 6}};
+        constexpr auto totals =
+            hal::memberwise::batch::reduce(Totals{}, sum, records);
+        static_assert(totals.volume == 5);
+        static_assert(totals.price == 7.);
+        static_assert(totals.time == 9);
+    }
+}
+
+TEST_CASE("hal::memberwise::batch::transform_reduce", "[HAL]")
+{
+    SECTION("full call")
+    {
+        auto const records = ticks(2500);
+        auto const squares = hal::memberwise::batch::transform_reduce(
+            Totals{}, square, sum, records);
+        auto expected = Totals{};
+        for (auto const& tick : records) {
+            expected.volume += tick.volume * tick.volume;
+            expected.price += tick.price * tick.price;
+            expected.time += tick.time * tick.time;
+        }
+        CHECK(squares.volume == expected.volume);
+        CHECK(squares.price == Approx(expected.price));
+        CHECK(squares.time == expected.time);
+    }
+
+    SECTION("constexpr")
+    {
+        constexpr auto records = std::array{Tick{1, 2.f, 3}, Tick{4, 5.f, 6}};
+        constexpr auto squares = hal::memberwise::batch::transform_reduce(
+            Totals{}, square, sum, records);
+        static_assert(squares.volume == 17);
+        static_assert(squares.price == 29.);
+        static_assert(squares.time == 45);
+    }
+}
+
+TEST_CASE("hal::memberwise::batch::for_each", "[HAL]")
+{
+    SECTION("one member at a time")
+    {
+        auto records = std::array{Tick{1, 2.f, 3}, Tick{4, 5.f, 6}};
+        auto visited = std::vector<double>{};
+        hal::memberwise::batch::for_each(
+            [&](auto x) { visited.push_back(static_cast<double>(x)); },
+            records);
+        CHECK(visited == std::vector<double>{1, 4, 2, 5, 3, 6});
+    }
+
+    SECTION("modifies records")
+    {
+        auto records = ticks(2049);
+        hal::memberwise::batch::for_each([](auto& x) { x *= 2; }, records);
+        CHECK(records[2048].volume == 16);
+        CHECK(records[2048].price == 1024.f);
+        CHECK(records[2048].time == 4096);
+    }
+
+    SECTION("partial application")
+    {
+        auto count = std::size_t{0};
+        auto count_members =
+            hal::memberwise::batch::for_each([&](auto const&) { ++count; });
+        count_members(ticks(5));
+        CHECK(count == 15);
+    }
+}
@@ -0,0 +1,150 @@
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+
+namespace {
+enum class Kind : std::uint16_t { add = 0x0102, cancel = 0x0304 };
+
+/// A market data message as it arrives from the network.
+struct Order {
+    std::uint32_t sequence;
+    Kind kind;
+    std::uint8_t side;
+    std::int64_t price;
+    std::array<std::uint16_t, 2> sizes;
+    float ratio;
+};
+
+struct Header {
+    std::uint16_t length;
+    std::uint8_t version;
+    std::uint8_t flags;
+    std::uint32_t session;
+};
+
+/// Takes more than 16 registers to line up with whole records.
+struct Odd {
+    std::array<std::uint16_t, 17> values;
+    std::uint64_t b;
+};
+
+/// Fills the bytes of \p records with a pattern that differs per record.
+template <typename T>
+auto make_records(std::size_t count) -> std::vector<T>
+{
+    auto records = std::vector<T>(count);
+    auto* bytes  = reinterpret_cast<unsigned char*>(records.data());
+    for (auto i = std::size_t{0}; i < count * sizeof(T); ++i)
+        bytes[i] = static_cast<unsigned char>(i * 7 + 3);
+    return records;
+}
+
+template <typename T>
+auto bytes_of(T const& value)
+{
+    return std::bit_cast<std::array<std::byte, sizeof(T)>>(value);
+}
+
+/** Compares the bytes of each member of \p a and \p b, but not padding.
+    Swapped bytes can make floats NaN, which never compare equal. */
+template <typename T>
+auto same_members(T const& a, T const& b) -> bool
+{
+    return std::apply(
+        [&](auto const&... x) {
+            return std::apply(
+                [&](auto const&... y) {
+                    return ((bytes_of(x) == bytes_of(y)) && ...);
+                },
+                hal::to_ref_tuple(b));
+        },
+        hal::to_ref_tuple(a));
+}
+}  // namespace
+
+TEST_CASE("hal::memberwise::byteswap", "[HAL]")
+{
+    SECTION("each member")
+    {
+        auto const order = hal::memberwise::byteswap(
+            Order{0x01020304, Kind::add, 7, 0x0102030405060708,
+                  {0x0A0B, 0x0C0D}, std::bit_cast<float>(0x3F800000u)});
+        CHECK(order.sequence == 0x04030201);
+        CHECK(order.kind == Kind{0x0201});
+        CHECK(order.side == 7);
+        CHECK(order.price == 0x0807060504030201);
+        CHECK(order.sizes == std::array<std::uint16_t, 2>{0x0B0A, 0x0D0C});
+        CHECK(std::bit_cast<std::uint32_t>(order.ratio) == 0x0000803Fu);
+    }
+
+    SECTION("constexpr")
+    {
+        constexpr auto header =
+            hal::memberwise::byteswap(Header{0x1234, 1, 2, 0xAABBCCDD});
+        STATIC_REQUIRE(header.length == 0x3412);
+        STATIC_REQUIRE(header.version == 1);
+        STATIC_REQUIRE(header.flags == 2);
+        STATIC_REQUIRE(header.session == 0xDDCCBBAA);
+
+        constexpr auto sizes = [] {
+            auto headers = std::array{Header{1, 0, 0, 2}, Header{3, 0, 0, 4}};
+            hal::memberwise::byteswap(headers);
+            return headers;
+        }();
+        STATIC_REQUIRE(sizes[1].length == 0x0300);
+        STATIC_REQUIRE(sizes[1].session == 0x04000000);
+    }
+
+    SECTION("spans match the scalar swap")
+    {
+        for (auto count : {0, 1, 2, 3, 5, 8, 13, 33, 100}) {
+            auto headers        = make_records<Header>(count);
+            auto const original = headers;
+            hal::memberwise::byteswap(headers);
+            for (auto i = std::size_t{0}; i < headers.size(); ++i) {
+                CHECK(same_members(headers[i],
+                                   hal::memberwise::byteswap(original[i])));
+            }
+
+            auto orders            = make_records<Order>(count);
+            auto const order_bytes = orders;
+            hal::memberwise::byteswap(std::span{orders});
+            for (auto i = std::size_t{0}; i < orders.size(); ++i) {
+                CHECK(same_members(
+                    orders[i], hal::memberwise::byteswap(order_bytes[i])));
+            }
+
+            auto odds            = make_records<Odd>(count);
+            auto const odd_bytes = odds;
+            hal::memberwise::byteswap(odds);
+            for (auto i = std::size_t{0}; i < odds.size(); ++i) {
+                CHECK(same_members(odds[i],
+                                   hal::memberwise::byteswap(odd_bytes[i])));
+            }
+        }
+    }
+}
+
+TEST_CASE("hal::memberwise::to_native_endian", "[HAL]")
+{
+    constexpr auto little = std::endian::native == std::endian::little;
+    constexpr auto header =
+        hal::memberwise::to_native_endian(Header{0x1234, 1, 2, 0xAABBCCDD});
+    STATIC_REQUIRE(header.length == (little ? 0x3412 : 0x1234));
+    STATIC_REQUIRE(hal::memberwise::to_network_endian(header).session ==
+                   0xAABBCCDD);
+
+    auto headers = std::vector<Header>(20, Header{0x1234, 1, 2, 0xAABBCCDD});
+    hal::memberwise::to_network_endian(headers);
+    CHECK(headers[19].length == (little ? 0x3412 : 0x1234));
+    hal::memberwise::to_native_endian(headers);
+    CHECK(headers[19].length == 0x1234);
+    CHECK(headers[19].session == 0xAABBCCDD);
+}
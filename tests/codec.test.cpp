@@ -0,0 +1,272 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <hal/codec.hpp>
+
+namespace {
+struct Sample {
+    std::int64_t time;
+    std::int32_t value;
+    std::uint16_t sensor;
+};
+
+/// Sorted timestamps with small, irregular gaps, past several SIMD blocks.
+auto timestamps(std::size_t count) -> std::vector<std::int64_t>
+{
+    auto times = std::vector<std::int64_t>(count);
+    auto time  = std::int64_t{1'700'000'000'000};
+    for (auto i = std::size_t{0}; i < count; ++i) {
+        time += static_cast<std::int64_t>(i % 7 * 3 + 1);
+        times[i] = time;
+    }
+    return times;
+}
+}  // namespace
+
+TEST_CASE("hal::codec::zigzag", "[HAL]")
+{
+    STATIC_REQUIRE(hal::codec::zigzag_encode(0) == 0u);
+    STATIC_REQUIRE(hal::codec::zigzag_encode(-1) == 1u);
+    STATIC_REQUIRE(hal::codec::zigzag_encode(1) == 2u);
+    STATIC_REQUIRE(hal::codec::zigzag_encode(std::int8_t{-128}) == 255u);
+    STATIC_REQUIRE(hal::codec::zigzag_encode(
+                       std::numeric_limits<std::int64_t>::max()) ==
+                   std::numeric_limits<std::uint64_t>::max() - 1);
+    for (auto value : {0, -1, 1, 1000, -1000,
+                       std::numeric_limits<int>::min(),
+                       std::numeric_limits<int>::max()}) {
+        CHECK(hal::codec::zigzag_decode(hal::codec::zigzag_encode(value)) ==
+              value);
+    }
+}
+
+TEST_CASE("hal::codec::delta", "[HAL]")
+{
+    SECTION("differences and prefix sum")
+    {
+        auto values = std::vector<int>{5, 7, 6, 6, 10};
+        hal::codec::delta_encode(values);
+        CHECK(values == std::vector<int>{5, 2, -1, 0, 4});
+        hal::codec::delta_decode(values);
+        CHECK(values == std::vector<int>{5, 7, 6, 6, 10});
+    }
+
+    SECTION("every size around the register width")
+    {
+        for (auto size = std::size_t{0}; size < 40; ++size) {
+            auto values = std::vector<std::uint32_t>(size);
+            std::iota(values.begin(), values.end(), 4'000'000'000u);
+            auto const original = values;
+            hal::codec::delta_encode(values);
+            hal::codec::delta_decode(values);
+            CHECK(values == original);
+
+            auto times               = timestamps(size);
+            auto const original_time = times;
+            hal::codec::delta_encode(times);
+            hal::codec::delta_decode(times);
+            CHECK(times == original_time);
+        }
+    }
+
+    SECTION("wraps around")
+    {
+        auto values = std::array<std::int32_t, 3>{
+            std::numeric_limits<std::int32_t>::min(), 0,
+            std::numeric_limits<std::int32_t>::max()};
+        auto const original = values;
+        hal::codec::delta_encode(values);
+        hal::codec::delta_decode(values);
+        CHECK(values == original);
+    }
+
+    SECTION("constexpr")
+    {
+        constexpr auto values = [] {
+            auto values = std::array{1, 3, 6, 10};
+            hal::codec::delta_encode(values);
+            return values;
+        }();
+        STATIC_REQUIRE(values == std::array{1, 2, 3, 4});
+        constexpr auto sums = [] {
+            auto values = std::array{1, 2, 3, 4};
+            hal::codec::delta_decode(values);
+            return values;
+        }();
+        STATIC_REQUIRE(sums == std::array{1, 3, 6, 10});
+    }
+}
+
+TEST_CASE("hal::codec::leb128", "[HAL]")
+{
+    STATIC_REQUIRE(hal::codec::leb128_max_size<std::uint8_t> == 2);
+    STATIC_REQUIRE(hal::codec::leb128_max_size<std::uint32_t> == 5);
+    STATIC_REQUIRE(hal::codec::leb128_max_size<std::uint64_t> == 10);
+
+    SECTION("bytes")
+    {
+        auto bytes = std::vector<std::byte>{};
+        hal::codec::leb128_encode(std::array{0u, 127u, 128u, 300u}, bytes);
+        CHECK(bytes == std::vector<std::byte>{
+                           std::byte{0}, std::byte{0x7F}, std::byte{0x80},
+                           std::byte{0x01}, std::byte{0xAC}, std::byte{0x02}});
+    }
+
+    SECTION("round trip")
+    {
+        auto const values = std::vector<std::uint64_t>{
+            0, 1, 127, 128, 16383, 16384, std::uint64_t{1} << 35,
+            std::numeric_limits<std::uint64_t>::max()};
+        auto bytes = std::vector<std::byte>{};
+        hal::codec::leb128_encode(values, bytes);
+        CHECK(bytes.size() == 1 + 1 + 1 + 2 + 2 + 3 + 6 + 10);
+        auto decoded = std::vector<std::uint64_t>(values.size());
+        CHECK(hal::codec::leb128_decode(bytes, decoded) == bytes.size());
+        CHECK(decoded == values);
+    }
+
+    SECTION("from a span")
+    {
+        auto values = std::vector<std::uint32_t>{300, 1};
+        auto bytes  = std::vector<std::byte>{};
+        hal::codec::leb128_encode(std::span<std::uint32_t>{values}, bytes);
+        CHECK(bytes.size() == 3);
+    }
+
+    SECTION("truncated")
+    {
+        auto bytes = std::vector<std::byte>{};
+        hal::codec::leb128_encode(std::array{1u, 300u}, bytes);
+        bytes.pop_back();
+        auto decoded = std::array<unsigned, 2>{};
+        CHECK_THROWS_AS(hal::codec::leb128_decode(bytes, decoded),
+                        std::runtime_error);
+    }
+}
+
+TEST_CASE("hal::codec::group_varint", "[HAL]")
+{
+    SECTION("bytes")
+    {
+        auto bytes = std::vector<std::byte>{};
+        hal::codec::group_varint_encode(
+            std::array<std::uint32_t, 5>{1, 256, 65536, 1u << 24, 7}, bytes);
+        REQUIRE(bytes.size() == 1 + 1 + 2 + 3 + 4 + 1 + 1);
+        CHECK(bytes[0] == std::byte{0b11'10'01'00});
+        CHECK(bytes[11] == std::byte{0});
+        CHECK(bytes[12] == std::byte{7});
+    }
+
+    SECTION("round trip")
+    {
+        for (auto size = std::size_t{0}; size < 40; ++size) {
+            auto values = std::vector<std::uint32_t>(size);
+            for (auto i = std::size_t{0}; i < size; ++i)
+                values[i] = static_cast<std::uint32_t>(i * i * i * 4099);
+            auto bytes = std::vector<std::byte>{};
+            hal::codec::group_varint_encode(values, bytes);
+            auto decoded = std::vector<std::uint32_t>(size);
+            CHECK(hal::codec::group_varint_decode(bytes, decoded) ==
+                  bytes.size());
+            CHECK(decoded == values);
+        }
+    }
+
+    SECTION("truncated")
+    {
+        auto bytes = std::vector<std::byte>{};
+        hal::codec::group_varint_encode(std::array{1u, 70000u}, bytes);
+        bytes.pop_back();
+        auto decoded = std::array<std::uint32_t, 2>{};
+        CHECK_THROWS_AS(hal::codec::group_varint_decode(bytes, decoded),
+                        std::runtime_error);
+    }
+}
+
+TEST_CASE("hal::codec::encode", "[HAL]")
+{
+    SECTION("timestamps")
+    {
+        auto const times = timestamps(5000);
+        auto bytes       = std::vector<std::byte>{};
+        hal::codec::encode(times, bytes);
+        // The first value takes 6 bytes, every gap after it 1.
+        CHECK(bytes.size() == 6 + times.size() - 1);
+        auto decoded = std::vector<std::int64_t>(times.size());
+        CHECK(hal::codec::decode(bytes, decoded) == bytes.size());
+        CHECK(decoded == times);
+    }
+
+    SECTION("extremes")
+    {
+        auto const values = std::vector<std::int16_t>{
+            0, std::numeric_limits<std::int16_t>::min(),
+            std::numeric_limits<std::int16_t>::max(), -1, 1};
+        auto bytes = std::vector<std::byte>{};
+        hal::codec::encode(values, bytes);
+        auto decoded = std::vector<std::int16_t>(values.size());
+        hal::codec::decode(bytes, decoded);
+        CHECK(decoded == values);
+    }
+
+    SECTION("from a span")
+    {
+        auto times = timestamps(100);
+        auto bytes = std::vector<std::byte>{};
+        hal::codec::encode(std::span<std::int64_t>{times}, bytes);
+        auto decoded = std::vector<std::int64_t>(times.size());
+        CHECK(hal::codec::decode(bytes, decoded) == bytes.size());
+        CHECK(decoded == times);
+    }
+
+    SECTION("appends")
+    {
+        auto bytes = std::vector<std::byte>{std::byte{42}};
+        hal::codec::encode(std::array{1u, 2u}, bytes);
+        CHECK(bytes.size() == 3);
+        CHECK(bytes[0] == std::byte{42});
+    }
+
+    SECTION("truncated")
+    {
+        auto bytes = std::vector<std::byte>{};
+        hal::codec::encode(std::array{1000}, bytes);
+        bytes.pop_back();
+        auto decoded = std::array<int, 1>{};
+        CHECK_THROWS_AS(hal::codec::decode(bytes, decoded),
+                        std::runtime_error);
+    }
+}
+
+TEST_CASE("hal::codec::memberwise::encode", "[HAL]")
+{
+    auto samples = std::vector<Sample>(3000);
+    for (auto i = std::size_t{0}; i < samples.size(); ++i) {
+        samples[i] = {static_cast<std::int64_t>(1'000'000 + i * 10),
+                      static_cast<std::int32_t>(i % 5) - 2,
+                      static_cast<std::uint16_t>(i % 3)};
+    }
+    auto bytes = std::vector<std::byte>{};
+    hal::codec::memberwise::encode(samples, bytes);
+    CHECK(bytes.size() < samples.size() * 3 + 16);
+
+    auto from_span = std::vector<std::byte>{};
+    hal::codec::memberwise::encode(std::span<Sample>{samples}, from_span);
+    CHECK(from_span == bytes);
+
+    auto decoded = std::vector<Sample>(samples.size());
+    CHECK(hal::codec::memberwise::decode(bytes, decoded) == bytes.size());
+    for (auto i = std::size_t{0}; i < samples.size(); ++i) {
+        CHECK(decoded[i].time == samples[i].time);
+        CHECK(decoded[i].value == samples[i].value);
+        CHECK(decoded[i].sensor == samples[i].sensor);
+    }
+}
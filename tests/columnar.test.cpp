@@ -0,0 +1,155 @@
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <ios>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <unistd.h>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+#include <hal/columnar.hpp>
+
+namespace {
+struct Trade {
+    std::int64_t time;
+    double price;
+    float size;
+    std::uint8_t side;
+    bool odd_lot;
+};
+
+struct Other {
+    double price;
+};
+
+auto trade(std::size_t i) -> Trade
+{
+    return Trade{static_cast<std::int64_t>(i), 100. + static_cast<double>(i),
+                 static_cast<float>(i % 7), static_cast<std::uint8_t>(i % 2),
+                 i % 3 == 0};
+}
+
+/// A path in the temporary directory, removed at the end of the scope.
+struct Temporary_file {
+    std::filesystem::path path =
+        std::filesystem::temp_directory_path() /
+        ("hal_columnar_test_" + std::to_string(::getpid()));
+    ~Temporary_file() { std::filesystem::remove(path); }
+};
+}  // namespace
+
+TEST_CASE("hal::columnar_writer and columnar_reader", "[HAL]")
+{
+    auto const file = Temporary_file{};
+
+    SECTION("project members of each row group")
+    {
+        {
+            // 10 rows per group, the last group is partial.
+            auto writer = hal::columnar_writer<Trade>{file.path, 10};
+            for (auto i = std::size_t{0}; i < 15; ++i)
+                writer.push_back(trade(i));
+            auto rest = std::vector<Trade>{};
+            for (auto i = std::size_t{15}; i < 37; ++i)
+                rest.push_back(trade(i));
+            writer.write(rest);
+            CHECK(writer.size() == 37);
+            writer.close();
+        }
+        auto const reader = hal::columnar_reader<Trade>{file.path};
+        REQUIRE(reader.size() == 37);
+        REQUIRE(reader.group_count() == 4);
+        CHECK(reader.group_size(3) == 7);
+
+        auto row   = std::size_t{0};
+        auto total = 0.;
+        for (auto [times, prices] : reader.columns<0, 1>()) {
+            REQUIRE(times.size() == prices.size());
+            for (auto i = std::size_t{0}; i < times.size(); ++i, ++row) {
+                CHECK(times[i] == static_cast<std::int64_t>(row));
+                total += prices[i];
+            }
+        }
+        CHECK(row == 37);
+        CHECK(total == 37 * 100. + 36. * 37. / 2.);
+
+        auto const sides = reader.columns<3>()[2];
+        CHECK(std::get<0>(sides)[1] == 1);
+        CHECK(reinterpret_cast<std::uintptr_t>(reader.column<2>(1).data()) %
+                  64 ==
+              0);
+
+        auto sizes = std::vector<float>(reader.size());
+        reader.read_column<2>(sizes);
+        CHECK(sizes[36] == 1.f);
+
+        auto odd_lots = std::vector<char>{};
+        for (auto [flags] : reader.columns<4>())
+            odd_lots.insert(odd_lots.end(), flags.begin(), flags.end());
+        REQUIRE(odd_lots.size() == 37);
+        for (auto i = std::size_t{0}; i < 37; ++i)
+            CHECK(odd_lots[i] == (i % 3 == 0));
+    }
+
+    SECTION("the destructor closes the file")
+    {
+        {
+            auto writer = hal::columnar_writer<Trade>{file.path};
+            writer.push_back(trade(5));
+        }
+        auto const reader = hal::columnar_reader<Trade>{file.path};
+        CHECK(reader.size() == 1);
+        CHECK(reader.column<1>(0)[0] == 105.);
+    }
+
+    SECTION("empty file")
+    {
+        hal::columnar_writer<Trade>{file.path}.close();
+        auto const reader = hal::columnar_reader<Trade>{file.path};
+        CHECK(reader.empty());
+        CHECK(reader.columns<0>().begin() == reader.columns<0>().end());
+    }
+
+    SECTION("errors")
+    {
+        CHECK_THROWS_AS(hal::columnar_reader<Trade>{file.path / "missing"},
+                        std::system_error);
+        hal::columnar_writer<Trade>{file.path}.close();
+        CHECK_THROWS_AS(hal::columnar_reader<Other>{file.path},
+                        std::runtime_error);
+        std::ofstream{file.path} << "not a columnar file, but long enough";
+        CHECK_THROWS_AS(hal::columnar_reader<Trade>{file.path},
+                        std::runtime_error);
+        CHECK_THROWS_AS(
+            hal::columnar_writer<Trade>{file.path / "missing" / "file"},
+            std::ios_base::failure);
+    }
+
+    SECTION("bool columns are checked")
+    {
+        hal::columnar_writer<Trade>{file.path}.write(
+            std::vector{trade(1), trade(3)});
+        auto const offset = [&] {
+            auto const reader = hal::columnar_reader<Trade>{file.path};
+            auto const& first = reader.column<0>(0).front();
+            auto const& flags = reader.column<4>(0).front();
+            return reinterpret_cast<char const*>(&flags) -
+                   reinterpret_cast<char const*>(&first);
+        }();
+        {
+            auto out = std::fstream{file.path, std::ios::binary |
+                                                   std::ios::in |
+                                                   std::ios::out};
+            out.seekp(offset);
+            out.put(char{2});
+        }
+        CHECK_THROWS_AS(hal::columnar_reader<Trade>{file.path},
+                        std::runtime_error);
+    }
+}
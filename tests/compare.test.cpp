@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+
+namespace {
+enum class Side : std::uint8_t { bid, ask };
+
+struct Order {
+    std::uint32_t account;
+    std::uint16_t venue;
+    Side side;
+    std::uint8_t flags;
+    std::uint64_t id;
+};
+
+struct Quote {
+    std::array<unsigned char, 4> symbol;
+    double price;
+    std::int32_t size;
+};
+
+struct Named {
+    std::string name;
+    int rank;
+};
+}  // namespace
+
+TEST_CASE("hal::equal, hal::compare and hal::less", "[HAL]")
+{
+    STATIC_REQUIRE(hal::equal(std::tuple{1, 2.5}, std::tuple{1L, 2.5f}));
+    STATIC_REQUIRE_FALSE(hal::equal(std::pair{1, 2}, std::pair{1, 3}));
+    STATIC_REQUIRE(hal::equal(std::tuple{}, std::tuple{}));
+    STATIC_REQUIRE(hal::less(std::tuple{1, 9}, std::tuple{2, 0}));
+    STATIC_REQUIRE_FALSE(hal::less(std::array{1, 2}, std::array{1, 2}));
+
+    STATIC_REQUIRE(std::is_same_v<decltype(hal::compare(std::tuple{1, 2},
+                                                        std::tuple{1, 2})),
+                                  std::strong_ordering>);
+    STATIC_REQUIRE(std::is_same_v<decltype(hal::compare(std::tuple{1, 2.},
+                                                        std::tuple{1, 2.})),
+                                  std::partial_ordering>);
+    STATIC_REQUIRE(hal::compare(std::tuple{1, 2}, std::tuple{1, 3}) < 0);
+    STATIC_REQUIRE(hal::compare(std::tuple{2, 0}, std::tuple{1, 3}) > 0);
+
+    auto const nan = std::numeric_limits<double>::quiet_NaN();
+    CHECK((hal::compare(std::tuple{nan}, std::tuple{1.}) ==
+           std::partial_ordering::unordered));
+    CHECK_FALSE(hal::equal(std::tuple{nan}, std::tuple{nan}));
+}
+
+TEST_CASE("hal::memberwise::equal", "[HAL]")
+{
+    STATIC_REQUIRE(hal::detail::is_bitwise_comparable<Order>);
+    STATIC_REQUIRE_FALSE(hal::detail::is_bitwise_comparable<Quote>);
+    STATIC_REQUIRE_FALSE(hal::detail::is_bitwise_comparable<Named>);
+
+    SECTION("memcmp")
+    {
+        constexpr auto order = Order{1, 2, Side::ask, 0, 5};
+        STATIC_REQUIRE(hal::memberwise::equal(order, order));
+        auto other = order;
+        CHECK(hal::memberwise::equal(order, other));
+        other.flags = 1;
+        CHECK_FALSE(hal::memberwise::equal(order, other));
+        other = order;
+        other.id = 6;
+        CHECK_FALSE(hal::memberwise::equal(order, other));
+    }
+
+    SECTION("member by member")
+    {
+        // Padding with different bytes, and 0.0 against -0.0.
+        auto a = Quote{};
+        auto b = Quote{};
+        std::memset(&a, 0x00, sizeof(a));
+        std::memset(&b, 0xFF, sizeof(b));
+        a = Quote{{'A', 'B'}, 0., 7};
+        b.symbol = {'A', 'B'};
+        b.price  = -0.;
+        b.size   = 7;
+        CHECK(hal::memberwise::equal(a, b));
+        b.size = 8;
+        CHECK_FALSE(hal::memberwise::equal(a, b));
+
+        CHECK(hal::memberwise::equal(Named{"x", 1}, Named{"x", 1}));
+        CHECK_FALSE(hal::memberwise::equal(Named{"x", 1}, Named{"y", 1}));
+    }
+}
+
+TEST_CASE("hal::memberwise::compare and less", "[HAL]")
+{
+    SECTION("declaration order")
+    {
+        constexpr auto a = Order{1, 9, Side::ask, 0, 0};
+        constexpr auto b = Order{2, 0, Side::bid, 0, 0};
+        STATIC_REQUIRE(hal::memberwise::less(a, b));
+        STATIC_REQUIRE_FALSE(hal::memberwise::less(b, a));
+        STATIC_REQUIRE_FALSE(hal::memberwise::less(a, a));
+        STATIC_REQUIRE(hal::memberwise::compare(a, a) == 0);
+        CHECK((hal::memberwise::compare(Named{"b", 0}, Named{"a", 9}) > 0));
+    }
+
+    SECTION("byte arrays order as unsigned")
+    {
+        auto const low  = Quote{{'A', 0x7F}, 1., 1};
+        auto const high = Quote{{'A', 0x80}, 0., 0};
+        CHECK(hal::memberwise::less(low, high));
+        CHECK((hal::memberwise::compare(high, low) > 0));
+        CHECK((hal::memberwise::compare(low, low) == 0));
+    }
+
+    SECTION("sorts like the members as a tuple")
+    {
+        auto quotes = std::vector<Quote>{};
+        for (auto i = 0; i < 1000; ++i) {
+            quotes.push_back(Quote{
+                {static_cast<unsigned char>(i * 37 % 5 + 250),
+                 static_cast<unsigned char>(i % 3)},
+                (i * 13 % 7) * 0.5,
+                i * 29 % 11});
+        }
+        auto expected = quotes;
+        std::sort(quotes.begin(), quotes.end(), [](auto& a, auto& b) {
+            return hal::memberwise::less(a, b);
+        });
+        std::sort(expected.begin(), expected.end(), [](auto& a, auto& b) {
+            return std::tie(a.symbol, a.price, a.size) <
+                   std::tie(b.symbol, b.price, b.size);
+        });
+        auto same = true;
+        for (auto i = std::size_t{0}; i < quotes.size(); ++i)
+            same = same && hal::memberwise::equal(quotes[i], expected[i]);
+        CHECK(same);
+    }
+}
@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <hal/concurrent.hpp>
+
+namespace {
+enum class Phase : std::uint8_t { pre_open, open, closed };
+
+struct Quote {
+    std::uint64_t sequence;
+    double bid;
+    double ask;
+    std::int32_t bid_size;
+    std::int32_t ask_size;
+    Phase phase;
+};
+
+/// Every member is derived from the sequence, so a torn read shows.
+auto quote(std::uint64_t sequence) -> Quote
+{
+    auto const i = static_cast<std::int32_t>(sequence % 1000);
+    return Quote{sequence, 100. + i, 100.5 + i, i, -i,
+                 static_cast<Phase>(sequence % 3)};
+}
+
+auto consistent(Quote const& q) -> bool
+{
+    auto const expected = quote(q.sequence);
+    return q.bid == expected.bid && q.ask == expected.ask &&
+           q.bid_size == expected.bid_size &&
+           q.ask_size == expected.ask_size && q.phase == expected.phase;
+}
+}  // namespace
+
+TEST_CASE("hal::memberwise::seqlocked", "[HAL]")
+{
+    STATIC_REQUIRE(alignof(hal::memberwise::seqlocked<Quote>) >= 64);
+
+    SECTION("single thread")
+    {
+        auto locked = hal::memberwise::seqlocked<Quote>{quote(5)};
+        CHECK(locked.load().sequence == 5);
+        CHECK(locked.version() == 0);
+        locked.store(quote(6));
+        CHECK(locked.load().ask_size == -6);
+        locked.update([](Quote& q) { q.phase = Phase::closed; });
+        CHECK(locked.load().phase == Phase::closed);
+        CHECK(locked.load().bid == 106.);
+        CHECK(locked.version() == 2);
+
+        auto const empty = hal::memberwise::seqlocked<Quote>{};
+        CHECK(empty.load().sequence == 0);
+    }
+
+    SECTION("readers never see a torn value")
+    {
+        constexpr auto stores = std::uint64_t{200'000};
+        auto locked           = hal::memberwise::seqlocked<Quote>{quote(0)};
+        auto torn             = std::atomic<int>{0};
+        auto done             = std::atomic<bool>{false};
+
+        auto readers = std::vector<std::thread>{};
+        for (auto r = 0; r < 3; ++r) {
+            readers.emplace_back([&] {
+                auto last = std::uint64_t{0};
+                while (!done.load(std::memory_order_relaxed)) {
+                    auto const q = locked.load();
+                    if (!consistent(q) || q.sequence < last)
+                        torn.fetch_add(1);
+                    last = q.sequence;
+                }
+            });
+        }
+        for (auto i = std::uint64_t{1}; i <= stores; ++i)
+            locked.store(quote(i));
+        done = true;
+        for (auto& reader : readers)
+            reader.join();
+
+        CHECK(torn == 0);
+        CHECK(locked.load().sequence == stores);
+    }
+}
+
+namespace {
+struct Stats {
+    std::uint64_t requests;
+    std::uint64_t bytes;
+    std::uint32_t max_latency;
+    std::uint32_t min_latency = 0xFFFFFFFF;
+};
+}  // namespace
+
+TEST_CASE("hal::sharded", "[HAL]")
+{
+    STATIC_REQUIRE(hal::merge::max{}(3, 5) == 5);
+    STATIC_REQUIRE(hal::merge::min{}(3, 5) == 3);
+
+    SECTION("single thread")
+    {
+        auto stats = hal::sharded<Stats>{Stats{}, 4};
+        CHECK(stats.shard_count() == 4);
+        auto const requests = stats.update([](Stats& s) {
+            s.requests += 2;
+            s.bytes += 100;
+            return s.requests;
+        });
+        CHECK(requests == 2);
+        auto const total = stats.snapshot();
+        CHECK(total.requests == 2);
+        CHECK(total.bytes == 100);
+
+        stats.reset();
+        CHECK(stats.snapshot(hal::merge::sum{}).requests == 0);
+        CHECK(hal::sharded<Stats>{Stats{}, 0}.shard_count() == 1);
+    }
+
+    SECTION("threads update their own shards")
+    {
+        constexpr auto threads = 4;
+        constexpr auto updates = 50'000;
+        // Fewer shards than threads, so some threads share one.
+        auto stats   = hal::sharded<Stats>{Stats{}, 3};
+        auto workers = std::vector<std::thread>{};
+        auto done    = std::atomic<bool>{false};
+        auto reader  = std::thread{[&] {
+            // Snapshots while the shards are updated.
+            while (!done) {
+                auto const partial =
+                    stats.snapshot(hal::merge::sum{}, hal::merge::sum{},
+                                   hal::merge::max{}, hal::merge::min{});
+                if (partial.bytes != partial.requests * 10)
+                    done = true;
+            }
+        }};
+        for (auto t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                for (auto i = 0; i < updates; ++i) {
+                    auto const latency = static_cast<std::uint32_t>(
+                        t * 1000 + i % 1000 + 1);
+                    stats.update([&](Stats& s) {
+                        ++s.requests;
+                        s.bytes += 10;
+                        s.max_latency = std::max(s.max_latency, latency);
+                        s.min_latency = std::min(s.min_latency, latency);
+                    });
+                }
+            });
+        }
+        for (auto& worker : workers)
+            worker.join();
+        auto const torn = done.exchange(true);
+        reader.join();
+
+        auto const total =
+            stats.snapshot(hal::merge::sum{}, hal::merge::sum{},
+                           hal::merge::max{}, hal::merge::min{});
+        CHECK_FALSE(torn);
+        CHECK(total.requests == threads * updates);
+        CHECK(total.bytes == threads * updates * 10);
+        CHECK(total.max_latency == (threads - 1) * 1000 + 1000);
+        CHECK(total.min_latency == 1);
+    }
+}
@@ -0,0 +1,244 @@
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+
+namespace {
+struct Tick {
+    std::uint32_t id;
+    double price;
+    std::array<std::int16_t, 3> sizes;
+};
+
+struct Defaulted {
+    int level = 3;
+    double price;
+};
+
+struct Named {
+    std::string name;
+    std::vector<int> values;
+};
+
+struct Owner {
+    std::unique_ptr<int> value;
+    Tick tick;
+};
+
+struct Counted {
+    static inline auto moves = 0;
+    int value                = 0;
+    Counted()                = default;
+    explicit Counted(int v) : value{v} {}
+    Counted(Counted&& other) noexcept : value{other.value} { ++moves; }
+    auto operator=(Counted&& other) noexcept -> Counted&
+    {
+        value = other.value;
+        ++moves;
+        return *this;
+    }
+};
+
+struct Wrapper {
+    Counted counted;
+    int other;
+};
+
+/// Only holds trivially relocatable members, but is not specialized.
+struct Holder {
+    std::unique_ptr<int> value;
+};
+
+/// Has a destructor of its own, so may rely on its address.
+struct Node {
+    Node* previous;
+    Node* next;
+    ~Node() {}
+};
+}  // namespace
+
+template <>
+struct hal::memberwise::is_trivially_relocatable<std::unique_ptr<int>>
+    : std::true_type {
+};
+
+template <>
+struct hal::memberwise::is_trivially_relocatable<Owner> : std::true_type {
+};
+
+TEST_CASE("hal::memberwise::is_trivially_relocatable", "[HAL]")
+{
+    using hal::memberwise::is_trivially_relocatable_v;
+    STATIC_REQUIRE(is_trivially_relocatable_v<int>);
+    STATIC_REQUIRE(is_trivially_relocatable_v<Tick const>);
+    STATIC_REQUIRE(is_trivially_relocatable_v<Tick[4]>);
+    STATIC_REQUIRE(is_trivially_relocatable_v<std::array<Tick, 4>>);
+    STATIC_REQUIRE(is_trivially_relocatable_v<Owner>);
+    STATIC_REQUIRE(is_trivially_relocatable_v<std::array<Owner, 2>>);
+    STATIC_REQUIRE_FALSE(is_trivially_relocatable_v<std::string>);
+    STATIC_REQUIRE_FALSE(is_trivially_relocatable_v<Named>);
+    STATIC_REQUIRE_FALSE(is_trivially_relocatable_v<Wrapper>);
+    STATIC_REQUIRE(is_trivially_relocatable_v<std::unique_ptr<int>>);
+    STATIC_REQUIRE_FALSE(is_trivially_relocatable_v<Holder>);
+    STATIC_REQUIRE_FALSE(is_trivially_relocatable_v<Node>);
+    STATIC_REQUIRE_FALSE(is_trivially_relocatable_v<Node[2]>);
+}
+
+TEST_CASE("hal::memberwise::copy and move", "[HAL]")
+{
+    SECTION("one aggregate")
+    {
+        auto const tick = Tick{7, 1.5, {1, 2, 3}};
+        auto copy       = Tick{};
+        hal::memberwise::copy(tick, copy);
+        CHECK(copy.id == 7);
+        CHECK(copy.sizes[2] == 3);
+
+        auto named  = Named{"a long name that won't fit in place", {1, 2}};
+        auto target = Named{};
+        hal::memberwise::copy(std::as_const(named), target);
+        CHECK(target.name == named.name);
+        hal::memberwise::move(named, target);
+        CHECK(target.values == std::vector{1, 2});
+        CHECK(named.values.empty());
+
+        constexpr auto copied = [] {
+            auto to = Tick{};
+            hal::memberwise::copy(Tick{1, 2., {3}}, to);
+            return to.sizes[0];
+        }();
+        STATIC_REQUIRE(copied == 3);
+
+        auto self = Tick{4, 2.5, {5, 6, 7}};
+        hal::memberwise::copy(std::as_const(self), self);
+        CHECK(self.id == 4);
+        CHECK(self.sizes[2] == 7);
+    }
+
+    SECTION("spans")
+    {
+        auto from = std::vector<Tick>(100);
+        for (auto i = 0; i < 100; ++i)
+            from[i] = Tick{static_cast<std::uint32_t>(i), i * 0.5, {}};
+        auto to = std::vector<Tick>(100);
+        hal::memberwise::copy(from, to);
+        CHECK(to[99].price == 49.5);
+
+        // Overlapping, as when shifting a buffer.
+        hal::memberwise::copy(std::span{from}.subspan(1),
+                              std::span{from}.first(99));
+        CHECK(from[0].id == 1);
+        CHECK(from[98].id == 99);
+
+        auto names = std::vector<Named>(3, Named{"x", {1}});
+        auto moved = std::vector<Named>(3);
+        hal::memberwise::move(names, moved);
+        CHECK(moved[2].name == "x");
+        CHECK(names[2].values.empty());
+
+        Counted::moves = 0;
+        auto wrappers  = std::vector<Wrapper>(4);
+        auto targets   = std::vector<Wrapper>(4);
+        wrappers[3].counted.value = 9;
+        hal::memberwise::move(wrappers, targets);
+        CHECK(Counted::moves == 4);
+        CHECK(targets[3].counted.value == 9);
+    }
+}
+
+TEST_CASE("hal::memberwise::swap", "[HAL]")
+{
+    auto a = Tick{1, 1., {1}};
+    auto b = Tick{2, 2., {2}};
+    hal::memberwise::swap(a, b);
+    CHECK(a.id == 2);
+    CHECK(b.sizes[0] == 1);
+
+    auto x = Named{"x", {}};
+    auto y = Named{"y", {1}};
+    hal::memberwise::swap(x, y);
+    CHECK(x.name == "y");
+    CHECK(y.values.empty());
+
+    hal::memberwise::swap(a, a);
+    CHECK(a.id == 2);
+    CHECK(a.sizes[0] == 2);
+    hal::memberwise::swap(x, x);
+    CHECK(x.name == "y");
+
+    // More bytes than the swap buffer, and not a multiple of it.
+    auto left  = std::vector<Tick>(1001, Tick{1, 1., {}});
+    auto right = std::vector<Tick>(1001, Tick{2, 2., {}});
+    hal::memberwise::swap(left, right);
+    auto swapped = true;
+    for (auto i = 0; i < 1001; ++i)
+        swapped = swapped && left[i].id == 2 && right[i].id == 1;
+    CHECK(swapped);
+
+    hal::memberwise::swap(left, left);
+    CHECK(left[1000].id == 2);
+}
+
+TEST_CASE("hal::memberwise::reset", "[HAL]")
+{
+    STATIC_REQUIRE(hal::detail::is_zero_initialized<Tick>);
+    STATIC_REQUIRE_FALSE(hal::detail::is_zero_initialized<Defaulted>);
+
+    auto ticks = std::vector<Tick>(10, Tick{1, 1., {1, 1, 1}});
+    hal::memberwise::reset(ticks);
+    CHECK(ticks[9].id == 0);
+    CHECK(ticks[9].sizes[2] == 0);
+
+    auto defaulted = Defaulted{7, 1.};
+    hal::memberwise::reset(defaulted);
+    CHECK(defaulted.level == 3);
+    CHECK(defaulted.price == 0.);
+
+    auto named = Named{"x", {1}};
+    hal::memberwise::reset(named);
+    CHECK(named.name.empty());
+    CHECK(named.values.empty());
+}
+
+TEST_CASE("hal::memberwise::relocate", "[HAL]")
+{
+    auto relocated = [](auto& from, auto* to) {
+        hal::memberwise::relocate(from, to);
+    };
+
+    SECTION("trivially relocatable")
+    {
+        auto owners = std::array<Owner, 3>{};
+        for (auto i = 0; i < 3; ++i)
+            owners[i].value = std::make_unique<int>(i);
+        alignas(Owner) unsigned char storage[sizeof(owners)];
+        auto* const to = reinterpret_cast<Owner*>(storage);
+        relocated(owners, to);
+        // The sources are no longer alive, so release them unseen.
+        for (auto& owner : owners)
+            ::new (static_cast<void*>(&owner.value)) std::unique_ptr<int>{};
+        CHECK(*to[2].value == 2);
+        std::destroy_n(to, 3);
+    }
+
+    SECTION("member by member")
+    {
+        auto names = std::vector<Named>(2, Named{"x", {1}});
+        alignas(Named) unsigned char storage[2 * sizeof(Named)];
+        auto* const to = reinterpret_cast<Named*>(storage);
+        relocated(names, to);
+        CHECK(to[1].name == "x");
+        // Bring the sources back to life for the vector's destructor.
+        for (auto& name : names)
+            ::new (static_cast<void*>(&name)) Named{};
+        std::destroy_n(to, 2);
+    }
+}
@@ -0,0 +1,151 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+
+namespace {
+enum class Status : std::uint8_t { open, filled, cancelled };
+
+struct Position {
+    std::uint32_t account;
+    std::int64_t quantity;
+    double average_price;
+    Status status;
+    std::uint16_t venue;
+};
+
+/// Nine members, for a 16-bit mask.
+struct Wide {
+    std::uint8_t a, b, c, d, e, f, g, h, i;
+};
+}  // namespace
+
+TEST_CASE("hal::memberwise::diff", "[HAL]")
+{
+    STATIC_REQUIRE(
+        std::is_same_v<hal::memberwise::diff_mask_t<Position>, std::uint8_t>);
+    STATIC_REQUIRE(
+        std::is_same_v<hal::memberwise::diff_mask_t<Wide>, std::uint16_t>);
+
+    constexpr auto before = Position{7, 100, 12.5, Status::open, 3};
+    STATIC_REQUIRE(hal::memberwise::diff(before, before) == 0);
+
+    auto after     = before;
+    after.quantity = 50;
+    after.status   = Status::filled;
+    CHECK(hal::memberwise::diff(before, after) == 0b01010);
+
+    // Bits, not ==, for floating point members.
+    auto nan          = before;
+    nan.average_price = std::numeric_limits<double>::quiet_NaN();
+    CHECK(hal::memberwise::diff(nan, nan) == 0);
+    auto zero                   = before;
+    zero.average_price          = 0.;
+    auto negative_zero          = zero;
+    negative_zero.average_price = -0.;
+    CHECK(hal::memberwise::diff(zero, negative_zero) == 0b00100);
+
+    auto wide = Wide{};
+    wide.i    = 1;
+    CHECK(hal::memberwise::diff(Wide{}, wide) == 0x100);
+}
+
+TEST_CASE("hal::memberwise::diff over spans", "[HAL]")
+{
+    auto previous = std::vector<Position>(1000);
+    for (auto i = 0; i < 1000; ++i)
+        previous[i] = Position{static_cast<std::uint32_t>(i), i, 1., {}, 0};
+    auto next          = previous;
+    next[0].venue      = 1;
+    next[500].account  = 9;
+    next[500].venue    = 2;
+    next[999].quantity = -1;
+
+    auto masks = std::vector<std::uint8_t>(1000, 0xFF);
+    CHECK(hal::memberwise::diff(previous, next, masks) == 3);
+    CHECK(masks[0] == 0b10000);
+    CHECK(masks[500] == 0b10001);
+    CHECK(masks[999] == 0b00010);
+    auto others_clean = true;
+    for (auto i = 1; i < 999; ++i)
+        others_clean = others_clean && (i == 500 || masks[i] == 0);
+    CHECK(others_clean);
+
+    // Only the rows of next are diffed, previous and masks may be longer.
+    CHECK(hal::memberwise::diff(previous, std::span{next}.first(1), masks) ==
+          1);
+
+    constexpr auto changed = [] {
+        auto const a = std::array{Position{}, Position{}};
+        auto const b = std::array{Position{}, Position{1, 0, 0., {}, 0}};
+        auto masks   = std::array<std::uint8_t, 2>{};
+        return hal::memberwise::diff(a, b, masks) * 10 + masks[1];
+    }();
+    STATIC_REQUIRE(changed == 11);
+}
+
+TEST_CASE("hal::memberwise::encode_delta and apply_delta", "[HAL]")
+{
+    STATIC_REQUIRE(hal::memberwise::max_delta_size_v<Position> == 1 + 23);
+
+    auto const before = Position{7, 100, 12.5, Status::open, 3};
+    auto after        = before;
+    after.quantity    = -50;
+    after.venue       = 0x0102;
+
+    auto delta =
+        std::array<std::byte, hal::memberwise::max_delta_size_v<Position>>{};
+    auto const mask = hal::memberwise::diff(before, after);
+    auto const size = hal::memberwise::encode_delta(mask, after, delta);
+    REQUIRE(size == 1 + 8 + 2);
+    CHECK(delta[0] == std::byte{0b10010});
+    CHECK(delta[9] == std::byte{0x02});
+    CHECK(delta[10] == std::byte{0x01});
+
+    auto replica = before;
+    CHECK(hal::memberwise::apply_delta(
+              replica, std::span<std::byte const>{delta}.first(size)) == size);
+    CHECK(hal::memberwise::diff(replica, after) == 0);
+
+    SECTION("empty delta")
+    {
+        CHECK(hal::memberwise::encode_delta(0, after, delta) == 1);
+        CHECK(hal::memberwise::apply_delta(
+                  replica, std::span<std::byte const>{delta}.first(1)) == 1);
+        CHECK(hal::memberwise::diff(replica, after) == 0);
+    }
+
+    SECTION("malformed deltas")
+    {
+        auto const bytes = std::span<std::byte const>{delta};
+        CHECK(hal::memberwise::apply_delta(replica, bytes.first(0)) == 0);
+        CHECK(hal::memberwise::apply_delta(replica, bytes.first(size - 1)) ==
+              0);
+        delta[0] = std::byte{0b100000};
+        CHECK(hal::memberwise::apply_delta(replica, bytes) == 0);
+        CHECK(hal::memberwise::diff(replica, after) == 0);
+    }
+
+    SECTION("at compile time")
+    {
+        constexpr auto replicated = [] {
+            auto const next = Position{1, 2, 3., Status::cancelled, 4};
+            auto bytes =
+                std::array<std::byte,
+                           hal::memberwise::max_delta_size_v<Position>>{};
+            auto const mask = hal::memberwise::diff(Position{}, next);
+            hal::memberwise::encode_delta(mask, next, bytes);
+            auto replica = Position{};
+            hal::memberwise::apply_delta(replica,
+                                         std::span<std::byte const>{bytes});
+            return hal::memberwise::diff(replica, next);
+        }();
+        STATIC_REQUIRE(replicated == 0);
+    }
+}
@@ -172,3 +172,75 @@ TEST_CASE("reverse::find", "[HAL]")
         static_assert(hal::reverse::find(1, 1, 'b', 3, 4, 5, 6) == 0);
     }
 }
+
+TEST_CASE("find short circuit", "[HAL]")
+{
+    auto calls       = 0;
+    auto const count = [&calls](auto pred) {
+        return [&calls, pred](auto x) {
+            ++calls;
+            return pred(x);
+        };
+    };
+    auto const gt_4 = [](auto x) { return x > 4; };
+
+    SECTION("find_if")
+    {
+        CHECK(hal::find_if(count(gt_4), 1, 2, 3, 4, 5, 6, 7) == 4);
+        CHECK(calls == 5);
+        calls = 0;
+        CHECK(hal::find_if(count(gt_4), 5, 6, 7) == 0);
+        CHECK(calls == 1);
+        calls = 0;
+        CHECK(hal::find_if(count(gt_4), 1, 2, 3) == 3);
+        CHECK(calls == 3);
+    }
+    SECTION("find_if_not")
+    {
+        CHECK(hal::find_if_not(count(gt_4), 5, 6, 1, 7, 8) == 2);
+        CHECK(calls == 3);
+    }
+    SECTION("find")
+    {
+        auto compares = 0;
+        struct Counted {
+            int value;
+            int* compares;
+            auto operator==(int x) const -> bool
+            {
+                ++*compares;
+                return value == x;
+            }
+        };
+        auto const c = [&compares](int x) { return Counted{x, &compares}; };
+        CHECK(hal::find(3, c(1), c(2), c(3), c(4), c(3)) == 2);
+        CHECK(compares == 3);
+    }
+    SECTION("reverse::find_if")
+    {
+        CHECK(hal::reverse::find_if(count(gt_4), 1, 2, 5, 3, 4) == 2);
+        CHECK(calls == 3);
+        calls = 0;
+        CHECK(hal::reverse::find_if(count(gt_4), 1, 2, 3) == 3);
+        CHECK(calls == 3);
+    }
+    SECTION("reverse::find_if_not")
+    {
+        CHECK(hal::reverse::find_if_not(count(gt_4), 1, 2, 5, 6, 7) == 1);
+        CHECK(calls == 4);
+    }
+    SECTION("constexpr")
+    {
+        constexpr auto calls_until_found = [] {
+            auto n = 0;
+            hal::find_if(
+                [&n](auto x) {
+                    ++n;
+                    return x == 'c';
+                },
+                'a', 'b', 'c', 'd', 'e');
+            return n;
+        }();
+        static_assert(calls_until_found == 3);
+    }
+}
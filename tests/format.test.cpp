@@ -0,0 +1,103 @@
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include <catch2/catch.hpp>
+
+#include <hal/format.hpp>
+
+namespace {
+enum class Side : std::uint8_t { bid, ask };
+
+struct Trade {
+    std::array<char, 8> symbol;
+    std::int64_t time;
+    double price;
+    std::uint32_t size;
+    Side side;
+    bool odd_lot;
+};
+
+/// Formats with \p format into a stack buffer of the compile time size.
+template <std::size_t size, typename Format>
+auto formatted(Format format) -> std::string
+{
+    auto buffer    = std::array<char, size>{};
+    auto const end = format(buffer.data());
+    REQUIRE(end <= buffer.data() + size);
+    return std::string(buffer.data(), end);
+}
+}  // namespace
+
+TEST_CASE("hal::format_to", "[HAL]")
+{
+    SECTION("each type")
+    {
+        auto const text =
+            formatted<hal::max_formatted_size_v<int, double, char, bool,
+                                                Side, char const(&)[6]>>(
+                [](char* out) {
+                    return hal::format_to(out, -42, 0.1, 'x', false,
+                                          Side::ask, "hello");
+                });
+        CHECK(text == "-42 0.1 x false 1 hello");
+    }
+
+    SECTION("separator")
+    {
+        auto buffer    = std::array<char, 64>{};
+        auto const end = hal::format_to<','>(buffer.data(), 1, 2u, 3.5f);
+        CHECK(std::string_view(buffer.data(), end) == "1,2,3.5");
+        CHECK(hal::format_to(buffer.data()) == buffer.data());
+    }
+
+    SECTION("worst case sizes")
+    {
+        STATIC_REQUIRE(hal::max_formatted_size_v<> == 0);
+        STATIC_REQUIRE(hal::max_formatted_size_v<std::int8_t> == 4);
+        STATIC_REQUIRE(hal::max_formatted_size_v<std::uint64_t> == 20);
+        STATIC_REQUIRE(hal::max_formatted_size_v<std::int64_t, bool> == 26);
+        STATIC_REQUIRE(hal::max_formatted_size_v<double> == 24);
+        STATIC_REQUIRE(hal::max_formatted_size_v<float> == 15);
+
+        using Int64  = std::numeric_limits<std::int64_t>;
+        using Double = std::numeric_limits<double>;
+        using Float  = std::numeric_limits<float>;
+        CHECK(formatted<20>([](char* out) {
+                  return hal::format_to(out, Int64::min());
+              }).size() == 20);
+        CHECK(formatted<24>([](char* out) {
+                  return hal::format_to(out, -Double::min());
+              }) == "-2.2250738585072014e-308");
+        CHECK(formatted<24>([](char* out) {
+                  return hal::format_to(out, -Double::denorm_min());
+              }) == "-5e-324");
+        CHECK(formatted<15>([](char* out) {
+                  return hal::format_to(out, -Float::min());
+              }) == "-1.1754944e-38");
+    }
+}
+
+TEST_CASE("hal::memberwise::format_to", "[HAL]")
+{
+    STATIC_REQUIRE(hal::memberwise::max_formatted_size_v<Trade> ==
+                   8 + 20 + 24 + 10 + 3 + 5 + 5);
+
+    auto const trade = Trade{{'A', 'A', 'P', 'L'}, 1'700'000'000'123,
+                             189.25, 300, Side::bid, true};
+    auto const text =
+        formatted<hal::memberwise::max_formatted_size_v<Trade>>(
+            [&](char* out) {
+                return hal::memberwise::format_to<'|'>(out, trade);
+            });
+    CHECK(text == "AAPL|1700000000123|189.25|300|0|true");
+
+    auto const full = Trade{{'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H'}, 0,
+                            -0., 0, Side::ask, false};
+    CHECK(formatted<hal::memberwise::max_formatted_size_v<Trade>>(
+              [&](char* out) {
+                  return hal::memberwise::format_to(out, full);
+              }) == "ABCDEFGH 0 -0 0 1 false");
+}
@@ -0,0 +1,165 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <hal/hash.hpp>
+
+namespace {
+enum class Side : std::uint8_t { bid, ask };
+
+struct Key {
+    std::uint32_t account;
+    std::uint16_t venue;
+    Side side;
+    std::uint8_t flags;
+    std::array<std::uint32_t, 2> ids;
+};
+
+struct Padded {
+    std::uint8_t kind;
+    std::uint64_t id;
+};
+
+struct Quote {
+    std::string symbol;
+    double price;
+    std::int32_t size;
+};
+
+auto bytes_of(std::string_view text) -> std::vector<std::byte>
+{
+    auto result = std::vector<std::byte>(text.size());
+    for (auto i = std::size_t{0}; i < text.size(); ++i)
+        result[i] = static_cast<std::byte>(text[i]);
+    return result;
+}
+}  // namespace
+
+TEST_CASE("hal::hash", "[HAL]")
+{
+    SECTION("equal elements hash equal")
+    {
+        CHECK(hal::hash(1, 2.5, std::string{"abc"}) ==
+              hal::hash(1, 2.5, std::string_view{"abc"}));
+        CHECK(hal::hash(0.0) == hal::hash(-0.0));
+        CHECK(hal::hash(std::array{1, 2, 3}) == hal::hash(std::array{1, 2, 3}));
+        STATIC_REQUIRE(hal::hash(1, Side::ask) == hal::hash(1, Side::ask));
+    }
+
+    SECTION("order and count matter")
+    {
+        CHECK(hal::hash(1, 2) != hal::hash(2, 1));
+        CHECK(hal::hash(1) != hal::hash(1, 0));
+        CHECK(hal::hash() != hal::hash(0));
+        CHECK(hal::hash(std::string_view{"ab"}, std::string_view{"c"}) !=
+              hal::hash(std::string_view{"a"}, std::string_view{"bc"}));
+    }
+
+    SECTION("few collisions")
+    {
+        // Byte strings of every length from 0 to 200, through each path.
+        auto hashes = std::unordered_set<std::uint64_t>{};
+        auto text   = std::string{};
+        for (auto i = 0; i <= 200; ++i, text += char('a' + i % 26))
+            hashes.insert(hal::hash(text));
+        for (auto i = 0; i < 100'000; ++i)
+            hashes.insert(hal::hash(i));
+        CHECK(hashes.size() == 201 + 100'000);
+    }
+}
+
+TEST_CASE("hal::memberwise::hash", "[HAL]")
+{
+    STATIC_REQUIRE(hal::detail::is_hashed_as_bytes<Key>);
+    STATIC_REQUIRE_FALSE(hal::detail::is_hashed_as_bytes<Padded>);
+    STATIC_REQUIRE_FALSE(hal::detail::is_hashed_as_bytes<Quote>);
+
+    SECTION("bulk bytes")
+    {
+        constexpr auto key = Key{7, 3, Side::ask, 0, {11, 12}};
+        constexpr auto same = Key{7, 3, Side::ask, 0, {11, 12}};
+        STATIC_REQUIRE(hal::memberwise::hash(key) ==
+                       hal::memberwise::hash(same));
+        CHECK(hal::memberwise::hash(key) !=
+              hal::memberwise::hash(Key{7, 3, Side::bid, 0, {11, 12}}));
+        CHECK(hal::memberwise::hash(key) !=
+              hal::memberwise::hash(Key{7, 3, Side::ask, 0, {11, 13}}));
+    }
+
+    SECTION("padding is skipped")
+    {
+        auto a = Padded{};
+        auto b = Padded{};
+        std::memset(&a, 0x00, sizeof(a));
+        std::memset(&b, 0xFF, sizeof(b));
+        a.kind = b.kind = 1;
+        a.id = b.id = 2;
+        CHECK(hal::memberwise::hash(a) == hal::memberwise::hash(b));
+        CHECK(hal::memberwise::hash(a) == hal::hash(std::uint8_t{1}, 2ull));
+    }
+
+    SECTION("unordered_map")
+    {
+        auto map = std::unordered_map<Quote, int, hal::memberwise::hasher,
+                                      decltype([](auto& a, auto& b) {
+                                          return a.symbol == b.symbol &&
+                                                 a.price == b.price &&
+                                                 a.size == b.size;
+                                      })>{};
+        map[Quote{"AAPL", 189.25, 100}] = 1;
+        map[Quote{"MSFT", 402.5, 100}]  = 2;
+        CHECK(map.at(Quote{"AAPL", 189.25, 100}) == 1);
+        CHECK(map.count(Quote{"AAPL", 189.25, 101}) == 0);
+    }
+}
+
+TEST_CASE("hal::crc32c", "[HAL]")
+{
+    SECTION("check values")
+    {
+        CHECK(hal::crc32c(bytes_of("123456789")) == 0xE3069283);
+        CHECK(hal::crc32c({}) == 0);
+        CHECK(hal::crc32c(std::vector<std::byte>(32, std::byte{0})) ==
+              0x8A9136AA);
+        STATIC_REQUIRE(hal::crc32c(std::array<std::byte, 4>{}) == 0x48674BC7);
+    }
+
+    SECTION("chaining and table fallback agree")
+    {
+        auto text = std::string{};
+        for (auto i = 0; i < 1000; ++i)
+            text += char(i * 7 + i / 13);
+        auto const bytes = bytes_of(text);
+        auto const whole = hal::crc32c(bytes);
+        auto const span  = std::span<std::byte const>{bytes};
+        for (auto split : {0, 1, 7, 8, 9, 500, 999, 1000})
+            CHECK(hal::crc32c(span.subspan(split),
+                              hal::crc32c(span.first(split))) == whole);
+        auto crc = ~std::uint32_t{0};
+        for (auto byte : bytes) {
+            crc = crc >> 8 ^ hal::detail::crc32c_tables[0][(
+                                 crc ^ std::to_integer<std::uint32_t>(byte)) &
+                             0xFF];
+        }
+        CHECK(~crc == whole);
+    }
+
+    SECTION("memberwise")
+    {
+        auto const key  = Padded{1, 0x0102030405060708};
+        auto serialized  = std::array<std::byte, 9>{};
+        hal::memberwise::serialize(key, serialized);
+        CHECK(hal::memberwise::crc32c(key) == hal::crc32c(serialized));
+        STATIC_REQUIRE(hal::memberwise::crc32c(Padded{1, 2}) ==
+                       hal::memberwise::crc32c(Padded{1, 2}));
+    }
+}
@@ -0,0 +1,158 @@
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+
+namespace {
+
+constexpr auto size = std::size_t{1'000};
+
+/// Invokes \p f with the values 0 to size - 1 as a parameter pack.
+template <typename Fn>
+constexpr auto with_pack(Fn&& f) -> decltype(auto)
+{
+    return [&]<std::size_t... I>(std::index_sequence<I...>)->decltype(auto)
+    {
+        return f(I...);
+    }
+    (std::make_index_sequence<size>{});
+}
+
+/// Invokes \p f with references to each element of \p a as a parameter pack.
+template <typename T, typename Fn>
+constexpr auto with_refs(std::array<T, size>& a, Fn&& f) -> decltype(auto)
+{
+    return [&]<std::size_t... I>(std::index_sequence<I...>)->decltype(auto)
+    {
+        return f(a[I]...);
+    }
+    (std::make_index_sequence<size>{});
+}
+
+constexpr auto iota()
+{
+    auto a = std::array<std::size_t, size>{};
+    for (auto i = std::size_t{0}; i < size; ++i)
+        a[i] = i;
+    return a;
+}
+
+constexpr auto sum = size * (size - 1) / 2;
+
+}  // namespace
+
+TEST_CASE("reverse:: algorithms on large packs", "[HAL]")
+{
+    namespace hr = hal::reverse;
+
+    SECTION("for_each")
+    {
+        auto order = std::size_t{size};
+        auto ok    = true;
+        with_pack([&](auto... x) {
+            hr::for_each([&](std::size_t i) { ok = ok && (i == --order); },
+                         x...);
+        });
+        CHECK(ok);
+        CHECK(order == 0);
+    }
+    SECTION("all_of / any_of / none_of")
+    {
+        auto const lt_size = [](std::size_t i) { return i < size; };
+        auto const is_0    = [](std::size_t i) { return i == 0; };
+        CHECK(with_pack([&](auto... x) { return hr::all_of(lt_size, x...); }));
+        CHECK(with_pack([&](auto... x) { return hr::any_of(is_0, x...); }));
+        CHECK(with_pack([&](auto... x) { return !hr::none_of(is_0, x...); }));
+        CHECK(with_pack([](auto... x) { return !hr::all(x...); }));
+        CHECK(with_pack([](auto... x) { return hr::any(x...); }));
+        CHECK(with_pack([](auto... x) { return !hr::none(x...); }));
+    }
+    SECTION("reduce")
+    {
+        CHECK(with_pack([](auto... x) {
+                  return hr::reduce(std::size_t{0}, std::plus<>{}, x...);
+              }) == sum);
+    }
+    SECTION("transform_reduce")
+    {
+        CHECK(with_pack([](auto... x) {
+                  return hr::transform_reduce(
+                      std::size_t{0}, [](auto i) { return i * 2; },
+                      std::plus<>{}, x...);
+              }) == 2 * sum);
+    }
+    SECTION("find_if / find_if_not / find")
+    {
+        auto const is_3 = [](std::size_t i) { return i == 3; };
+        CHECK(with_pack([&](auto... x) { return hr::find_if(is_3, x...); }) ==
+              3);
+        CHECK(with_pack([&](auto... x) {
+                  return hr::find_if_not(std::not_fn(is_3), x...);
+              }) == 3);
+        CHECK(with_pack([](auto... x) {
+                  return hr::find(std::size_t{size}, x...);
+              }) == size);
+    }
+    SECTION("transform")
+    {
+        auto a = iota();
+        with_refs(a, [](auto&... x) {
+            hr::transform([](auto i) { return i + 1; }, x...);
+        });
+        CHECK(a.front() == 1);
+        CHECK(a.back() == size);
+    }
+    SECTION("partial_reduce / partial_transform_reduce")
+    {
+        auto a = iota();
+        with_refs(a, [](auto&... x) {
+            hr::partial_reduce(std::size_t{0}, std::plus<>{}, x...);
+        });
+        CHECK(a.front() == sum);
+        CHECK(a.back() == size - 1);
+
+        auto b = iota();
+        with_refs(b, [](auto&... x) {
+            hr::partial_transform_reduce(std::size_t{0}, std::identity{},
+                                         std::plus<>{}, x...);
+        });
+        CHECK(b == a);
+    }
+    SECTION("partial_sum / difference / product / quotient")
+    {
+        auto a = iota();
+        with_refs(a, [](auto&... x) { hr::partial_sum(x...); });
+        CHECK(a.front() == sum);
+
+        auto b = std::array<long, size>{};
+        b.fill(1);
+        with_refs(b, [](auto&... x) { hr::partial_difference(x...); });
+        CHECK(b.front() == -static_cast<long>(size));
+
+        auto c = std::array<long, size>{};
+        c.fill(1);
+        with_refs(c, [](auto&... x) { hr::partial_product(x...); });
+        CHECK(c.front() == 1);
+
+        auto d = std::array<long, size>{};
+        d.fill(1);
+        with_refs(d, [](auto&... x) { hr::partial_quotient(x...); });
+        CHECK(d.front() == 1);
+    }
+    SECTION("constexpr")
+    {
+        static_assert(with_pack([](auto... x) {
+                          return hr::reduce(std::size_t{0}, std::plus<>{},
+                                            x...);
+                      }) == sum);
+        static_assert(with_pack([](auto... x) {
+                          return hr::find_if(
+                              [](std::size_t i) { return i < 10; }, x...);
+                      }) == 9);
+        static_assert(with_pack([](auto... x) { return hr::any(x...); }));
+    }
+}
@@ -0,0 +1,159 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+
+namespace {
+constexpr auto is_odd = [](auto x) { return x % 2 == 1; };
+
+/// Invokes \p f with each element of \p a as a parameter pack.
+template <std::size_t N, typename Fn>
+constexpr auto with_pack(std::array<int, N> const& a, Fn&& f) -> decltype(auto)
+{
+    return [&]<std::size_t... I>(std::index_sequence<I...>)->decltype(auto)
+    {
+        return f(a[I]...);
+    }
+    (std::make_index_sequence<N>{});
+}
+
+/// Values 0 to N - 1, with every seventh value replaced by 1.
+template <std::size_t N>
+constexpr auto values() -> std::array<int, N>
+{
+    auto a = std::array<int, N>{};
+    for (auto i = std::size_t{0}; i < N; ++i)
+        a[i] = (i % 7 == 6) ? 1 : static_cast<int>(i);
+    return a;
+}
+
+/// Checks the branchless algorithms against the branching ones, for N values.
+template <std::size_t N>
+void check_against_branching()
+{
+    using Predicate = bool (*)(int);
+
+    auto const a          = values<N>();
+    auto const predicates = std::array<Predicate, 4>{
+        [](int x) { return x == 7; }, [](int x) { return x >= 0; },
+        [](int x) { return x > 60; }, [](int x) { return x % 2 == 1; }};
+    for (auto const pred : predicates) {
+        CHECK(with_pack(a, hal::branchless::count_if(pred)) ==
+              with_pack(a, hal::count_if(pred)));
+        CHECK(with_pack(a, hal::branchless::all_of(pred)) ==
+              with_pack(a, hal::all_of(pred)));
+        CHECK(with_pack(a, hal::branchless::any_of(pred)) ==
+              with_pack(a, hal::any_of(pred)));
+        CHECK(with_pack(a, hal::branchless::none_of(pred)) ==
+              with_pack(a, hal::none_of(pred)));
+        CHECK(with_pack(a, hal::branchless::find_if(pred)) ==
+              with_pack(a, hal::find_if(pred)));
+    }
+}
+}  // namespace
+
+TEST_CASE("hal::match_mask", "[HAL]")
+{
+    SECTION("full call")
+    {
+        CHECK(hal::match_mask(is_odd, 1, 2, 3, 4) == 0b0101u);
+        CHECK(hal::match_mask(is_odd, 2, 4L, 'a', 9u) == 0b1100u);
+        CHECK(hal::match_mask([](auto const& s) { return s.empty(); },
+                              std::string{}, std::string{"x"}) == 0b01u);
+    }
+
+    SECTION("every predicate is evaluated")
+    {
+        auto calls      = 0;
+        auto const mask = hal::match_mask(
+            [&](int x) {
+                ++calls;
+                return x > 0;
+            },
+            1, 2, 3, 4, 5);
+        CHECK(mask == 0b11111u);
+        CHECK(calls == 5);
+    }
+
+    SECTION("64 elements fit in one word")
+    {
+        auto const mask = with_pack(values<64>(), hal::match_mask(is_odd));
+        static_assert(std::is_same_v<decltype(mask), std::uint64_t const>);
+        CHECK(mask >> 63 == 1u);
+        CHECK((mask & 0b1111111u) == 0b1101010u);
+    }
+
+    SECTION("larger packs are split into words")
+    {
+        auto const mask = with_pack(values<130>(), hal::match_mask(is_odd));
+        static_assert(
+            std::is_same_v<decltype(mask), std::array<std::uint64_t, 3> const>);
+        CHECK(mask[0] >> 63 == 1u);
+        CHECK((mask[1] & 0b11u) == 0b10u);
+        CHECK(mask[2] == 0b10u);
+    }
+
+    SECTION("constexpr")
+    {
+        static_assert(hal::match_mask(is_odd, 3, 4, 5) == 0b101u);
+        constexpr auto odd_mask = hal::match_mask(is_odd);
+        static_assert(odd_mask(1, 1, 1, 1) == 0b1111u);
+    }
+}
+
+TEST_CASE("hal::branchless", "[HAL]")
+{
+    SECTION("full call")
+    {
+        CHECK(hal::branchless::count_if(is_odd, 1, 2, 3, 4, 5) == 3);
+        CHECK(hal::branchless::all_of(is_odd, 1, 3, 5));
+        CHECK(!hal::branchless::all_of(is_odd, 1, 2, 5));
+        CHECK(hal::branchless::any_of(is_odd, 2, 4, 5));
+        CHECK(!hal::branchless::any_of(is_odd, 2, 4, 6));
+        CHECK(hal::branchless::none_of(is_odd, 2, 4, 6));
+        CHECK(hal::branchless::find_if(is_odd, 2, 4, 5, 7) == 2);
+        CHECK(hal::branchless::find_if(is_odd, 2, 4, 6) == 3);
+    }
+
+    SECTION("single element")
+    {
+        CHECK(hal::branchless::count_if(is_odd, 1) == 1);
+        CHECK(hal::branchless::all_of(is_odd, 2) == false);
+        CHECK(hal::branchless::find_if(is_odd, 1) == 0);
+    }
+
+    SECTION("matches the branching algorithms")
+    {
+        check_against_branching<3>();
+        check_against_branching<63>();
+        check_against_branching<64>();
+        check_against_branching<65>();
+        check_against_branching<200>();
+    }
+
+    SECTION("partial application")
+    {
+        auto count_odd = hal::branchless::count_if(is_odd);
+        CHECK(count_odd(1, 3, 5) == 3);
+        CHECK(count_odd(2) == 0);
+        auto find_odd = hal::branchless::find_if(is_odd);
+        CHECK(find_odd(2, 2, 3) == 2);
+    }
+
+    SECTION("constexpr")
+    {
+        static_assert(hal::branchless::count_if(is_odd, 1, 2, 3) == 2);
+        static_assert(hal::branchless::all_of(is_odd, 1, 3, 5));
+        static_assert(hal::branchless::any_of(is_odd, 2, 4, 5));
+        static_assert(hal::branchless::none_of(is_odd, 2, 4, 6));
+        static_assert(hal::branchless::find_if(is_odd, 2, 4, 5) == 2);
+        constexpr auto above_90 = [](int x) { return x > 90; };
+        static_assert(with_pack(values<100>(),
+                                hal::branchless::find_if(above_90)) == 91);
+    }
+}
@@ -0,0 +1,264 @@
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <hal/par.hpp>
+
+namespace {
+constexpr auto twice = [](auto x) { return x * 2; };
+}  // namespace
+
+TEST_CASE("hal::par::Pool", "[HAL]")
+{
+    SECTION("runs every index once")
+    {
+        auto pool   = hal::par::Pool{3};
+        auto counts = std::array<std::atomic<int>, 100>{};
+        pool.run(
+            [](void* c, std::size_t i) {
+                (*static_cast<decltype(counts)*>(c))[i].fetch_add(1);
+            },
+            &counts, counts.size());
+        for (auto const& count : counts)
+            CHECK(count.load() == 1);
+    }
+
+    SECTION("tasks run concurrently")
+    {
+        // Each task waits for the other to start, so this only returns if
+        // they are run on two threads at once.
+        auto pool    = hal::par::Pool{1};
+        auto started = std::atomic<int>{0};
+        pool.run(
+            [](void* c, std::size_t) {
+                auto& started = *static_cast<std::atomic<int>*>(c);
+                started.fetch_add(1);
+                while (started.load() < 2)
+                    std::this_thread::yield();
+            },
+            &started, 2);
+        CHECK(started.load() == 2);
+    }
+
+    SECTION("waits for tasks running on other threads")
+    {
+        // The caller takes one of the tasks, and sleeps until the slower
+        // one on the worker is done.
+        auto pool     = hal::par::Pool{1};
+        auto finished = std::atomic<int>{0};
+        pool.run(
+            [](void* c, std::size_t i) {
+                if (i == 0)
+                    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+                static_cast<std::atomic<int>*>(c)->fetch_add(1);
+            },
+            &finished, 2);
+        CHECK(finished.load() == 2);
+    }
+
+    SECTION("no worker threads")
+    {
+        auto pool = hal::par::Pool{0};
+        auto sum  = 0;
+        pool.run([](void* c, std::size_t i) { *static_cast<int*>(c) += i; },
+                 &sum, 5);
+        CHECK(sum == 10);
+    }
+
+    SECTION("exceptions are rethrown once all tasks are done")
+    {
+        auto pool     = hal::par::Pool{2};
+        auto finished = std::atomic<int>{0};
+        auto const run = [&] {
+            pool.run(
+                [](void* c, std::size_t i) {
+                    if (i == 3)
+                        throw std::runtime_error{"three"};
+                    static_cast<std::atomic<int>*>(c)->fetch_add(1);
+                },
+                &finished, 8);
+        };
+        CHECK_THROWS_WITH(run(), "three");
+        CHECK(finished.load() == 7);
+    }
+}
+
+TEST_CASE("hal::par::for_each", "[HAL]")
+{
+    SECTION("visits every element")
+    {
+        auto mutex   = std::mutex{};
+        auto visited = std::multiset<std::string>{};
+        auto record  = [&](auto const& x) {
+            auto const lock = std::lock_guard{mutex};
+            visited.insert(std::to_string(x));
+        };
+        hal::par::for_each(record, 1, 2.5f, 3L, 'a', 5u);
+        CHECK(visited == std::multiset<std::string>{"1", "2.500000", "3",
+                                                    "97", "5"});
+    }
+
+    SECTION("rvalue elements")
+    {
+        auto total = std::atomic<int>{0};
+        hal::par::for_each([&](std::unique_ptr<int> p) { total += *p; },
+                           std::make_unique<int>(1), std::make_unique<int>(2),
+                           std::make_unique<int>(3));
+        CHECK(total.load() == 6);
+    }
+
+    SECTION("nested")
+    {
+        auto total = std::atomic<int>{0};
+        auto add   = [&](int x) { total += x; };
+        hal::par::for_each(
+            [&](int x) { hal::par::for_each(add, x, x, x, x); }, 1, 2, 3, 4, 5,
+            6, 7, 8);
+        CHECK(total.load() == 4 * 36);
+    }
+
+    SECTION("partial application")
+    {
+        auto total     = std::atomic<int>{0};
+        auto add_each  = hal::par::for_each([&](int x) { total += x; });
+        add_each(1, 2, 3);
+        add_each(4);
+        CHECK(total.load() == 10);
+    }
+
+    SECTION("constexpr")
+    {
+        constexpr auto sum = [] {
+            auto s = 0;
+            hal::par::for_each([&](int x) { s += x; }, 1, 2, 3, 4);
+            return s;
+        }();
+        static_assert(sum == 10);
+    }
+}
+
+TEST_CASE("hal::par::transform", "[HAL]")
+{
+    SECTION("full call")
+    {
+        auto a = 1;
+        auto b = 2.5;
+        auto c = 3L;
+        hal::par::transform(twice, a, b, c);
+        CHECK(a == 2);
+        CHECK(b == 5.);
+        CHECK(c == 6L);
+    }
+
+    SECTION("constexpr")
+    {
+        constexpr auto sum = [] {
+            auto a = 1;
+            auto b = 2;
+            auto c = 3;
+            hal::par::transform(twice, a, b, c);
+            return a + b + c;
+        }();
+        static_assert(sum == 12);
+    }
+}
+
+TEST_CASE("hal::par::transform_reduce", "[HAL]")
+{
+    SECTION("combined in element order")
+    {
+        auto const to_string = [](auto x) { return std::to_string(x); };
+        auto const s = hal::par::transform_reduce(std::string{}, to_string,
+                                                  std::plus<>{}, 1, 2, 3, 4, 5,
+                                                  6, 7, 8, 9);
+        CHECK(s == "123456789");
+    }
+
+    SECTION("matches hal::transform_reduce")
+    {
+        auto const minus = std::minus<>{};
+        CHECK(hal::par::transform_reduce(100., twice, minus, 1, 2.5f, 3L) ==
+              hal::transform_reduce(100., twice, minus, 1, 2.5f, 3L));
+    }
+
+    SECTION("partial application")
+    {
+        auto sum_twice =
+            hal::par::transform_reduce(0, twice)(std::plus<>{});
+        CHECK(sum_twice(1, 2, 3) == 12);
+        CHECK(sum_twice(4) == 8);
+    }
+
+    SECTION("constexpr")
+    {
+        constexpr auto sum_twice =
+            hal::par::transform_reduce(0, twice, std::plus<>{});
+        static_assert(sum_twice(1, 2, 3) == 12);
+    }
+}
+
+TEST_CASE("hal::par::memberwise::batch", "[HAL]")
+{
+    struct Tick {
+        int volume;
+        float price;
+        double weight;
+    };
+    auto records = std::vector<Tick>(10'000);
+    for (auto i = std::size_t{0}; i < records.size(); ++i) {
+        records[i] = Tick{static_cast<int>(i % 7), static_cast<float>(i) / 3,
+                          1. / static_cast<double>(i + 1)};
+    }
+    auto const sum = [](auto x, auto y) { return x + y; };
+
+    SECTION("reduce matches the sequential result exactly")
+    {
+        auto const par =
+            hal::par::memberwise::batch::reduce(Tick{}, sum, records);
+        auto const seq = hal::memberwise::batch::reduce(Tick{}, sum, records);
+        CHECK(par.volume == seq.volume);
+        CHECK(par.price == seq.price);
+        CHECK(par.weight == seq.weight);
+    }
+
+    SECTION("transform_reduce matches the sequential result exactly")
+    {
+        auto const square = [](auto x) { return x * x; };
+        auto const par    = hal::par::memberwise::batch::transform_reduce(
+            Tick{}, square, sum, records);
+        auto const seq = hal::memberwise::batch::transform_reduce(
+            Tick{}, square, sum, records);
+        CHECK(par.volume == seq.volume);
+        CHECK(par.price == seq.price);
+        CHECK(par.weight == seq.weight);
+    }
+
+    SECTION("for_each visits every member")
+    {
+        auto count = std::atomic<std::size_t>{0};
+        hal::par::memberwise::batch::for_each([&](auto&) { ++count; }, records);
+        CHECK(count.load() == 3 * records.size());
+
+        hal::par::memberwise::batch::for_each([](auto& x) { x = 1; }, records);
+        auto const ones = hal::memberwise::batch::reduce(Tick{}, sum, records);
+        CHECK(ones.volume == 10'000);
+        CHECK(ones.weight == 10'000.);
+    }
+
+    SECTION("constexpr")
+    {
+        constexpr auto ticks = std::array{Tick{1, 2.f, 3.}, Tick{4, 5.f, 6.}};
+        constexpr auto total =
+            hal::par::memberwise::batch::reduce(Tick{}, sum, ticks);
+        static_assert(total.volume == 5);
+    }
+}
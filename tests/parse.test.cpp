@@ -0,0 +1,172 @@
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <unistd.h>
+
+#include <catch2/catch.hpp>
+
+#include <hal/parse.hpp>
+
+namespace {
+enum class Side : std::uint8_t { bid, ask };
+
+struct Trade {
+    std::int64_t time;
+    std::string_view symbol;
+    double price;
+    std::uint32_t size;
+    Side side;
+    bool odd_lot;
+};
+
+struct Listing {
+    std::string name;
+    char exchange;
+    float tick;
+};
+
+/// A path in the temporary directory, removed at the end of the scope.
+struct Temporary_file {
+    std::filesystem::path path =
+        std::filesystem::temp_directory_path() /
+        ("hal_parse_test_" + std::to_string(::getpid()));
+    ~Temporary_file() { std::filesystem::remove(path); }
+};
+}  // namespace
+
+TEST_CASE("hal::memberwise::parse", "[HAL]")
+{
+    SECTION("each member type")
+    {
+        auto const trade = hal::memberwise::parse<Trade>(
+            "1700000000123,AAPL,189.25,300,1,true", ',');
+        CHECK(trade.time == 1700000000123);
+        CHECK(trade.symbol == "AAPL");
+        CHECK(trade.price == 189.25);
+        CHECK(trade.size == 300);
+        CHECK(trade.side == Side::ask);
+        CHECK(trade.odd_lot);
+
+        auto const listing =
+            hal::memberwise::parse<Listing>("Acme Corp\tN\t0.01\r", '\t');
+        CHECK(listing.name == "Acme Corp");
+        CHECK(listing.exchange == 'N');
+        CHECK(listing.tick == 0.01f);
+    }
+
+    SECTION("empty string fields")
+    {
+        auto const listing = hal::memberwise::parse<Listing>(",Q,1", ',');
+        CHECK(listing.name.empty());
+        CHECK(listing.exchange == 'Q');
+    }
+
+    SECTION("errors")
+    {
+        auto const bad = {
+            "1,AAPL,189.25,300,1",           // too few fields
+            "1,AAPL,189.25,300,1,0,extra",   // too many fields
+            "1,AAPL,189.25,-300,1,0",        // negative unsigned
+            "1,AAPL,189.25x,300,1,0",        // trailing characters
+            "1,AAPL,,300,1,0",               // empty number
+            "1,AAPL,189.25,300,1,yes",       // not a bool
+            "1,AAPL,189.25,300,1,0,",        // trailing delimiter
+            "99999999999999999999,A,1,1,1,0" // out of range
+        };
+        for (auto line : bad) {
+            CHECK_FALSE(hal::memberwise::try_parse<Trade>(line, ','));
+            CHECK_THROWS_AS(hal::memberwise::parse<Trade>(line, ','),
+                            std::runtime_error);
+        }
+        CHECK_FALSE(hal::memberwise::try_parse<Listing>("a,bc,1", ','));
+
+        struct Quote {
+            int size;
+            std::string_view symbol;
+        };
+        CHECK_FALSE(hal::memberwise::try_parse<Quote>("5", ','));
+        CHECK(hal::memberwise::try_parse<Quote>("5,", ','));
+
+        struct Names {
+            std::string_view first, middle, last;
+        };
+        CHECK_FALSE(hal::memberwise::try_parse<Names>("x", ','));
+        CHECK(hal::memberwise::try_parse<Names>("x,,", ','));
+    }
+}
+
+TEST_CASE("hal::delimited_file", "[HAL]")
+{
+    auto const file = Temporary_file{};
+
+    SECTION("records in file order")
+    {
+        // Several chunks, with a line ending in '\r' and an empty line.
+        {
+            auto out = std::ofstream{file.path};
+            out << "time,symbol,price,size,side,odd_lot\n";
+            for (auto i = 0; i < 100'000; ++i) {
+                out << i << ",SYM" << i % 10 << "," << i * 0.5 << ","
+                    << i % 1000 << "," << i % 2 << "," << (i % 3 == 0)
+                    << (i == 7 ? "\r\n" : "\n") << (i == 9 ? "\n" : "");
+            }
+        }
+        auto const trades = hal::delimited_file<Trade>{file.path, ',', 1};
+        auto pool         = hal::par::Pool{3};
+        auto const all    = trades.read(pool);
+        REQUIRE(all.size() == 100'000);
+        auto in_order = true;
+        for (auto i = 0; i < 100'000; ++i)
+            in_order = in_order && all[i].time == i && all[i].price == i * 0.5;
+        CHECK(in_order);
+        CHECK(all[12345].symbol == "SYM5");
+        CHECK(all[99'999].odd_lot);
+
+        auto mutex = std::mutex{};
+        auto count = std::size_t{0};
+        auto sum   = std::int64_t{0};
+        trades.for_each_chunk(
+            [&](std::span<Trade const> chunk) {
+                auto const lock = std::lock_guard{mutex};
+                count += chunk.size();
+                for (auto const& trade : chunk)
+                    sum += trade.time;
+            },
+            pool);
+        CHECK(count == 100'000);
+        CHECK(sum == std::int64_t{99'999} * 100'000 / 2);
+    }
+
+    SECTION("no trailing newline")
+    {
+        std::ofstream{file.path} << "Acme,N,0.5\nBeta,Q,1";
+        auto const listings = hal::delimited_file<Listing>{file.path}.read();
+        REQUIRE(listings.size() == 2);
+        CHECK(listings[1].name == "Beta");
+        CHECK(listings[1].tick == 1.f);
+    }
+
+    SECTION("empty file")
+    {
+        std::ofstream{file.path};
+        CHECK(hal::delimited_file<Listing>{file.path, ',', 1}.read().empty());
+    }
+
+    SECTION("errors")
+    {
+        CHECK_THROWS_AS(hal::delimited_file<Listing>{file.path / "missing"},
+                        std::system_error);
+        std::ofstream{file.path} << "Acme,N,0.5\nBeta,Q,one\n";
+        auto const listings = hal::delimited_file<Listing>{file.path};
+        CHECK_THROWS_WITH(listings.read(),
+                          Catch::Contains("at byte 11: \"Beta,Q,one\""));
+    }
+}
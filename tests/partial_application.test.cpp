@@ -0,0 +1,129 @@
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+
+namespace {
+
+struct Tally {
+    int copies = 0;
+    int moves  = 0;
+};
+
+/// Unary function object that records each time it is copied or moved.
+class Counted {
+   public:
+    explicit Counted(Tally& t) : tally_{&t} {}
+
+    Counted(Counted const& other) : tally_{other.tally_} { ++tally_->copies; }
+
+    Counted(Counted&& other) noexcept : tally_{other.tally_}
+    {
+        ++tally_->moves;
+    }
+
+    auto operator=(Counted const&) -> Counted& = delete;
+    auto operator=(Counted&&) -> Counted&      = delete;
+
+   public:
+    auto operator()(int x) const -> bool { return x > 2; }
+
+   private:
+    Tally* tally_;
+};
+
+}  // namespace
+
+TEST_CASE("partial application", "[HAL]")
+{
+    auto tally = Tally{};
+
+    SECTION("capturing an rvalue does not copy")
+    {
+        [[maybe_unused]] auto const count_gt_2 = hal::count_if(Counted{tally});
+        CHECK(tally.copies == 0);
+    }
+    SECTION("capturing an lvalue copies once")
+    {
+        auto const pred                        = Counted{tally};
+        [[maybe_unused]] auto const count_gt_2 = hal::count_if(pred);
+        CHECK(tally.copies == 1);
+    }
+    SECTION("full call does not copy or move captured args")
+    {
+        auto const count_gt_2 = hal::count_if(Counted{tally});
+        tally                 = Tally{};
+        CHECK(count_gt_2(1, 2, 3, 4) == 2);
+        CHECK(count_gt_2(5, 6) == 2);
+        CHECK(tally.copies == 0);
+        CHECK(tally.moves == 0);
+    }
+    SECTION("full call on an lvalue Curried")
+    {
+        auto find_gt_2 = hal::find_if(Counted{tally});
+        tally          = Tally{};
+        CHECK(find_gt_2(1, 2, 3, 4) == 2);
+        CHECK(tally.copies == 0);
+        CHECK(tally.moves == 0);
+    }
+    SECTION("full call without partial application")
+    {
+        CHECK(hal::count_if(Counted{tally}, 1, 2, 3, 4) == 2);
+        CHECK(tally.copies == 0);
+        CHECK(tally.moves == 0);
+    }
+    SECTION("partial application in steps moves captured args")
+    {
+        auto const reduce_with =
+            hal::transform_reduce(0, Counted{tally})(std::plus<>{});
+        CHECK(tally.copies == 0);
+        tally = Tally{};
+        CHECK(reduce_with(1, 2, 3) == 1);
+        CHECK(tally.copies == 0);
+        CHECK(tally.moves == 0);
+    }
+    SECTION("move-only captured args")
+    {
+        auto total  = 0;
+        auto add_to = [p = std::make_unique<int*>(&total)](int x) {
+            **p += x;
+        };
+        auto add_each = hal::for_each(std::move(add_to));
+        add_each(1, 2, 3);
+        CHECK(total == 6);
+        std::move(add_each)(4);
+        CHECK(total == 10);
+    }
+    SECTION("stored const partial copies a mutable lambda for each call")
+    {
+        auto const count_after_first =
+            hal::count_if([first = true](int) mutable {
+                return !std::exchange(first, false);
+            });
+        CHECK(count_after_first(1, 2, 3) == 2);
+        CHECK(count_after_first(1, 2, 3) == 2);
+    }
+
+    SECTION("stored partial copies a mutable lambda for each call")
+    {
+        auto count_first = hal::count_if([calls = 0](int) mutable {
+            return ++calls == 1;
+        });
+        CHECK(count_first(0, 0) == 1);
+        CHECK(count_first(0, 0) == 1);
+    }
+
+    SECTION("std::reference_wrapper captures by reference")
+    {
+        struct Sum {
+            int total = 0;
+            void operator()(int x) { total += x; }
+        } sum;
+        auto add_all = hal::for_each(std::ref(sum));
+        add_all(1, 2, 3);
+        CHECK(sum.total == 6);
+    }
+}
@@ -99,6 +99,13 @@ TEST_CASE("partial_transform_reduce", "[HAL]")
                 CHECK(hal::get<4>(xs...) == 1);
                 CHECK(hal::get<5>(xs...) == 0);
             }(1, 2, 3, -4, 3, 2);
+
+            // Elements are passed to transform_fn as non-const lvalues.
+            [](auto... xs) {
+                hal::reverse::partial_transform_reduce(
+                    0, [](int& x) { return x; }, std::plus<>{}, xs...);
+                CHECK(hal::get<0>(xs...) == 6);
+            }(1, 2, 3);
         }
         SECTION("partial application")
         {
@@ -0,0 +1,211 @@
+#include <array>
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+#include <hal/soa_vector.hpp>
+
+namespace {
+struct Tick {
+    int volume;
+    float price;
+    long time;
+};
+
+struct Quad {
+    float x, y, z, w;
+};
+
+struct Pair {
+    double a, b;
+};
+
+/// Ticks with volume i, price i / 2 and time 3i, for i in [0, n).
+auto ticks(std::size_t n) -> std::vector<Tick>
+{
+    auto result = std::vector<Tick>(n);
+    for (auto i = std::size_t{0}; i < n; ++i) {
+        result[i] = Tick{static_cast<int>(i), static_cast<float>(i) / 2,
+                         static_cast<long>(3 * i)};
+    }
+    return result;
+}
+
+auto quads(std::size_t n) -> std::vector<Quad>
+{
+    auto result = std::vector<Quad>(n);
+    for (auto i = std::size_t{0}; i < n; ++i) {
+        auto const f = static_cast<float>(i);
+        result[i]    = Quad{f, f + .25f, f + .5f, f + .75f};
+    }
+    return result;
+}
+}  // namespace
+
+TEST_CASE("hal::memberwise::scatter", "[HAL]")
+{
+    SECTION("mixed members")
+    {
+        // More records than one block, and a partial last block.
+        auto const records = ticks(600);
+        auto volumes       = std::vector<int>(600);
+        auto prices        = std::vector<float>(600);
+        auto times         = std::vector<long>(600);
+        hal::memberwise::scatter(records, volumes, prices, times);
+        for (auto i = std::size_t{0}; i < records.size(); ++i) {
+            CHECK(volumes[i] == records[i].volume);
+            CHECK(prices[i] == records[i].price);
+            CHECK(times[i] == records[i].time);
+        }
+    }
+
+    SECTION("square records use shuffles")
+    {
+        // Not a whole number of registers, so the tail is copied one by one.
+        auto const records = quads(1003);
+        auto x             = std::vector<float>(1003);
+        auto y             = std::vector<float>(1003);
+        auto z             = std::vector<float>(1003);
+        auto w             = std::vector<float>(1003);
+        hal::memberwise::scatter(records, x, y, z, w);
+        for (auto i = std::size_t{0}; i < records.size(); ++i) {
+            CHECK(x[i] == records[i].x);
+            CHECK(y[i] == records[i].y);
+            CHECK(z[i] == records[i].z);
+            CHECK(w[i] == records[i].w);
+        }
+
+        auto const pairs = std::array{Pair{1., 2.}, Pair{3., 4.}, Pair{5., 6.}};
+        auto a           = std::array<double, 3>{};
+        auto b           = std::array<double, 3>{};
+        hal::memberwise::scatter(pairs, a, b);
+        CHECK(a == std::array{1., 3., 5.});
+        CHECK(b == std::array{2., 4., 6.});
+    }
+
+    SECTION("into part of a column")
+    {
+        auto const records = ticks(3);
+        auto volumes       = std::vector<int>(5, -1);
+        auto prices        = std::vector<double>(3);
+        auto times         = std::vector<long>(3);
+        hal::memberwise::scatter(records, std::span{volumes}.subspan(1),
+                                 prices, times);
+        CHECK(volumes == std::vector<int>{-1, 0, 1, 2, -1});
+        CHECK(prices == std::vector<double>{0., .5, 1.});
+    }
+
+    SECTION("from a span of mutable records")
+    {
+        auto records = ticks(3);
+        auto squares = quads(9);
+        auto volumes = std::vector<int>(3);
+        auto prices  = std::vector<float>(3);
+        auto times   = std::vector<long>(3);
+        hal::memberwise::scatter(std::span{records}, volumes, prices, times);
+        CHECK(times == std::vector<long>{0, 3, 6});
+
+        auto x = std::vector<float>(9);
+        auto y = std::vector<float>(9);
+        auto z = std::vector<float>(9);
+        auto w = std::vector<float>(9);
+        hal::memberwise::scatter(std::span<Quad>{squares}, x, y, z, w);
+        CHECK(w[8] == 8.75f);
+    }
+
+    SECTION("into a soa_vector")
+    {
+        auto const records = quads(10);
+        auto columns       = hal::soa_vector<Quad>(records.size());
+        hal::memberwise::scatter(records, columns.column<0>(),
+                                 columns.column<1>(), columns.column<2>(),
+                                 columns.column<3>());
+        CHECK(static_cast<Quad>(columns[7]).w == 7.75f);
+    }
+
+    SECTION("constexpr")
+    {
+        constexpr auto x = [] {
+            auto const records = std::array{Quad{1, 2, 3, 4}, Quad{5, 6, 7, 8},
+                                            Quad{9, 10, 11, 12},
+                                            Quad{13, 14, 15, 16}};
+            auto x             = std::array<float, 4>{};
+            auto y             = std::array<float, 4>{};
+            auto z             = std::array<float, 4>{};
+            auto w             = std::array<float, 4>{};
+            hal::memberwise::scatter(records, x, y, z, w);
+            return x;
+        }();
+        static_assert(x == std::array{1.f, 5.f, 9.f, 13.f});
+    }
+}
+
+TEST_CASE("hal::memberwise::gather", "[HAL]")
+{
+    SECTION("mixed members")
+    {
+        auto const expected = ticks(700);
+        auto volumes        = std::vector<int>(700);
+        auto prices         = std::vector<float>(700);
+        auto times          = std::vector<long>(700);
+        hal::memberwise::scatter(expected, volumes, prices, times);
+
+        auto records = std::vector<Tick>(700);
+        hal::memberwise::gather(volumes, prices, times, records);
+        for (auto i = std::size_t{0}; i < records.size(); ++i) {
+            CHECK(records[i].volume == expected[i].volume);
+            CHECK(records[i].price == expected[i].price);
+            CHECK(records[i].time == expected[i].time);
+        }
+    }
+
+    SECTION("square records use shuffles")
+    {
+        auto const expected = quads(517);
+        auto x              = std::vector<float>(517);
+        auto y              = std::vector<float>(517);
+        auto z              = std::vector<float>(517);
+        auto w              = std::vector<float>(517);
+        hal::memberwise::scatter(expected, x, y, z, w);
+
+        auto records = std::vector<Quad>(517);
+        hal::memberwise::gather(std::as_const(x), y, z, w, records);
+        for (auto i = std::size_t{0}; i < records.size(); ++i) {
+            CHECK(records[i].x == expected[i].x);
+            CHECK(records[i].y == expected[i].y);
+            CHECK(records[i].z == expected[i].z);
+            CHECK(records[i].w == expected[i].w);
+        }
+    }
+
+    SECTION("non trivial members")
+    {
+        struct Named {
+            std::string name;
+            int id;
+        };
+        auto const names = std::vector<std::string>{"a", "b", "c"};
+        auto const ids   = std::array{1, 2, 3};
+        auto records     = std::vector<Named>(3);
+        hal::memberwise::gather(names, ids, records);
+        CHECK(records[2].name == "c");
+        CHECK(records[2].id == 3);
+    }
+
+    SECTION("constexpr")
+    {
+        constexpr auto records = [] {
+            auto const x = std::array{1., 2.};
+            auto const y = std::array{3., 4.};
+            auto result  = std::array<Pair, 2>{};
+            hal::memberwise::gather(x, y, result);
+            return result;
+        }();
+        static_assert(records[1].a == 2.);
+        static_assert(records[1].b == 4.);
+    }
+}
@@ -0,0 +1,230 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <unistd.h>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+#include <hal/record_file.hpp>
+
+namespace {
+enum class Side : std::uint8_t { bid, ask };
+
+/// Has padding in memory, after side and before price.
+struct Tick {
+    Side side;
+    double price;
+    std::int32_t volume;
+};
+
+/// Laid out in memory the same way it is serialized.
+struct Point {
+    float x;
+    float y;
+    std::int32_t id;
+};
+
+/// Has no padding, but a bool member.
+struct Flags {
+    std::uint8_t kind;
+    bool set;
+    std::uint16_t count;
+};
+
+enum Unfixed { unfixed_a, unfixed_b };
+
+struct Unfixed_member {
+    Unfixed value;
+};
+
+constexpr auto ticks = std::array{Tick{Side::bid, 100.5, 3},
+                                  Tick{Side::ask, 101.25, -7},
+                                  Tick{Side::bid, 99.75, 1 << 20}};
+
+/// Serializes \p records one after another into a file at \p path.
+template <typename T, std::size_t N>
+void write_records(std::filesystem::path const& path,
+                   std::array<T, N> const& records)
+{
+    constexpr auto size = hal::memberwise::serialized_size_v<T>;
+    auto bytes          = std::vector<std::byte>(N * size);
+    for (auto i = std::size_t{0}; i < N; ++i) {
+        hal::memberwise::serialize(records[i],
+                                   std::span{bytes}.subspan(i * size));
+    }
+    auto file = std::ofstream{path, std::ios::binary};
+    file.write(reinterpret_cast<char const*>(bytes.data()),
+               static_cast<std::streamsize>(bytes.size()));
+}
+
+/// A path in the temporary directory, removed at the end of the scope.
+struct Temporary_file {
+    std::filesystem::path path =
+        std::filesystem::temp_directory_path() /
+        ("hal_serialize_test_" + std::to_string(::getpid()));
+    ~Temporary_file() { std::filesystem::remove(path); }
+};
+}  // namespace
+
+TEST_CASE("hal::memberwise::serialize", "[HAL]")
+{
+    SECTION("size and layout")
+    {
+        STATIC_REQUIRE(hal::memberwise::serialized_size_v<Tick> == 13);
+        STATIC_REQUIRE(sizeof(Tick) > 13);
+        STATIC_REQUIRE(!hal::memberwise::is_serialized_layout_v<Tick>);
+        STATIC_REQUIRE(hal::memberwise::serialized_size_v<Point> == 12);
+        STATIC_REQUIRE(hal::memberwise::is_serialized_layout_v<Point> ==
+                       (std::endian::native == std::endian::little));
+        STATIC_REQUIRE(sizeof(Flags) ==
+                       hal::memberwise::serialized_size_v<Flags>);
+        STATIC_REQUIRE(!hal::memberwise::is_serialized_layout_v<Flags>);
+        STATIC_REQUIRE(!hal::detail::is_serializable<Unfixed_member>);
+    }
+
+    SECTION("bools from any byte")
+    {
+        auto const bytes = std::array{std::byte{3}, std::byte{0x7F},
+                                      std::byte{2}, std::byte{1}};
+        auto const flags = hal::memberwise::deserialize<Flags>(bytes);
+        CHECK(flags.kind == 3);
+        CHECK(flags.set == true);
+        CHECK(flags.count == 0x0102);
+
+        auto out = std::array<std::byte, 4>{};
+        hal::memberwise::serialize(flags, out);
+        CHECK(out[1] == std::byte{1});
+    }
+
+    SECTION("little endian bytes without padding")
+    {
+        auto bytes = std::array<std::byte, 13>{};
+        hal::memberwise::serialize(Tick{Side::ask, 2., 0x01020304}, bytes);
+        CHECK(bytes[0] == std::byte{1});
+        // 2.0 is 0x4000000000000000.
+        CHECK(bytes[8] == std::byte{0x40});
+        CHECK(bytes[9] == std::byte{0x04});
+        CHECK(bytes[12] == std::byte{0x01});
+    }
+
+    SECTION("round trip")
+    {
+        auto bytes = std::vector<std::byte>(20);
+        for (auto const& tick : ticks) {
+            hal::memberwise::serialize(tick, bytes);
+            auto const copy =
+                hal::memberwise::deserialize<Tick>(std::span{bytes});
+            CHECK(copy.side == tick.side);
+            CHECK(copy.price == tick.price);
+            CHECK(copy.volume == tick.volume);
+        }
+
+        auto point_bytes = std::array<std::byte, 12>{};
+        hal::memberwise::serialize(Point{1.5f, -2.f, 42}, point_bytes);
+        auto const point = hal::memberwise::deserialize<Point>(point_bytes);
+        CHECK(point.x == 1.5f);
+        CHECK(point.y == -2.f);
+        CHECK(point.id == 42);
+    }
+
+    SECTION("constexpr")
+    {
+        constexpr auto bytes = [] {
+            auto bytes = std::array<std::byte, 12>{};
+            hal::memberwise::serialize(Point{1.f, 2.f, 258}, bytes);
+            return bytes;
+        }();
+        static_assert(bytes[8] == std::byte{2});
+        static_assert(bytes[9] == std::byte{1});
+        constexpr auto point = hal::memberwise::deserialize<Point>(bytes);
+        static_assert(point.y == 2.f);
+        static_assert(point.id == 258);
+    }
+}
+
+TEST_CASE("hal::record_file", "[HAL]")
+{
+    auto const file = Temporary_file{};
+
+    SECTION("iterate and index records")
+    {
+        write_records(file.path, ticks);
+        auto const records = hal::record_file<Tick>{file.path};
+        REQUIRE(records.size() == 3);
+        CHECK(records.bytes().size() == 3 * 13);
+        CHECK(records[1].volume == -7);
+
+        auto i = std::size_t{0};
+        for (auto const tick : records) {
+            CHECK(tick.side == ticks[i].side);
+            CHECK(tick.price == ticks[i].price);
+            ++i;
+        }
+        CHECK(i == 3);
+
+        auto copies = std::vector<Tick>(2);
+        records.read(1, copies);
+        CHECK(copies[0].price == 101.25);
+        CHECK(copies[1].volume == 1 << 20);
+    }
+
+    SECTION("records in place")
+    {
+        write_records(file.path, std::array{Point{1.f, 2.f, 3},
+                                             Point{4.f, 5.f, 6}});
+        auto records = hal::record_file<Point>{file.path};
+        auto moved   = std::move(records);
+        CHECK(records.empty());
+        if constexpr (hal::memberwise::is_serialized_layout_v<Point>) {
+            auto const points = moved.records();
+            REQUIRE(points.size() == 2);
+            CHECK(points[1].y == 5.f);
+        }
+        auto copies = std::vector<Point>(2);
+        moved.read(0, copies);
+        CHECK(copies[1].id == 6);
+    }
+
+    SECTION("bools from any byte")
+    {
+        write_records(file.path, std::array{Flags{1, false, 2}});
+        {
+            auto out = std::fstream{file.path, std::ios::binary |
+                                                   std::ios::in |
+                                                   std::ios::out};
+            out.seekp(1);
+            out.put(char{5});
+        }
+        auto const records = hal::record_file<Flags>{file.path};
+        CHECK(records[0].set == true);
+        auto copies = std::vector<Flags>(1);
+        records.read(0, copies);
+        CHECK(copies[0].set == true);
+        CHECK(copies[0].count == 2);
+    }
+
+    SECTION("empty file")
+    {
+        std::ofstream{file.path};
+        auto const records = hal::record_file<Tick>{file.path};
+        CHECK(records.empty());
+        CHECK(records.begin() == records.end());
+    }
+
+    SECTION("errors")
+    {
+        CHECK_THROWS_AS(hal::record_file<Tick>{file.path / "missing"},
+                        std::system_error);
+        std::ofstream{file.path} << "12345";
+        CHECK_THROWS_AS(hal::record_file<Tick>{file.path}, std::runtime_error);
+    }
+}
@@ -0,0 +1,144 @@
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <utility>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+
+namespace {
+
+/// Invokes \p f with references to each element of \p a as a parameter pack.
+template <typename T, std::size_t N, typename Fn>
+constexpr auto with_refs(std::array<T, N>& a, Fn&& f) -> decltype(auto)
+{
+    return [&]<std::size_t... I>(std::index_sequence<I...>)->decltype(auto)
+    {
+        return f(a[I]...);
+    }
+    (std::make_index_sequence<N>{});
+}
+
+/// Values 1 to N, with every third value replaced by 7.
+template <typename T, std::size_t N>
+constexpr auto values()
+{
+    auto a = std::array<T, N>{};
+    for (auto i = std::size_t{0}; i < N; ++i)
+        a[i] = (i % 3 == 2) ? T(7) : T(i + 1);
+    return a;
+}
+
+/// Checks the algorithms against loops, for packs of N elements of type T.
+template <typename T, std::size_t N>
+void check_against_loops()
+{
+    auto a = values<T, N>();
+
+    auto sum = T(5);
+    for (auto x : a)
+        sum += x;
+    CHECK(with_refs(a, hal::reduce(T(5), std::plus<>{})) == sum);
+
+    auto squares = T(0);
+    for (auto x : a)
+        squares += x * x;
+    auto const square = [](T x) { return x * x; };
+    CHECK(with_refs(a, hal::transform_reduce(T(0), square, std::plus<>{})) ==
+          squares);
+
+    auto sevens = std::size_t{0};
+    for (auto x : a)
+        sevens += (x == T(7));
+    CHECK(with_refs(a, hal::count(T(7))) == sevens);
+
+    auto const last = a[N - 1];
+    auto first_last = std::size_t{0};
+    while (a[first_last] != last)
+        ++first_last;
+    CHECK(with_refs(a, hal::find(T(7))) == (N > 2 ? 2 : N));
+    CHECK(with_refs(a, hal::find(last)) == first_last);
+    CHECK(with_refs(a, hal::find(T(0))) == N);
+}
+
+/// Aggregate of floats filling a 32 byte register.
+struct Vec8 {
+    float x0, x1, x2, x3, x4, x5, x6, x7;
+};
+
+}  // namespace
+
+TEMPLATE_TEST_CASE("homogeneous packs",
+                   "[HAL]",
+                   int,
+                   unsigned,
+                   long,
+                   float,
+                   double)
+{
+    // Sizes on either side of whole registers, so the tails are covered.
+    check_against_loops<TestType, 3>();
+    check_against_loops<TestType, 4>();
+    check_against_loops<TestType, 7>();
+    check_against_loops<TestType, 8>();
+    check_against_loops<TestType, 31>();
+    check_against_loops<TestType, 32>();
+    check_against_loops<TestType, 33>();
+    check_against_loops<TestType, 200>();
+}
+
+TEST_CASE("homogeneous packs of floating point", "[HAL]")
+{
+    SECTION("NaN never compares equal")
+    {
+        auto const nan = std::numeric_limits<double>::quiet_NaN();
+        CHECK(hal::count(nan, 1.0, nan, 2.0, 3.0, nan, 4.0, 5.0, 6.0) == 0);
+        CHECK(hal::find(nan, 1.0, nan, 2.0, 3.0, nan, 4.0, 5.0, 6.0) == 8);
+        CHECK(hal::count(3.0, 1.0, nan, 2.0, 3.0, nan, 4.0, 5.0, 6.0) == 1);
+    }
+    SECTION("negative zero compares equal to zero")
+    {
+        CHECK(hal::count(0.0f, -0.0f, 1.f, 2.f, 0.f, 3.f, 4.f, 5.f, 6.f) == 2);
+        CHECK(hal::find(0.0f, 1.f, 2.f, -0.0f, 0.f, 3.f, 4.f, 5.f, 6.f) == 2);
+    }
+#if !defined(__FAST_MATH__)
+    SECTION("sums are not reordered")
+    {
+        // Summed in order, each 1 is lost against 1e8.
+        auto const sum = hal::reduce(1e8f, std::plus<>{}, 1.f, 1.f, 1.f, 1.f,
+                                     1.f, 1.f, 1.f, 1.f);
+        CHECK(sum == 1e8f);
+    }
+#endif
+}
+
+TEST_CASE("homogeneous packs in constant expressions", "[HAL]")
+{
+    constexpr auto sum = hal::reduce(0, std::plus<>{}, 1, 2, 3, 4, 5, 6, 7, 8);
+    static_assert(sum == 36);
+    constexpr auto sevens = hal::count(7, 7, 2, 3, 4, 5, 6, 7, 8);
+    static_assert(sevens == 2);
+    constexpr auto index = hal::find(6, 1, 2, 3, 4, 5, 6, 7, 8);
+    static_assert(index == 5);
+    constexpr auto squares = hal::transform_reduce(
+        0, [](int x) { return x * x; }, std::plus<>{}, 1, 2, 3, 4, 5, 6, 7, 8);
+    static_assert(squares == 204);
+}
+
+TEST_CASE("homogeneous aggregates", "[HAL]")
+{
+    auto v = Vec8{1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f};
+
+    auto count = std::size_t{0};
+    hal::memberwise::for_each([&](float x) { count += x > 4.f; }, v);
+    CHECK(count == 4);
+
+    auto const sum = std::apply(hal::reduce(0.f, std::plus<>{}),
+                                hal::to_ref_tuple(v));
+    CHECK(sum == 36.f);
+    CHECK(std::apply(hal::count(4.f), hal::to_ref_tuple(v)) == 1);
+    CHECK(std::apply(hal::find(6.f), hal::to_ref_tuple(v)) == 5);
+    CHECK(hal::memberwise::reduce(0.f, std::plus<>{}, v) == 36.f);
+}
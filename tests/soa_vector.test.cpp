@@ -0,0 +1,264 @@
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+#include <hal/soa_vector.hpp>
+
+namespace {
+constexpr auto sum = [](auto x, auto y) { return x + y; };
+
+struct Particle {
+    float x    = 1.f;
+    double y   = 2.;
+    int charge = -1;
+};
+
+struct Totals {
+    double x;
+    double y;
+    long charge;
+};
+
+struct Order {
+    int id;
+    bool filled;
+    double price;
+};
+
+struct Named {
+    std::string name;
+    std::unique_ptr<int> value;
+};
+
+/// Throws from its copy constructor once copies_left runs out.
+struct Fragile {
+    static inline auto copies_left = 0;
+    int value                      = 0;
+    Fragile()                      = default;
+    Fragile(Fragile const& other) : value{other.value}
+    {
+        if (copies_left == 0)
+            throw std::runtime_error{"no copies left"};
+        --copies_left;
+    }
+    auto operator=(Fragile const&) -> Fragile& = default;
+};
+
+struct Labelled {
+    std::string label;
+    bool flag;
+    Fragile fragile;
+};
+
+auto particles(int n) -> hal::soa_vector<Particle>
+{
+    auto result = hal::soa_vector<Particle>{};
+    for (auto i = 0; i < n; ++i)
+        result.push_back(Particle{static_cast<float>(i), i * 2., i % 3});
+    return result;
+}
+
+template <typename Column>
+auto is_cache_aligned(Column const& column) -> bool
+{
+    return reinterpret_cast<std::uintptr_t>(column.data()) % 64 == 0;
+}
+}  // namespace
+
+TEST_CASE("hal::soa_vector", "[HAL]")
+{
+    SECTION("push_back and read rows")
+    {
+        auto v = particles(100);
+        REQUIRE(v.size() == 100);
+        CHECK(!v.empty());
+        auto const p = static_cast<Particle>(v[42]);
+        CHECK(p.x == 42.f);
+        CHECK(p.y == 84.);
+        CHECK(p.charge == 0);
+
+        auto const [x, y, charge] = v[7];
+        CHECK(x == 7.f);
+        CHECK(y == 14.);
+        CHECK(charge == 1);
+    }
+
+    SECTION("write through rows")
+    {
+        auto v  = particles(3);
+        v[1]    = Particle{9.f, 8., 7};
+        auto& y = v[2].get<1>();
+        y       = 5.;
+        CHECK(static_cast<Particle>(v[1]).charge == 7);
+        CHECK(v.column<1>()[2] == 5.);
+
+        v[0] = v[1];
+        CHECK(static_cast<Particle>(v[0]).x == 9.f);
+        CHECK(static_cast<Particle>(v[1]).x == 9.f);
+    }
+
+    SECTION("columns are contiguous and aligned")
+    {
+        auto v = particles(1000);
+        CHECK(v.column<0>().size() == 1000);
+        CHECK(is_cache_aligned(v.column<0>()));
+        CHECK(is_cache_aligned(v.column<1>()));
+        CHECK(is_cache_aligned(v.column<2>()));
+        auto total = 0.;
+        for (auto y : v.column<1>())
+            total += y;
+        CHECK(total == 999. * 1000.);
+    }
+
+    SECTION("resize uses default member values")
+    {
+        auto v = hal::soa_vector<Particle>(2);
+        v.resize(4);
+        CHECK(v.size() == 4);
+        CHECK(static_cast<Particle>(v[3]).charge == -1);
+        v.pop_back();
+        CHECK(v.size() == 3);
+        v.clear();
+        CHECK(v.empty());
+    }
+
+    SECTION("move only members")
+    {
+        auto v = hal::soa_vector<Named>{};
+        v.push_back(Named{"a", std::make_unique<int>(1)});
+        v.push_back(Named{"b", std::make_unique<int>(2)});
+        auto const& [name, value] = v[1];
+        CHECK(name == "b");
+        CHECK(*value == 2);
+    }
+
+    SECTION("bool members")
+    {
+        auto v = hal::soa_vector<Order>{};
+        for (auto i = 0; i < 20; ++i)
+            v.push_back(Order{i, i % 3 == 0, i * .5});
+        auto& filled = v[4].get<1>();
+        filled       = true;
+        v[5]         = Order{5, true, 0.};
+
+        auto const column = std::as_const(v).column<1>();
+        static_assert(std::is_same_v<decltype(column)::element_type,
+                                     bool const>);
+        CHECK(is_cache_aligned(column));
+        CHECK(std::count(column.begin(), column.end(), true) == 9);
+        CHECK(static_cast<Order>(v[5]).filled);
+
+        auto copy = v;
+        copy.resize(30, Order{0, true, 0.});
+        CHECK(copy.column<1>()[29]);
+        CHECK(!copy.column<1>()[1]);
+        copy.pop_back();
+        CHECK(copy.size() == 29);
+        CHECK(v.size() == 20);
+        v = std::move(copy);
+        CHECK(v.column<1>().size() == 29);
+    }
+
+    SECTION("a throwing member copy leaves the columns unchanged")
+    {
+        auto v = hal::soa_vector<Labelled>{};
+        auto const row =
+            Labelled{"a label too long to be stored in place", true, {}};
+        Fragile::copies_left = 100;
+        for (auto i = 0; i < 9; ++i)
+            v.push_back(row);
+        Fragile::copies_left = 0;
+        CHECK_THROWS_AS(v.push_back(row), std::runtime_error);
+        CHECK_THROWS_AS(v.resize(20, row), std::runtime_error);
+        CHECK(v.size() == 9);
+        CHECK(v.column<0>().size() == 9);
+        CHECK(v.column<1>().size() == 9);
+        CHECK(v.column<2>().size() == 9);
+
+        Fragile::copies_left = 100;
+        v.push_back(row);
+        CHECK(v.column<0>().size() == 10);
+        CHECK(v.column<2>().size() == 10);
+    }
+
+    SECTION("iterate over rows")
+    {
+        auto v = particles(5);
+        auto n = 0;
+        for (auto row : v) {
+            auto const [x, y, charge] = row;
+            CHECK(y == 2. * x);
+            ++n;
+        }
+        CHECK(n == 5);
+
+        auto const& c = v;
+        for (auto row : c)
+            CHECK(row.get<0>() >= 0.f);
+    }
+
+    SECTION("memberwise algorithms on a row")
+    {
+        auto v = particles(10);
+        CHECK(hal::memberwise::reduce(0., sum, v[4]) == 4. + 8. + 1);
+        hal::memberwise::for_each([](auto& m) { m *= 2; }, v[4]);
+        CHECK(static_cast<Particle>(v[4]).y == 16.);
+        hal::memberwise::partial_sum(v[5]);
+        CHECK(static_cast<Particle>(v[5]).charge == 5 + 10 + 2);
+
+        auto const& c = v;
+        auto const t  = hal::to_tuple(c[6]);
+        CHECK(std::get<2>(t) == 0);
+        static_assert(hal::member_count_v<decltype(c[6])> == 3);
+    }
+}
+
+TEST_CASE("hal::columnwise", "[HAL]")
+{
+    SECTION("reduce")
+    {
+        auto const v = particles(1000);
+        auto const t = hal::columnwise::reduce(Totals{}, sum, v);
+        CHECK(t.x == 999. * 500.);
+        CHECK(t.y == 999. * 1000.);
+        CHECK(t.charge == 333 + 2 * 333);
+    }
+
+    SECTION("transform_reduce")
+    {
+        auto const v      = particles(4);
+        auto const square = [](auto x) { return x * x; };
+        auto const t =
+            hal::columnwise::transform_reduce(Totals{}, square, sum, v);
+        CHECK(t.x == 0. + 1 + 4 + 9);
+        CHECK(t.y == 0. + 4 + 16 + 36);
+        CHECK(t.charge == 0 + 1 + 4 + 0);
+    }
+
+    SECTION("transform and for_each")
+    {
+        auto v = particles(4);
+        hal::columnwise::transform([](auto x) { return x + 1; }, v);
+        auto visited = std::vector<double>{};
+        hal::columnwise::for_each(
+            [&](auto x) { visited.push_back(static_cast<double>(x)); }, v);
+        CHECK(visited == std::vector<double>{1, 2, 3, 4, 1, 3, 5, 7, 1, 2, 3,
+                                             1});
+    }
+
+    SECTION("partial application")
+    {
+        auto const v   = particles(3);
+        auto sum_parts = hal::columnwise::reduce(Totals{}, sum);
+        CHECK(sum_parts(v).y == 6.);
+    }
+}
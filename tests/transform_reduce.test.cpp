@@ -16,6 +16,11 @@ TEST_CASE("tranform_reduce", "[HAL]")
 
         auto const b = hal::transform_reduce(0, square, sum, 5.4, 'a');
         CHECK(b == 9438);
+
+        // The reduction so far is an lvalue, so reduce_fn can take a T&.
+        auto const add_to = [](int& total, int x) { return total + x; };
+        auto const c = hal::transform_reduce(0, square, add_to, 1, 2, 3);
+        CHECK(c == 14);
     }
     SECTION("partial application")
     {
@@ -101,6 +106,12 @@ TEST_CASE("reverse::tranform_reduce", "[HAL]")
         CHECK(a == 55);
         CHECK(ss.str() == "54321");
 
+        // Elements are passed to transform_fn as non-const lvalues.
+        auto const twice = [](int& x) { return 2 * x; };
+        auto x           = 1;
+        auto y           = 2;
+        CHECK(hr::transform_reduce(0, twice, sum, x, y) == 6);
+
         ss.str(std::string{});
         auto const b = hr::transform_reduce(0, square_and_print, sum, 5.4, 'a');
         CHECK(b == 9438);
@@ -0,0 +1,120 @@
+#include <string>
+#include <utility>
+
+#include <catch2/catch.hpp>
+
+#include <hal.hpp>
+
+namespace {
+constexpr auto sum     = [](auto x, auto y) { return x + y; };
+constexpr auto product = [](auto x, auto y) { return x * y; };
+
+/// Associative, but not commutative, shows where each call was made.
+auto const bracket = [](std::string const& x, std::string const& y) {
+    return "(" + x + y + ")";
+};
+
+struct Foo {
+    int a    = 3;
+    char b   = '#';
+    double c = 5.212;
+};
+
+struct Empty {};
+}  // namespace
+
+TEST_CASE("hal::tree_reduce", "[HAL]")
+{
+    SECTION("call order")
+    {
+        auto const a = hal::tree_reduce(std::string{"i"}, bracket, "a", "b",
+                                        "c", "d");
+        CHECK(a == "(i((ab)(cd)))");
+
+        auto const b =
+            hal::tree_reduce(std::string{"i"}, bracket, "a", "b", "c", "d", "e");
+        CHECK(b == "(i(((ab)(cd))e))");
+
+        auto const c = hal::tree_reduce(std::string{"i"}, bracket, "a");
+        CHECK(c == "(ia)");
+    }
+
+    SECTION("full call")
+    {
+        auto const a = hal::tree_reduce(0., sum, 1, 'a', .5);
+        CHECK(a == 0. + 1 + 'a' + .5);
+        auto const b = hal::tree_reduce(1, product, 4, 3, 2, 1);
+        CHECK(b == 24);
+        auto const c = hal::tree_reduce(std::string{}, sum, "Hello", ", ",
+                                        std::string{"World!"});
+        CHECK(c == "Hello, World!");
+    }
+
+    SECTION("rounding error")
+    {
+        // Added one at a time, each 1 is lost against 1e8. In a tree, the 1s
+        // are added to each other first.
+        auto const sum_of = [](auto&&... x) {
+            return std::pair{hal::reduce(0.f, sum, x...),
+                             hal::tree_reduce(0.f, sum, x...)};
+        };
+        auto const [serial, tree] =
+            sum_of(1e8f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f,
+                   1.f, 1.f, 1.f, 1.f);
+        CHECK(serial == 1e8f);
+        CHECK(tree == 1e8f + 8.f);
+    }
+
+    SECTION("partial application")
+    {
+        auto empty_reduce = hal::tree_reduce(0);
+        auto sum_reduce   = empty_reduce(sum);
+        CHECK(sum_reduce(1, 2, 3, 4) == 10);
+        CHECK(sum_reduce(1) == 1);
+
+        CHECK(empty_reduce(sum, 1, 2, 3, 4) == 10);
+
+        auto product_reduce = hal::tree_reduce(1, product);
+        CHECK(product_reduce(4, 3, 2, 1) == 24);
+    }
+
+    SECTION("constexpr")
+    {
+        constexpr auto empty_reduce = hal::tree_reduce(0);
+        constexpr auto sum_reduce   = empty_reduce(sum);
+        static_assert(sum_reduce(1, 2, 3, 4) == 10);
+        static_assert(sum_reduce(1) == 1);
+
+        constexpr auto product_reduce = hal::tree_reduce(1, product);
+        static_assert(product_reduce(4, 3, 2, 1) == 24);
+    }
+}
+
+TEST_CASE("hal::memberwise::tree_reduce", "[HAL]")
+{
+    SECTION("full call")
+    {
+        auto const a = hal::memberwise::tree_reduce(0., sum, Foo{});
+        CHECK(a == (3 + '#' + 5.212));
+        auto const f = Foo{};
+        auto const b = hal::memberwise::tree_reduce(0, sum, f);
+        CHECK(b == (3 + '#' + 5));
+        auto const c = hal::memberwise::tree_reduce(0, sum, Empty{});
+        CHECK(c == 0);
+    }
+
+    SECTION("partial application")
+    {
+        auto sum_reduce = hal::memberwise::tree_reduce(0., sum);
+        CHECK(sum_reduce(Foo{}) == (3 + '#' + 5.212));
+        CHECK(sum_reduce(Empty{}) == 0.);
+    }
+
+    SECTION("constexpr")
+    {
+        constexpr auto product_reduce =
+            hal::memberwise::tree_reduce(1., product);
+        static_assert(product_reduce(Foo{}) == (3 * '#' * 5.212));
+        static_assert(product_reduce(Empty{}) == 1.);
+    }
+}
@@ -6,6 +6,78 @@
 
 #include <hal.hpp>
 
+namespace {
+
+/// The largest aggregate supported by to_tuple and the memberwise algorithms.
+struct Sixty_four {
+    int x0  = 0;
+    int x1  = 1;
+    int x2  = 2;
+    int x3  = 3;
+    int x4  = 4;
+    int x5  = 5;
+    int x6  = 6;
+    int x7  = 7;
+    int x8  = 8;
+    int x9  = 9;
+    int x10 = 10;
+    int x11 = 11;
+    int x12 = 12;
+    int x13 = 13;
+    int x14 = 14;
+    int x15 = 15;
+    int x16 = 16;
+    int x17 = 17;
+    int x18 = 18;
+    int x19 = 19;
+    int x20 = 20;
+    int x21 = 21;
+    int x22 = 22;
+    int x23 = 23;
+    int x24 = 24;
+    int x25 = 25;
+    int x26 = 26;
+    int x27 = 27;
+    int x28 = 28;
+    int x29 = 29;
+    int x30 = 30;
+    int x31 = 31;
+    int x32 = 32;
+    int x33 = 33;
+    int x34 = 34;
+    int x35 = 35;
+    int x36 = 36;
+    int x37 = 37;
+    int x38 = 38;
+    int x39 = 39;
+    int x40 = 40;
+    int x41 = 41;
+    int x42 = 42;
+    int x43 = 43;
+    int x44 = 44;
+    int x45 = 45;
+    int x46 = 46;
+    int x47 = 47;
+    int x48 = 48;
+    int x49 = 49;
+    int x50 = 50;
+    int x51 = 51;
+    int x52 = 52;
+    int x53 = 53;
+    int x54 = 54;
+    int x55 = 55;
+    int x56 = 56;
+    int x57 = 57;
+    int x58 = 58;
+    int x59 = 59;
+    int x60 = 60;
+    int x61 = 61;
+    int x62 = 62;
+    int x63 = 63;
+};
+
+}  // namespace
+
 TEST_CASE("tuple", "[HAL]")
 {
     SECTION("expanding tuple with apply")
@@ -99,6 +171,47 @@ TEST_CASE("tuple", "[HAL]")
             CHECK(std::get<14>(t) == 14);
             CHECK(std::get<15>(t) == 15);
         }
+        SECTION("sixty four members")
+        {
+            auto const t = hal::to_tuple(Sixty_four{});
+            CHECK(std::get<0>(t) == 0);
+            CHECK(std::get<31>(t) == 31);
+            CHECK(std::get<63>(t) == 63);
+            static_assert(std::tuple_size_v<decltype(t)> == 64);
+        }
+    }
+    SECTION("member_count")
+    {
+        struct Foo {
+            int a    = 34;
+            char b   = 'y';
+            double c = 7.432;
+        };
+        struct Empty {};
+        struct No_default {
+            explicit No_default(int) {}
+        };
+        struct Last_no_default {
+            int a;
+            int c;
+            No_default b;
+        };
+        struct Middle_no_default {
+            int a;
+            No_default b;
+            int c;
+        };
+        static_assert(hal::member_count_v<Foo> == 3);
+        static_assert(hal::member_count_v<Foo const&> == 3);
+        static_assert(hal::member_count_v<Empty> == 0);
+        static_assert(hal::member_count_v<Sixty_four> == 64);
+        static_assert(hal::member_count_v<Last_no_default> == 3);
+        static_assert(hal::member_count_v<Middle_no_default> == 3);
+
+        auto const last = Last_no_default{1, 2, No_default{3}};
+        auto const t    = hal::to_ref_tuple(last);
+        static_assert(std::tuple_size_v<decltype(t)> == 3);
+        CHECK(std::get<1>(t) == 2);
     }
     SECTION("to_ref_tuple")
     {
@@ -155,6 +268,16 @@ TEST_CASE("tuple", "[HAL]")
             constexpr auto result = std::apply(sum, hal::to_tuple(baz));
             static_assert(result == 56);
         }
+        SECTION("sixty four members")
+        {
+            auto x = Sixty_four{};
+            CHECK(hal::memberwise::reduce(0, std::plus<>{}, x) == 2'016);
+            auto members = 0;
+            hal::memberwise::for_each([&](int) { ++members; }, x);
+            CHECK(members == 64);
+            hal::memberwise::partial_sum(x);
+            CHECK(x.x63 == 2'016);
+        }
     }
     SECTION("from_tuple")
     {